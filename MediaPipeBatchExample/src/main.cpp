@@ -0,0 +1,22 @@
+#include "ofMain.h"
+#include "ofAppNoWindow.h"
+#include "ofApp.h"
+
+//========================================================================
+int main( int argc, char* argv[] ){
+
+	// no window is needed to process the frames
+	auto window = std::make_shared<ofAppNoWindow>();
+	auto app = std::make_shared<ofApp>();
+	// ./MediaPipeBatchExample <video file or image folder> <recording.mpbin>
+	if( argc > 1 ) {
+		app->mSettings.source = argv[1];
+	}
+	if( argc > 2 ) {
+		app->mSettings.recordingPath = argv[2];
+	}
+
+	ofRunApp(window, app);
+	ofRunMainLoop();
+
+}
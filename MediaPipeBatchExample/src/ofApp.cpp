@@ -0,0 +1,51 @@
+#include "ofApp.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	if( mSettings.source.empty() ) {
+		mSettings.source = "video.mp4";
+	}
+	if( mSettings.recordingPath.empty() ) {
+		mSettings.recordingPath = "batch" + RecordingReader::sBinaryExtension;
+	}
+
+	// the batch processor needs the results right after process(), so MODE_VIDEO.
+	// MODE_ISOLATED runs the trackers in their own interpreters, so they do not wait on each other.
+	auto handTracker = std::make_shared<HandTracker>();
+	HandTracker::HandSettings hsettings;
+	hsettings.runningMode = Tracker::MODE_VIDEO;
+	hsettings.interpreterMode = Interpreter::MODE_ISOLATED;
+	hsettings.maxNum = 2;
+	handTracker->setup( hsettings );
+
+	auto faceTracker = std::make_shared<FaceTracker>();
+	FaceTracker::FaceSettings fsettings;
+	fsettings.runningMode = Tracker::MODE_VIDEO;
+	fsettings.interpreterMode = Interpreter::MODE_ISOLATED;
+	fsettings.maxNum = 2;
+	faceTracker->setup( fsettings );
+
+	auto poseTracker = std::make_shared<PoseTracker>();
+	PoseTracker::PoseSettings psettings;
+	psettings.runningMode = Tracker::MODE_VIDEO;
+	psettings.interpreterMode = Interpreter::MODE_ISOLATED;
+	psettings.maxNum = 2;
+	poseTracker->setup( psettings );
+
+	mBatchProcessor.add( handTracker );
+	mBatchProcessor.add( faceTracker );
+	mBatchProcessor.add( poseTracker );
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	// blocks until the whole source is processed
+	if( mBatchProcessor.run(mSettings) ) {
+		ofLogNotice("ofApp") << "wrote " << mBatchProcessor.getNumFramesProcessed() << " frames to " << mSettings.recordingPath << " at " << ofToString(mBatchProcessor.getFps(), 1) << " fps";
+	} else {
+		ofLogError("ofApp") << "unable to process " << mSettings.source;
+	}
+	ofExit();
+}
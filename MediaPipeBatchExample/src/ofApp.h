@@ -0,0 +1,12 @@
+#pragma once
+#include "ofMain.h"
+#include "ofxMediaPipeBatchProcessor.h"
+
+class ofApp : public ofBaseApp{
+public:
+	void setup() override;
+	void update() override;
+
+	ofx::MediaPipe::BatchProcessor mBatchProcessor;
+	ofx::MediaPipe::BatchProcessor::Settings mSettings;
+};
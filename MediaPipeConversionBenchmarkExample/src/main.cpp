@@ -0,0 +1,20 @@
+#include "ofMain.h"
+#include "ofApp.h"
+
+//========================================================================
+int main( ){
+
+	//Use ofGLFWWindowSettings for more options like multi-monitor fullscreen
+	ofGLWindowSettings settings;
+	settings.setSize(900, 600);
+	settings.windowMode = OF_WINDOW; //can also be OF_FULLSCREEN
+	settings.setGLVersion(3, 2);
+	
+	settings.title = "ofxMediaPipe Conversion Benchmark Example";
+
+	auto window = ofCreateWindow(settings);
+
+	ofRunApp(window, std::make_shared<ofApp>());
+	ofRunMainLoop();
+
+}
@@ -0,0 +1,118 @@
+#include "ofApp.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSetFrameRate( 30 );
+	ofBackground( 30 );
+	runBenchmarks();
+}
+
+//--------------------------------------------------------------
+void ofApp::runBenchmarks() {
+	mResults.clear();
+
+	std::vector<ofPixelFormat> formats = {
+		OF_PIXELS_BGR, OF_PIXELS_BGRA, OF_PIXELS_RGBA, OF_PIXELS_GRAY,
+		OF_PIXELS_NV12, OF_PIXELS_NV21, OF_PIXELS_I420, OF_PIXELS_YV12,
+		OF_PIXELS_YUY2, OF_PIXELS_UYVY
+	};
+
+	ofPixels scalarPix, simdPix;
+	scalarPix.allocate( mWidth, mHeight, OF_PIXELS_RGB );
+	simdPix.allocate( mWidth, mHeight, OF_PIXELS_RGB );
+
+	bool bSimdWasEnabled = PixelConverter::sIsSimdEnabled();
+
+	for( auto format : formats ) {
+		ofPixels src;
+		src.allocate( mWidth, mHeight, format );
+		for( size_t i = 0; i < src.getTotalBytes(); i++ ) {
+			src.getData()[i] = (unsigned char)ofRandom(256);
+		}
+
+		Result result;
+		result.name = PixelConverter::sGetStringForFormat(format) + " to RGB";
+
+		PixelConverter::sSetSimdEnabled(false);
+		// warm up, so that the first touch of the destination is not measured
+		PixelConverter::sConvertToRgb( src, scalarPix );
+		auto startMicros = ofGetElapsedTimeMicros();
+		for( int i = 0; i < mNumIterations; i++ ) {
+			PixelConverter::sConvertToRgb( src, scalarPix );
+		}
+		result.scalarMicros = (double)(ofGetElapsedTimeMicros() - startMicros) / (double)mNumIterations;
+
+		PixelConverter::sSetSimdEnabled(true);
+		PixelConverter::sConvertToRgb( src, simdPix );
+		startMicros = ofGetElapsedTimeMicros();
+		for( int i = 0; i < mNumIterations; i++ ) {
+			PixelConverter::sConvertToRgb( src, simdPix );
+		}
+		result.simdMicros = (double)(ofGetElapsedTimeMicros() - startMicros) / (double)mNumIterations;
+
+		result.bMatches = memcmp( scalarPix.getData(), simdPix.getData(), scalarPix.getTotalBytes() ) == 0;
+		mResults.push_back( result );
+	}
+
+	// scaling to the inference size, the image prep only has a scalar path that the compiler vectorizes
+	{
+		ofPixels src;
+		src.allocate( 3840, 2160, OF_PIXELS_RGB );
+		for( size_t i = 0; i < src.getTotalBytes(); i++ ) {
+			src.getData()[i] = (unsigned char)ofRandom(256);
+		}
+		std::vector<std::pair<std::string, glm::ivec2>> sizes = {
+			{"3840x2160 area to 640x360", glm::ivec2(640, 360)},
+			{"3840x2160 bilinear to 2560x1440", glm::ivec2(2560, 1440)}
+		};
+		for( auto& size : sizes ) {
+			ImagePrep prep;
+			prep.setup( size.second.x, size.second.y, ofRectangle(0, 0, 1, 1) );
+			prep.process( src );
+			auto startMicros = ofGetElapsedTimeMicros();
+			for( int i = 0; i < mNumIterations; i++ ) {
+				prep.process( src );
+			}
+			Result result;
+			result.name = size.first;
+			result.scalarMicros = (double)(ofGetElapsedTimeMicros() - startMicros) / (double)mNumIterations;
+			result.simdMicros = result.scalarMicros;
+			mResults.push_back( result );
+		}
+	}
+
+	PixelConverter::sSetSimdEnabled( bSimdWasEnabled );
+
+	for( auto& result : mResults ) {
+		ofLogNotice("Benchmark") << result.name << " scalar: " << ofToString(result.scalarMicros, 1) << "us " << PixelConverter::sGetSimdName() << ": " << ofToString(result.simdMicros, 1) << "us" << (result.bMatches ? "" : " MISMATCH");
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	std::stringstream ss;
+	ss << "Conversions of " << mWidth << "x" << mHeight << " pixels, average of " << mNumIterations << " runs in microseconds." << std::endl;
+	ss << "Vector instructions: " << PixelConverter::sGetSimdName() << std::endl << std::endl;
+	for( auto& result : mResults ) {
+		ss << ofToString(result.name) << "   scalar: " << ofToString(result.scalarMicros, 1) << "   vector: " << ofToString(result.simdMicros, 1);
+		if( result.simdMicros > 0.0 ) {
+			ss << "   x" << ofToString(result.scalarMicros / result.simdMicros, 2);
+		}
+		if( !result.bMatches ) {
+			ss << "   results do not match!";
+		}
+		ss << std::endl;
+	}
+	ss << std::endl << "Press 'b' to run again.";
+	ofSetColor( 230 );
+	ofDrawBitmapString( ss.str(), 24, 32 );
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if( key == 'b' ) {
+		runBenchmarks();
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "ofMain.h"
+#include "ofxMediaPipePixelConverter.h"
+#include "ofxMediaPipeImagePrep.h"
+
+class ofApp : public ofBaseApp{
+public:
+	void setup() override;
+	void draw() override;
+
+	void keyPressed(int key) override;
+
+	void runBenchmarks();
+
+	struct Result {
+		std::string name;
+		double scalarMicros = 0.0;
+		double simdMicros = 0.0;
+		// the vector path has to match the scalar path exactly
+		bool bMatches = true;
+	};
+
+	std::vector<Result> mResults;
+	int mWidth = 1920;
+	int mHeight = 1080;
+	int mNumIterations = 50;
+};
@@ -38,6 +38,11 @@ void ofApp::setup(){
 	psettings.maxNum = 2;
 	psettings.runningMode = runMode;
 	poseTracker->setup( psettings );
+	
+	// the hub converts each frame into a single mp image and shares it with all of the trackers
+	mFrameHub.add( handTracker );
+	mFrameHub.add( faceTracker );
+	mFrameHub.add( poseTracker );
 }
 
 //--------------------------------------------------------------
@@ -47,9 +52,7 @@ void ofApp::update(){
 		mVideoFps.newFrame();
 		mVideoPixels = mGrabber.getPixels();
 		mVideoPixels.mirror( false, true );
-		handTracker->process(mVideoPixels);
-		faceTracker->process(mVideoPixels);
-		poseTracker->process(mVideoPixels);
+		mFrameHub.process(mVideoPixels);
 		mVideoTexture.loadData(mVideoPixels);
 	}
 }
@@ -79,6 +82,12 @@ void ofApp::draw(){
 		ss << std::endl << "Hand Tracker FPS: " << handTracker->getFps();
 		ss << std::endl << "Face Tracker FPS: " << faceTracker->getFps();
 		ss << std::endl << "Pose Tracker FPS: " << poseTracker->getFps();
+		// capture to result latency in milliseconds
+		for( auto& tracker : mFrameHub.getTrackers() ) {
+			auto& stats = tracker->getStats();
+			ss << std::endl << tracker->getTrackerTypeAsString() << " latency p50: " << (stats.latency.getPercentile(50.0) / 1000) << "ms p99: " << (stats.latency.getPercentile(99.0) / 1000) << "ms";
+			ss << " GIL hold p50: " << stats.gilHold.getPercentile(50.0) << "us decode p50: " << stats.decode.getPercentile(50.0) << "us";
+		}
 		
 		ofDrawBitmapStringHighlight(ss.str(), 24, 24 );
 	}
@@ -87,6 +96,7 @@ void ofApp::draw(){
 //--------------------------------------------------------------
 void ofApp::exit(){
 	// remove instances of trackers
+	mFrameHub.clear();
 	handTracker.reset();
 	poseTracker.reset();
 	faceTracker.reset();
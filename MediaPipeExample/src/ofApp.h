@@ -3,6 +3,7 @@
 #include "ofxMediaPipeHandTracker.h"
 #include "ofxMediaPipeFaceTracker.h"
 #include "ofxMediaPipePoseTracker.h"
+#include "ofxMediaPipeFrameHub.h"
 
 class ofApp : public ofBaseApp{
 public:
@@ -29,6 +30,7 @@ public:
 	std::shared_ptr<ofx::MediaPipe::HandTracker> handTracker;
 	std::shared_ptr<ofx::MediaPipe::FaceTracker> faceTracker;
 	std::shared_ptr<ofx::MediaPipe::PoseTracker> poseTracker;
+	ofx::MediaPipe::FrameHub mFrameHub;
 	
 	ofFpsCounter mVideoFps;
 };
@@ -77,13 +77,13 @@ void ofApp::update(){
 	}
 	
 	if( handTracker->hasNewData() ) {
-		mOscSender->send<ofx::MediaPipe::Hand>( handTracker->getHands() );
+		mOscSender->send<ofx::MediaPipe::Hand>( handTracker->getHands(), handTracker->getTimestampMicros() );
 	}
 	if( faceTracker->hasNewData() ) {
-		mOscSender->send<ofx::MediaPipe::Face>( faceTracker->getFaces() );
+		mOscSender->send<ofx::MediaPipe::Face>( faceTracker->getFaces(), faceTracker->getTimestampMicros() );
 	}
 	if( poseTracker->hasNewData() ) {
-		mOscSender->send<ofx::MediaPipe::Pose>( poseTracker->getPoses() );
+		mOscSender->send<ofx::MediaPipe::Pose>( poseTracker->getPoses(), poseTracker->getTimestampMicros() );
 	}
 }
 
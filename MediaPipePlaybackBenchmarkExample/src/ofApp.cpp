@@ -0,0 +1,193 @@
+#include "ofApp.h"
+
+using namespace ofx::MediaPipe;
+
+// counts the allocations of the main thread, to check that Playback::update() does not allocate once it is running
+static thread_local std::uint64_t sNumAllocations = 0;
+
+void* operator new( std::size_t asize ) {
+	sNumAllocations++;
+	if( void* ptr = std::malloc(asize == 0 ? 1 : asize) ) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete( void* aptr ) noexcept {
+	std::free( aptr );
+}
+
+void operator delete( void* aptr, std::size_t ) noexcept {
+	std::free( aptr );
+}
+
+//--------------------------------------------------------------
+void ofApp::setup(){
+	ofSetFrameRate( 60 );
+	ofBackground( 30 );
+
+	mFilepath = ofToDataPath( "playback_benchmark" + RecordingReader::sBinaryExtension, true );
+	if( !ofFile::doesFileExist(mFilepath) ) {
+		auto startMicros = ofGetElapsedTimeMicros();
+		createRecording( mFilepath );
+		mCreateMillis = (double)(ofGetElapsedTimeMicros() - startMicros) / 1000.0;
+	}
+	startPlayback();
+}
+
+//--------------------------------------------------------------
+bool ofApp::createRecording( const of::filesystem::path& afile ) {
+	auto face = std::make_shared<Face>();
+	face->keypoints.resize( 478 );
+	for( int i = 0; i < 52; i++ ) {
+		face->setIncomingBlendShape( Face::sGetBlendShapeAsString((Face::BlendShapeType)(i-1)), 0.f, i );
+	}
+	std::vector<std::shared_ptr<Face>> faces = { face };
+
+	std::vector<std::shared_ptr<Hand>> hands;
+	for( int i = 0; i < 2; i++ ) {
+		auto hand = std::make_shared<Hand>();
+		hand->ID = i;
+		hand->index = i;
+		hand->handed = (i == 0 ? Hand::Handedness::RIGHT : Hand::Handedness::LEFT);
+		hand->keypoints.resize( 21 );
+		hands.push_back( hand );
+	}
+
+	auto pose = std::make_shared<Pose>();
+	pose->keypoints.resize( 33 );
+	std::vector<std::shared_ptr<Pose>> poses = { pose };
+
+	Recorder recorder;
+	auto settings = recorder.getWriterSettings();
+	// every frame has to make it into the file
+	settings.bBlockWhenFull = true;
+	recorder.setWriterSettings( settings );
+	if( !recorder.startRecording(1280, 720, afile.parent_path(), afile.filename().string()) ) {
+		return false;
+	}
+
+	// a face, hand and pose frame every 30th of a second
+	std::int64_t frameNanos = 1000000000 / 90;
+	for( size_t i = 0; i < mNumFrames; i++ ) {
+		float t = (float)i * 0.01f;
+		std::int64_t nanos = (std::int64_t)i * frameNanos;
+		if( i % 3 == 0 ) {
+			for( size_t k = 0; k < face->keypoints.size(); k++ ) {
+				face->keypoints[k].posN = glm::vec3( 0.5f + 0.2f * sinf(t + (float)k), 0.5f + 0.2f * cosf(t + (float)k), 0.f );
+			}
+			for( auto& bshape : face->getIncomingBlendShapes() ) {
+				bshape.score = 0.5f + 0.5f * sinf(t + (float)bshape.index);
+			}
+			face->updateBlendShapes( face->getIncomingBlendShapes() );
+			recorder.addFrame( nanos, faces );
+		} else if( i % 3 == 1 ) {
+			for( auto& hand : hands ) {
+				for( size_t k = 0; k < hand->keypoints.size(); k++ ) {
+					hand->keypoints[k].posN = glm::vec3( 0.25f + 0.5f * (float)hand->index + 0.1f * sinf(t + (float)k), 0.5f + 0.1f * cosf(t), 0.f );
+				}
+			}
+			recorder.addFrame( nanos, hands );
+		} else {
+			for( size_t k = 0; k < pose->keypoints.size(); k++ ) {
+				pose->keypoints[k].posN = glm::vec3( 0.5f + 0.3f * sinf(t * 0.5f + (float)k), 0.5f + 0.3f * cosf(t * 0.5f + (float)k), 0.f );
+			}
+			recorder.addFrame( nanos, poses );
+		}
+	}
+	recorder.stopRecording();
+	ofLogNotice("Benchmark") << "wrote " << mNumFrames << " frames to " << afile;
+	return true;
+}
+
+//--------------------------------------------------------------
+void ofApp::startPlayback() {
+	mNumUpdates = 0;
+	mNumSteppedFrames = 0;
+	mNumAllocations = 0;
+	mTotalMicros = 0.0;
+	mMaxMicros = 0.0;
+	mBFinished = false;
+
+	if( !mPlayback.load(mFilepath) ) {
+		ofLogError("Benchmark") << "unable to load " << mFilepath;
+		return;
+	}
+	mPlayback.setOutRect( ofRectangle(0, 0, ofGetWidth(), ofGetHeight()) );
+	mPlayback.setLoopState( OF_LOOP_NONE );
+	mPlayback.setSpeed( mSpeed );
+	mPlayback.play();
+}
+
+//--------------------------------------------------------------
+void ofApp::update(){
+	if( mBFinished || !mPlayback.isLoaded() ) {
+		return;
+	}
+
+	auto prevIndex = mPlayback.getCurrentFrameIndex();
+	auto prevAllocations = sNumAllocations;
+	auto startMicros = ofGetElapsedTimeMicros();
+	mPlayback.update();
+	double micros = (double)(ofGetElapsedTimeMicros() - startMicros);
+	// the first updates fill the frame cache
+	if( mNumUpdates > 10 ) {
+		mNumAllocations += sNumAllocations - prevAllocations;
+	}
+
+	mNumUpdates++;
+	mNumSteppedFrames += mPlayback.getCurrentFrameIndex() - prevIndex;
+	mTotalMicros += micros;
+	mMaxMicros = std::max( mMaxMicros, micros );
+
+	if( mPlayback.isDone() ) {
+		mBFinished = true;
+		ofLogNotice("Benchmark") << mNumUpdates << " updates, " << mNumSteppedFrames << " frames, average: " << ofToString(mTotalMicros / (double)mNumUpdates, 2) << "us max: " << ofToString(mMaxMicros, 1) << "us allocations: " << mNumAllocations;
+	}
+}
+
+//--------------------------------------------------------------
+void ofApp::draw(){
+	if( mPlayback.isLoaded() ) {
+		ofSetColor( 120, 200, 255 );
+		for( auto& face : mPlayback.getFaces() ) {
+			for( auto& kp : face->keypoints ) {
+				ofDrawCircle( kp.pos, 1.f );
+			}
+		}
+		ofSetColor( 255, 200, 120 );
+		for( auto& hand : mPlayback.getHands() ) {
+			for( auto& kp : hand->keypoints ) {
+				ofDrawCircle( kp.pos, 3.f );
+			}
+		}
+		ofSetColor( 160, 255, 160 );
+		for( auto& pose : mPlayback.getPoses() ) {
+			for( auto& kp : pose->keypoints ) {
+				ofDrawCircle( kp.pos, 4.f );
+			}
+		}
+	}
+
+	std::stringstream ss;
+	ss << "Playback of " << mNumFrames << " frames at " << mSpeed << "x speed." << std::endl;
+	if( mCreateMillis > 0.0 ) {
+		ss << "Recording written in " << ofToString(mCreateMillis, 0) << "ms." << std::endl;
+	}
+	ss << "Frame: " << mPlayback.getCurrentFrameIndex() << " / " << mPlayback.getNumFrames() << std::endl;
+	ss << "Updates: " << mNumUpdates << "   frames stepped: " << mNumSteppedFrames << std::endl;
+	if( mNumUpdates > 0 ) {
+		ss << "update() average: " << ofToString(mTotalMicros / (double)mNumUpdates, 2) << "us   max: " << ofToString(mMaxMicros, 1) << "us" << std::endl;
+	}
+	ss << "Allocations in update(): " << mNumAllocations << std::endl;
+	ss << (mBFinished ? "Finished. " : "") << "Press 'b' to run again.";
+	ofSetColor( 230 );
+	ofDrawBitmapString( ss.str(), 24, 32 );
+}
+
+//--------------------------------------------------------------
+void ofApp::keyPressed(int key){
+	if( key == 'b' ) {
+		startPlayback();
+	}
+}
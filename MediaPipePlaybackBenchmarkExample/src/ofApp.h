@@ -0,0 +1,31 @@
+#pragma once
+#include "ofMain.h"
+#include "ofxMediaPipeRecorder.h"
+#include "ofxMediaPipePlayback.h"
+
+class ofApp : public ofBaseApp{
+public:
+	void setup() override;
+	void update() override;
+	void draw() override;
+
+	void keyPressed(int key) override;
+
+	// writes a recording of mNumFrames frames cycling through face, hand and pose frames
+	bool createRecording( const of::filesystem::path& afile );
+	void startPlayback();
+
+	ofx::MediaPipe::Playback mPlayback;
+	of::filesystem::path mFilepath;
+	size_t mNumFrames = 100000;
+	float mSpeed = 100.f;
+
+	// measured around Playback::update()
+	std::uint64_t mNumUpdates = 0;
+	std::uint64_t mNumSteppedFrames = 0;
+	std::uint64_t mNumAllocations = 0;
+	double mTotalMicros = 0.0;
+	double mMaxMicros = 0.0;
+	double mCreateMillis = 0.0;
+	bool mBFinished = false;
+};
@@ -0,0 +1,195 @@
+#
+#  ofxMediaPipeWorker.py
+#  ofxMediaPipePython
+#
+#  Created by design-io on 10/17/26.
+#
+#  Runs a media pipe landmarker in its own process for ofx::MediaPipe::WorkerProcess.
+#  usage: python3 ofxMediaPipeWorker.py <socket fd> <config json>
+#
+#  config keys: type (hand, face or pose), modelPath, maxNum, minDetectionConfidence,
+#  minPresenceConfidence, minTrackingConfidence, outputFaceBlendshapes, categoryNamesOnce
+#
+#  messages from the app, one per line:
+#    M <shared memory name> <slot bytes> <num slots>   attach to a new frame segment
+#    F <slot> <timestamp> <width> <height> <channels>  a frame is ready in the slot
+#    Q                                                 quit
+#  messages to the app:
+#    R <slot> <timestamp> <num bytes>\n<packed results>, num bytes is 0 when the frame failed
+#    E <message>
+#
+
+import json
+import socket
+import struct
+import sys
+
+import numpy as np
+import mediapipe as mp
+from multiprocessing import shared_memory, resource_tracker
+
+
+def create_landmarker(config):
+	vision = mp.tasks.vision
+	base_options = mp.tasks.BaseOptions(model_asset_path=config["modelPath"])
+	rtype = config.get("type", "hand").lower()
+	max_num = int(config.get("maxNum", 2))
+	det = float(config.get("minDetectionConfidence", 0.5))
+	pres = float(config.get("minPresenceConfidence", 0.5))
+	track = float(config.get("minTrackingConfidence", 0.5))
+	mode = vision.RunningMode.VIDEO
+
+	if rtype == "face":
+		options = vision.FaceLandmarkerOptions(
+			base_options=base_options, running_mode=mode, num_faces=max_num,
+			min_face_detection_confidence=det, min_face_presence_confidence=pres,
+			min_tracking_confidence=track,
+			output_face_blendshapes=bool(config.get("outputFaceBlendshapes", False)))
+		return vision.FaceLandmarker.create_from_options(options)
+	if rtype == "pose":
+		options = vision.PoseLandmarkerOptions(
+			base_options=base_options, running_mode=mode, num_poses=max_num,
+			min_pose_detection_confidence=det, min_pose_presence_confidence=pres,
+			min_tracking_confidence=track)
+		return vision.PoseLandmarker.create_from_options(options)
+	options = vision.HandLandmarkerOptions(
+		base_options=base_options, running_mode=mode, num_hands=max_num,
+		min_hand_detection_confidence=det, min_hand_presence_confidence=pres,
+		min_tracking_confidence=track)
+	return vision.HandLandmarker.create_from_options(options)
+
+
+def get_result_lists(rtype, results):
+	# landmarks, world landmarks and categories
+	if rtype == "face":
+		return results.face_landmarks, [], (results.face_blendshapes or [])
+	if rtype == "pose":
+		return results.pose_landmarks, results.pose_world_landmarks, []
+	return results.hand_landmarks, results.hand_world_landmarks, results.handedness
+
+
+def pack_landmarks(lists, out):
+	counts = [len(marks) for marks in lists]
+	out.append(struct.pack("<I%di" % len(counts), len(counts), *counts))
+	xyz = np.fromiter((v for marks in lists for lm in marks for v in (lm.x, lm.y, lm.z)),
+					  dtype="<f4", count=sum(counts) * 3)
+	out.append(xyz.tobytes())
+
+
+def pack_categories(lists, out, with_names):
+	counts = [len(cats) for cats in lists]
+	out.append(struct.pack("<I%di" % len(counts), len(counts), *counts))
+	indices = [cat.index for cats in lists for cat in cats]
+	scores = [cat.score for cats in lists for cat in cats]
+	out.append(struct.pack("<%di%df" % (len(indices), len(scores)), *indices, *scores))
+	names = b""
+	if with_names:
+		names = "\n".join(cat.category_name or "" for cats in lists for cat in cats).encode("utf-8")
+	out.append(struct.pack("<I", len(names)))
+	out.append(names)
+
+
+class Worker:
+	def __init__(self, sock, config):
+		self.sock = sock
+		self.config = config
+		self.rtype = config.get("type", "hand").lower()
+		self.names_once = bool(config.get("categoryNamesOnce", False))
+		self.sent_names = False
+		self.shm = None
+		self.slot_bytes = 0
+		self.last_timestamp = -1
+		self.landmarker = create_landmarker(config)
+
+	def attach(self, name, slot_bytes):
+		self.detach()
+		self.shm = shared_memory.SharedMemory(name=name, create=False)
+		# the app owns the segment, the resource tracker would unlink it when this process exits
+		try:
+			resource_tracker.unregister(self.shm._name, "shared_memory")
+		except Exception:
+			pass
+		self.slot_bytes = slot_bytes
+
+	def detach(self):
+		if self.shm is not None:
+			self.shm.close()
+			self.shm = None
+
+	def process(self, slot, timestamp, width, height, channels):
+		if self.shm is None:
+			raise RuntimeError("frame received before shared memory")
+		offset = slot * self.slot_bytes
+		num_bytes = width * height * channels
+		# a view on the slot, mp.Image copies the pixels into its own buffer
+		pixels = np.ndarray((height, width, channels), dtype=np.uint8, buffer=self.shm.buf, offset=offset)
+		image_format = mp.ImageFormat.SRGB if channels == 3 else mp.ImageFormat.SRGBA
+		if channels == 1:
+			image_format = mp.ImageFormat.GRAY8
+			pixels = pixels.reshape((height, width))
+		image = mp.Image(image_format=image_format, data=pixels)
+		del pixels
+
+		# detect_for_video requires timestamps that increase with every call
+		if timestamp <= self.last_timestamp:
+			timestamp = self.last_timestamp + 1
+		self.last_timestamp = timestamp
+		results = self.landmarker.detect_for_video(image, timestamp)
+
+		landmarks, world, categories = get_result_lists(self.rtype, results)
+		with_names = not (self.names_once and self.sent_names)
+		out = []
+		pack_landmarks(landmarks, out)
+		pack_landmarks(world, out)
+		pack_categories(categories, out, with_names)
+		if with_names and len(categories) > 0:
+			self.sent_names = True
+		return b"".join(out)
+
+	def send(self, data):
+		self.sock.sendall(data)
+
+	def run(self):
+		reader = self.sock.makefile("rb")
+		for line in reader:
+			parts = line.decode("utf-8").split()
+			if not parts:
+				continue
+			cmd = parts[0]
+			if cmd == "Q":
+				break
+			if cmd == "M":
+				self.attach(parts[1], int(parts[2]))
+			elif cmd == "F":
+				slot = int(parts[1])
+				timestamp = int(parts[2])
+				try:
+					payload = self.process(slot, timestamp, int(parts[3]), int(parts[4]), int(parts[5]))
+				except Exception as e:
+					self.send(("E %s\n" % str(e).replace("\n", " ")).encode("utf-8"))
+					payload = b""
+				self.send(("R %d %d %d\n" % (slot, timestamp, len(payload))).encode("utf-8") + payload)
+		self.detach()
+		self.landmarker.close()
+
+
+def main():
+	if len(sys.argv) < 3:
+		print("usage: ofxMediaPipeWorker.py <socket fd> <config json>", file=sys.stderr)
+		return 1
+	sock = socket.socket(fileno=int(sys.argv[1]))
+	config = json.loads(sys.argv[2])
+	try:
+		worker = Worker(sock, config)
+	except Exception as e:
+		sock.sendall(("E unable to create landmarker: %s\n" % str(e).replace("\n", " ")).encode("utf-8"))
+		return 1
+	try:
+		worker.run()
+	except (BrokenPipeError, ConnectionResetError):
+		pass
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
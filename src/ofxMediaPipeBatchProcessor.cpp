@@ -0,0 +1,360 @@
+//
+//  ofxMediaPipeBatchProcessor.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeBatchProcessor.h"
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofVideoPlayer.h"
+#include "ofImage.h"
+#include <optional>
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+BatchProcessor::~BatchProcessor() {
+	stop();
+}
+
+//--------------------------------------------------------------
+void BatchProcessor::add( const std::shared_ptr<Tracker>& atracker ) {
+	if( !atracker ) return;
+	if( mBRunning ) {
+		ofLogWarning("BatchProcessor::add") << "can not add trackers while running.";
+		return;
+	}
+	for( auto& tracker : mTrackers ) {
+		if( tracker == atracker ) {
+			return;
+		}
+	}
+	mTrackers.push_back(atracker);
+}
+
+//--------------------------------------------------------------
+void BatchProcessor::clear() {
+	if( mBRunning ) {
+		ofLogWarning("BatchProcessor::clear") << "can not remove trackers while running.";
+		return;
+	}
+	mTrackers.clear();
+}
+
+//--------------------------------------------------------------
+bool BatchProcessor::run( const Settings& asettings ) {
+	if( mBRunning ) {
+		ofLogWarning("BatchProcessor::run") << "already running.";
+		return false;
+	}
+
+	mSettings = asettings;
+	if( mSettings.recordingPath.empty() ) {
+		ofLogError("BatchProcessor::run") << "the recording path is not set.";
+		return false;
+	}
+
+	std::vector< std::shared_ptr<Tracker> > trackers;
+	for( auto& tracker : mTrackers ) {
+		if( _canRun(tracker) ) {
+			trackers.push_back( tracker );
+		}
+	}
+	if( trackers.empty() ) {
+		ofLogError("BatchProcessor::run") << "no trackers that can run.";
+		return false;
+	}
+
+	auto sourcePath = of::filesystem::path( ofToDataPath(mSettings.source, true) );
+	if( !of::filesystem::exists(sourcePath) ) {
+		ofLogError("BatchProcessor::run") << "source does not exist: " << sourcePath;
+		return false;
+	}
+
+	mBRunning = true;
+	mBStopRequested = false;
+	mBDecodeFinished = false;
+	mQueue.clear();
+	mNumFrames = 0;
+	mNumFramesDecoded = 0;
+	mNumFramesProcessed = 0;
+	mFrameRate = std::clamp( (double)mSettings.frameRate, 1.0, 1000.0 );
+	mStartMicros = ofGetElapsedTimeMicros();
+	mLastLogMicros = mStartMicros;
+	mEndMicros = 0;
+	// every queued frame and the one each tracker is working on
+	mPixelPool.setMaxNumFree( std::max(1, mSettings.maxQueuedFrames) + trackers.size() );
+
+	// the trackers acquire the GIL on their threads
+	std::optional<py::gil_scoped_release> release;
+	if( Py_IsInitialized() && PyGILState_Check() ) {
+		release.emplace();
+	}
+
+	mWorkers.clear();
+	for( auto& tracker : trackers ) {
+		auto worker = std::make_unique<Worker>();
+		worker->tracker = tracker;
+		mWorkers.push_back( std::move(worker) );
+	}
+	for( auto& worker : mWorkers ) {
+		worker->thread = std::thread( &BatchProcessor::_workerThreadedFunction, this, worker.get() );
+	}
+
+	bool bDecoded = false;
+	if( of::filesystem::is_directory(sourcePath) ) {
+		bDecoded = _decodeImages( sourcePath );
+	} else {
+		bDecoded = _decodeVideo( sourcePath );
+	}
+
+	{
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		mBDecodeFinished = true;
+	}
+	mFrameCondition.notify_all();
+	for( auto& worker : mWorkers ) {
+		if( worker->thread.joinable() ) {
+			worker->thread.join();
+		}
+	}
+	mWorkers.clear();
+	mQueue.clear();
+
+	{
+		std::lock_guard<std::mutex> lock( mRecorderMutex );
+		if( mRecorder.isRecording() ) {
+			mRecorder.stopRecording();
+		}
+	}
+
+	mEndMicros = ofGetElapsedTimeMicros();
+	_logProgress( true );
+	mBRunning = false;
+	return bDecoded && mNumFramesProcessed > 0;
+}
+
+//--------------------------------------------------------------
+float BatchProcessor::getProgress() {
+	auto numFrames = mNumFrames.load();
+	if( numFrames < 1 ) {
+		return 0.f;
+	}
+	return ofClamp( (float)((double)mNumFramesProcessed.load() / (double)numFrames), 0.f, 1.f );
+}
+
+//--------------------------------------------------------------
+double BatchProcessor::getFps() {
+	auto endMicros = mEndMicros > 0 ? mEndMicros : ofGetElapsedTimeMicros();
+	if( endMicros <= mStartMicros ) {
+		return 0.0;
+	}
+	return (double)mNumFramesProcessed.load() / ((double)(endMicros - mStartMicros) / 1000000.0);
+}
+
+//--------------------------------------------------------------
+bool BatchProcessor::_canRun( const std::shared_ptr<Tracker>& atracker ) {
+	if( !atracker || !atracker->isSetup() ) {
+		ofLogWarning("BatchProcessor") << "skipping a tracker that is not set up.";
+		return false;
+	}
+	auto mode = atracker->getRunningMode();
+	if( mode != Tracker::MODE_VIDEO && mode != Tracker::MODE_IMAGE ) {
+		// the results of the other modes arrive later, on the next update of the app
+		ofLogWarning("BatchProcessor") << "skipping " << atracker->getTrackerTypeAsString() << " tracker, it has to run in MODE_VIDEO or MODE_IMAGE, not " << Tracker::sGetStringForRunningMode(mode);
+		return false;
+	}
+	if( atracker->isUsingWorker() ) {
+		ofLogWarning("BatchProcessor") << "skipping " << atracker->getTrackerTypeAsString() << " tracker, the worker process backend returns results asynchronously.";
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool BatchProcessor::_decodeVideo( const of::filesystem::path& apath ) {
+	ofVideoPlayer player;
+	player.setUseTexture( false );
+	if( !player.load(apath.string()) ) {
+		ofLogError("BatchProcessor::_decodeVideo") << "unable to load " << apath;
+		return false;
+	}
+
+	int totalFrames = player.getTotalNumFrames();
+	float duration = player.getDuration();
+	if( totalFrames > 0 && duration > 0.f ) {
+		mFrameRate = std::clamp( (double)totalFrames / (double)duration, 1.0, 1000.0 );
+	}
+	mNumFrames = (std::uint64_t)std::max( totalFrames, 0 );
+	ofLogNotice("BatchProcessor") << "processing " << totalFrames << " frames at " << ofToString(mFrameRate, 2) << " fps from " << apath;
+
+	player.setLoopState( OF_LOOP_NONE );
+	player.play();
+	player.setPaused( true );
+
+	while( !mBStopRequested ) {
+		// stepping a paused player can take a few updates before the frame arrives
+		bool bNewFrame = false;
+		auto startMillis = ofGetElapsedTimeMillis();
+		while( !mBStopRequested ) {
+			player.update();
+			bNewFrame = player.isFrameNew();
+			if( bNewFrame || player.getIsMovieDone() || ofGetElapsedTimeMillis() - startMillis > 5000 ) {
+				break;
+			}
+			std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+		}
+		if( !bNewFrame ) {
+			break;
+		}
+		if( !_push(player.getPixels()) ) {
+			break;
+		}
+		_logProgress( false );
+		if( totalFrames > 0 && mNumFramesDecoded >= (std::uint64_t)totalFrames ) {
+			break;
+		}
+		player.nextFrame();
+	}
+	player.close();
+	return mNumFramesDecoded > 0;
+}
+
+//--------------------------------------------------------------
+bool BatchProcessor::_decodeImages( const of::filesystem::path& apath ) {
+	ofDirectory dir( apath );
+	for( auto& ext : { "png", "jpg", "jpeg", "bmp", "tif", "tiff" } ) {
+		dir.allowExt( ext );
+	}
+	dir.listDir();
+	dir.sort();
+	mNumFrames = dir.size();
+	ofLogNotice("BatchProcessor") << "processing " << dir.size() << " images at " << ofToString(mFrameRate, 2) << " fps from " << apath;
+
+	ofPixels pix;
+	for( size_t i = 0; i < dir.size() && !mBStopRequested; i++ ) {
+		if( !ofLoadImage(pix, dir.getPath(i)) ) {
+			ofLogWarning("BatchProcessor::_decodeImages") << "unable to load " << dir.getPath(i);
+			continue;
+		}
+		if( !_push(pix) ) {
+			break;
+		}
+		_logProgress( false );
+	}
+	return mNumFramesDecoded > 0;
+}
+
+//--------------------------------------------------------------
+bool BatchProcessor::_push( const ofPixels& apix ) {
+	if( !apix.isAllocated() ) {
+		return true;
+	}
+
+	std::uint64_t index = mNumFramesDecoded.load();
+	if( index == 0 ) {
+		std::lock_guard<std::mutex> lock( mRecorderMutex );
+		auto settings = mRecorder.getWriterSettings();
+		// nothing is lost when the disk is slower than the trackers
+		settings.bBlockWhenFull = true;
+		mRecorder.setWriterSettings( settings );
+		auto path = of::filesystem::path( ofToDataPath(mSettings.recordingPath, true) );
+		if( !mRecorder.startRecording(apix.getWidth(), apix.getHeight(), path.parent_path(), path.filename().string()) ) {
+			ofLogError("BatchProcessor") << "unable to record to " << path;
+			return false;
+		}
+	}
+
+	{
+		std::unique_lock<std::mutex> lock( mQueueMutex );
+		mSpaceCondition.wait( lock, [this]() {
+			return mBStopRequested.load() || mQueue.size() < (size_t)std::max(1, mSettings.maxQueuedFrames);
+		});
+		if( mBStopRequested ) {
+			return false;
+		}
+	}
+
+	QueuedFrame frame;
+	frame.pixels = mPixelPool.acquireCopy( apix );
+	frame.index = index;
+	// from the frame index, so that the timestamps do not depend on how long decoding and inference take
+	frame.timestampNanos = (std::int64_t)((double)index * 1000000000.0 / mFrameRate);
+	{
+		std::lock_guard<std::mutex> lock( mQueueMutex );
+		mQueue.push_back( frame );
+	}
+	mNumFramesDecoded++;
+	mFrameCondition.notify_all();
+	return true;
+}
+
+//--------------------------------------------------------------
+void BatchProcessor::_workerThreadedFunction( Worker* aworker ) {
+	while( true ) {
+		QueuedFrame frame;
+		{
+			std::unique_lock<std::mutex> lock( mQueueMutex );
+			auto hasFrame = [this, aworker]() {
+				return !mQueue.empty() && aworker->nextIndex.load() - mQueue.front().index < mQueue.size();
+			};
+			mFrameCondition.wait( lock, [this, &hasFrame]() {
+				return mBStopRequested.load() || mBDecodeFinished || hasFrame();
+			});
+			if( mBStopRequested || !hasFrame() ) {
+				break;
+			}
+			frame = mQueue[ aworker->nextIndex.load() - mQueue.front().index ];
+		}
+
+		aworker->tracker->process( *frame.pixels, frame.timestampNanos / 1000 );
+		_addToRecording( aworker->tracker, frame.timestampNanos );
+		frame.pixels.reset();
+
+		{
+			std::lock_guard<std::mutex> lock( mQueueMutex );
+			aworker->nextIndex++;
+			// release the frames that every tracker is done with
+			std::uint64_t minIndex = aworker->nextIndex.load();
+			for( auto& worker : mWorkers ) {
+				minIndex = std::min( minIndex, worker->nextIndex.load() );
+			}
+			while( !mQueue.empty() && mQueue.front().index < minIndex ) {
+				mQueue.pop_front();
+			}
+			mNumFramesProcessed = minIndex;
+		}
+		mSpaceCondition.notify_one();
+	}
+}
+
+//--------------------------------------------------------------
+void BatchProcessor::_addToRecording( const std::shared_ptr<Tracker>& atracker, std::int64_t atimestampNanos ) {
+	// the objects are only changed by the thread of their tracker
+	std::lock_guard<std::mutex> lock( mRecorderMutex );
+	auto type = atracker->getTrackerType();
+	if( type == TrackedObject::HAND ) {
+		mRecorder.addFrame( atimestampNanos, std::static_pointer_cast<HandTracker>(atracker)->getHands() );
+	} else if( type == TrackedObject::FACE ) {
+		mRecorder.addFrame( atimestampNanos, std::static_pointer_cast<FaceTracker>(atracker)->getFaces() );
+	} else if( type == TrackedObject::POSE ) {
+		mRecorder.addFrame( atimestampNanos, std::static_pointer_cast<PoseTracker>(atracker)->getPoses() );
+	}
+}
+
+//--------------------------------------------------------------
+void BatchProcessor::_logProgress( bool abForce ) {
+	if( !abForce && mSettings.logIntervalSeconds <= 0.f ) {
+		return;
+	}
+	auto nowMicros = ofGetElapsedTimeMicros();
+	if( !abForce && (double)(nowMicros - mLastLogMicros) < (double)mSettings.logIntervalSeconds * 1000000.0 ) {
+		return;
+	}
+	mLastLogMicros = nowMicros;
+	ofLogNotice("BatchProcessor") << mNumFramesProcessed.load() << " / " << mNumFrames.load() << " frames processed, " << mNumFramesDecoded.load() << " decoded, " << ofToString(getFps(), 1) << " fps";
+}
+
+#endif
@@ -0,0 +1,119 @@
+//
+//  ofxMediaPipeBatchProcessor.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofxMediaPipeHandTracker.h"
+#include "ofxMediaPipeFaceTracker.h"
+#include "ofxMediaPipePoseTracker.h"
+#include "ofxMediaPipeRecorder.h"
+#include "ofxMediaPipePixelPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ofx::MediaPipe {
+// Runs trackers over a video file or a folder of images as fast as they can go and writes the results with a Recorder.
+// Frames get timestamps from their index and the frame rate instead of the clock, so the results do not depend on how fast the machine is.
+// The calling thread decodes the frames, each tracker processes them in order on its own thread,
+// so hand, face and pose inference overlap. Media pipe releases the GIL while it runs the graph,
+// use Interpreter::MODE_ISOLATED to also run the python side of the trackers in parallel.
+// The trackers have to be set up in MODE_VIDEO or MODE_IMAGE with BACKEND_EMBEDDED.
+class BatchProcessor {
+public:
+	class Settings {
+	public:
+		// a video file or a folder of images, the images are sorted by file name
+		of::filesystem::path source { "" };
+		// .json or .mpbin, see Recorder
+		of::filesystem::path recordingPath { "" };
+		// used for image sequences and for videos that do not report a duration
+		float frameRate = 30.f;
+		// decoded frames that can wait for the slowest tracker, limits the memory used
+		int maxQueuedFrames = 8;
+		// seconds between progress messages, 0 to turn them off
+		float logIntervalSeconds = 10.f;
+	};
+
+	~BatchProcessor();
+
+	void add( const std::shared_ptr<Tracker>& atracker );
+	void clear();
+	std::vector< std::shared_ptr<Tracker> >& getTrackers() { return mTrackers; }
+
+	// blocks until every frame of the source has been processed and written or stop() was called.
+	// Releases the GIL of the calling thread while running. Returns false if nothing could be processed.
+	bool run( const Settings& asettings );
+	// can be called from any thread, run returns after the frames that are being processed
+	void stop() { mBStopRequested = true; }
+	bool isRunning() { return mBRunning.load(); }
+
+	std::uint64_t getNumFrames() { return mNumFrames.load(); }
+	std::uint64_t getNumFramesDecoded() { return mNumFramesDecoded.load(); }
+	// frames that every tracker has processed
+	std::uint64_t getNumFramesProcessed() { return mNumFramesProcessed.load(); }
+	// 0 - 1, based on the frame count of the source
+	float getProgress();
+	// processed frames per second of the last run
+	double getFps();
+
+	Recorder& getRecorder() { return mRecorder; }
+
+protected:
+	struct QueuedFrame {
+		std::shared_ptr<ofPixels> pixels;
+		std::uint64_t index = 0;
+		std::int64_t timestampNanos = 0;
+	};
+
+	struct Worker {
+		std::shared_ptr<Tracker> tracker;
+		std::thread thread;
+		// index of the next frame that the tracker processes
+		std::atomic<std::uint64_t> nextIndex = 0;
+	};
+
+	bool _canRun( const std::shared_ptr<Tracker>& atracker );
+	bool _decodeVideo( const of::filesystem::path& apath );
+	bool _decodeImages( const of::filesystem::path& apath );
+	// blocks while the queue is full, starts the recording with the first frame
+	bool _push( const ofPixels& apix );
+	void _workerThreadedFunction( Worker* aworker );
+	void _addToRecording( const std::shared_ptr<Tracker>& atracker, std::int64_t atimestampNanos );
+	void _logProgress( bool abForce );
+
+	std::vector< std::shared_ptr<Tracker> > mTrackers;
+	std::vector< std::unique_ptr<Worker> > mWorkers;
+	Settings mSettings;
+
+	std::mutex mQueueMutex;
+	std::condition_variable mFrameCondition;
+	std::condition_variable mSpaceCondition;
+	// frames that have not been processed by every tracker, ordered by index
+	std::deque<QueuedFrame> mQueue;
+	bool mBDecodeFinished = false;
+	PixelPool mPixelPool;
+
+	// the trackers of different types add their results from their own threads
+	std::mutex mRecorderMutex;
+	Recorder mRecorder;
+
+	std::atomic<bool> mBRunning = false;
+	std::atomic<bool> mBStopRequested = false;
+	std::atomic<std::uint64_t> mNumFrames = 0;
+	std::atomic<std::uint64_t> mNumFramesDecoded = 0;
+	std::atomic<std::uint64_t> mNumFramesProcessed = 0;
+	double mFrameRate = 30.0;
+	std::uint64_t mStartMicros = 0;
+	std::uint64_t mEndMicros = 0;
+	std::uint64_t mLastLogMicros = 0;
+};
+}
+#endif
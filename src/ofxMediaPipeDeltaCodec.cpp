@@ -0,0 +1,258 @@
+//
+//  ofxMediaPipeDeltaCodec.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeDeltaCodec.h"
+#include "ofxMediaPipeFrame.h"
+#include "ofxMediaPipeQuantizer.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace ofx::MediaPipe;
+
+namespace {
+//--------------------------------------------------------------
+template<typename T>
+void appendValue( std::string& aout, const T& avalue ) {
+	aout.append( reinterpret_cast<const char*>(&avalue), sizeof(T) );
+}
+
+//--------------------------------------------------------------
+template<typename T>
+bool readValue( const char*& adata, const char* aend, T& avalue ) {
+	if( adata + sizeof(T) > aend ) {
+		return false;
+	}
+	memcpy( &avalue, adata, sizeof(T) );
+	adata += sizeof(T);
+	return true;
+}
+
+//--------------------------------------------------------------
+inline char* writeVarint( char* adst, std::uint32_t av ) {
+	while( av >= 0x80 ) {
+		*adst++ = (char)((av & 0x7F) | 0x80);
+		av >>= 7;
+	}
+	*adst++ = (char)av;
+	return adst;
+}
+
+//--------------------------------------------------------------
+inline bool readVarint( const char*& adata, const char* aend, std::uint32_t& av ) {
+	av = 0;
+	for( int shift = 0; shift < 32 && adata < aend; shift += 7 ) {
+		std::uint8_t byte = (std::uint8_t)*adata++;
+		av |= (std::uint32_t)(byte & 0x7F) << shift;
+		if( !(byte & 0x80) ) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Every value is written as a token, the lowest bit tells what it holds:
+// 0: the zigzag encoded difference, 1: the number of unchanged values minus one.
+// A difference is at most 65535, so a token takes at most 3 bytes.
+const size_t kMaxTokenBytes = 3;
+
+//--------------------------------------------------------------
+char* appendDeltas( char* adst, const std::uint16_t* acur, const std::uint16_t* aprev, size_t anum ) {
+	std::uint32_t run = 0;
+	for( size_t i = 0; i < anum; i++ ) {
+		std::int32_t d = (std::int32_t)acur[i] - (aprev ? (std::int32_t)aprev[i] : 0);
+		if( d == 0 ) {
+			run++;
+			continue;
+		}
+		if( run > 0 ) {
+			adst = writeVarint( adst, ((run - 1) << 1) | 1 );
+			run = 0;
+		}
+		std::uint32_t zigzag = ((std::uint32_t)d << 1) ^ (std::uint32_t)(d >> 31);
+		adst = writeVarint( adst, zigzag << 1 );
+	}
+	if( run > 0 ) {
+		adst = writeVarint( adst, ((run - 1) << 1) | 1 );
+	}
+	return adst;
+}
+
+//--------------------------------------------------------------
+bool applyDeltas( const char* adata, const char* aend, std::uint16_t* avalues, size_t anum ) {
+	size_t i = 0;
+	while( adata < aend ) {
+		std::uint32_t token = 0;
+		if( !readVarint(adata, aend, token) ) {
+			return false;
+		}
+		if( token & 1 ) {
+			size_t run = (size_t)(token >> 1) + 1;
+			if( run > anum - i ) {
+				return false;
+			}
+			i += run;
+			continue;
+		}
+		if( i >= anum ) {
+			return false;
+		}
+		std::uint32_t zigzag = token >> 1;
+		std::int32_t d = (std::int32_t)(zigzag >> 1) ^ -(std::int32_t)(zigzag & 1);
+		avalues[i] = (std::uint16_t)((std::int32_t)avalues[i] + d);
+		i++;
+	}
+	// the encoder writes a run for the unchanged values at the end
+	return i == anum;
+}
+}
+
+//--------------------------------------------------------------
+void DeltaCodec::reset() {
+	mBKeyframeRequested = true;
+	mFramesSinceKeyframe = 0;
+	mEncodeSequence = 0;
+	mEncodeStates.clear();
+	mDecodeSequence = 0;
+	mDecodeStates.clear();
+	mNumSkipped = 0;
+}
+
+//--------------------------------------------------------------
+bool DeltaCodec::appendFrameHeader( std::string& aout ) {
+	mEncodeSequence++;
+	bool bKeyframe = mBKeyframeRequested || mKeyframeInterval <= 1 || mFramesSinceKeyframe >= mKeyframeInterval;
+	if( bKeyframe ) {
+		// the objects that left are forgotten
+		mEncodeStates.clear();
+		mFramesSinceKeyframe = 0;
+		mBKeyframeRequested = false;
+	}
+	mFramesSinceKeyframe++;
+	appendValue( aout, mEncodeSequence );
+	appendValue( aout, (std::uint8_t)(bKeyframe ? 1 : 0) );
+	appendValue( aout, (std::uint8_t)0 );
+	appendValue( aout, (std::uint16_t)0 );
+	return bKeyframe;
+}
+
+//--------------------------------------------------------------
+void DeltaCodec::appendKeypoints( std::string& aout, std::int32_t aID, const std::vector<TrackedObject::Keypoint>& akps, size_t aNum ) {
+	aNum = std::min( aNum, akps.size() );
+	_quantize( akps, aNum );
+
+	// new objects and objects with a different number of keypoints are written as keyframes
+	auto& state = mEncodeStates[aID];
+	bool bKeyframe = state.values.size() != mValues.size() || state.sequence == 0;
+	appendValue( aout, (std::uint8_t)(bKeyframe ? 1 : 0) );
+	appendValue( aout, (std::uint8_t)0 );
+	appendValue( aout, (std::uint16_t)0 );
+	appendValue( aout, (std::uint32_t)(bKeyframe ? 0 : state.sequence) );
+	size_t sizeOffset = aout.size();
+	appendValue( aout, (std::uint32_t)0 );
+
+	size_t start = aout.size();
+	aout.resize( start + mValues.size() * kMaxTokenBytes );
+	char* end = appendDeltas( &aout[start], mValues.data(), bKeyframe ? nullptr : state.values.data(), mValues.size() );
+	auto numBytes = (std::uint32_t)(end - &aout[start]);
+	aout.resize( start + numBytes );
+	memcpy( &aout[sizeOffset], &numBytes, sizeof(numBytes) );
+
+	state.values = mValues;
+	state.sequence = mEncodeSequence;
+}
+
+//--------------------------------------------------------------
+bool DeltaCodec::readFrameHeader( const char*& adata, const char* aend ) {
+	std::uint32_t sequence = 0;
+	std::uint8_t bKeyframe = 0, reserved8 = 0;
+	std::uint16_t reserved16 = 0;
+	if( !readValue(adata, aend, sequence) || !readValue(adata, aend, bKeyframe) || !readValue(adata, aend, reserved8) || !readValue(adata, aend, reserved16) ) {
+		return false;
+	}
+	// every object of a keyframe is a keyframe. The messages of a frame that was split share its header,
+	// only the first one forgets the objects that left.
+	if( bKeyframe && sequence != mDecodeSequence ) {
+		mDecodeStates.clear();
+	}
+	mDecodeSequence = sequence;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool DeltaCodec::readKeypoints( const char*& adata, const char* aend, std::int32_t aID, size_t aNum, std::vector<TrackedObject::Keypoint>& akps, bool& abDecoded ) {
+	abDecoded = false;
+	std::uint8_t bKeyframe = 0, reserved8 = 0;
+	std::uint16_t reserved16 = 0;
+	std::uint32_t baseSequence = 0, numBytes = 0;
+	if( !readValue(adata, aend, bKeyframe) || !readValue(adata, aend, reserved8) || !readValue(adata, aend, reserved16)
+	   || !readValue(adata, aend, baseSequence) || !readValue(adata, aend, numBytes) || adata + numBytes > aend ) {
+		return false;
+	}
+	const char* deltas = adata;
+	adata += numBytes;
+
+	State* state = nullptr;
+	if( bKeyframe ) {
+		state = &mDecodeStates[aID];
+		state->values.assign( aNum * 6, 0 );
+	} else {
+		auto it = mDecodeStates.find( aID );
+		if( it == mDecodeStates.end() || it->second.sequence != baseSequence || it->second.values.size() != aNum * 6 ) {
+			// the frame it depends on was lost
+			mNumSkipped++;
+			return true;
+		}
+		state = &it->second;
+	}
+	if( !applyDeltas(deltas, deltas + numBytes, state->values.data(), state->values.size()) ) {
+		mDecodeStates.erase( aID );
+		return false;
+	}
+	state->sequence = mDecodeSequence;
+	_dequantize( state->values, aNum, akps );
+	abDecoded = true;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool DeltaCodec::sIsKeyframe( const char* adata, size_t anumBytes, bool& abKeyframe ) {
+	if( anumBytes < sFrameHeaderSize ) {
+		return false;
+	}
+	abKeyframe = adata[sizeof(std::uint32_t)] != 0;
+	return true;
+}
+
+//--------------------------------------------------------------
+void DeltaCodec::_quantize( const std::vector<TrackedObject::Keypoint>& akps, size_t aNum ) {
+	mFloats.resize( aNum * 6 );
+	mValues.resize( aNum * 6 );
+	float* posN = mFloats.data();
+	float* posWorld = posN + aNum * 3;
+	for( size_t i = 0; i < aNum; i++ ) {
+		memcpy( posN + i * 3, &akps[i].posN.x, 3 * sizeof(float) );
+		memcpy( posWorld + i * 3, &akps[i].posWorld.x, 3 * sizeof(float) );
+	}
+	Quantizer::sEncodeUnorm16( posN, mValues.data(), aNum * 3, Frame::sQuantizedPosNMin, Frame::sQuantizedPosNMax );
+	Quantizer::sEncodeUnorm16( posWorld, mValues.data() + aNum * 3, aNum * 3, sWorldMin, sWorldMax );
+}
+
+//--------------------------------------------------------------
+void DeltaCodec::_dequantize( const std::vector<std::uint16_t>& avalues, size_t aNum, std::vector<TrackedObject::Keypoint>& akps ) {
+	if( akps.size() != aNum ) {
+		akps.resize( aNum );
+	}
+	mFloats.resize( aNum * 6 );
+	float* posN = mFloats.data();
+	float* posWorld = posN + aNum * 3;
+	Quantizer::sDecodeUnorm16( avalues.data(), posN, aNum * 3, Frame::sQuantizedPosNMin, Frame::sQuantizedPosNMax );
+	Quantizer::sDecodeUnorm16( avalues.data() + aNum * 3, posWorld, aNum * 3, sWorldMin, sWorldMax );
+	for( size_t i = 0; i < aNum; i++ ) {
+		memcpy( &akps[i].posN.x, posN + i * 3, 3 * sizeof(float) );
+		memcpy( &akps[i].posWorld.x, posWorld + i * 3, 3 * sizeof(float) );
+	}
+}
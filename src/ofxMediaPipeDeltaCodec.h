@@ -0,0 +1,83 @@
+//
+//  ofxMediaPipeDeltaCodec.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofxMediaPipeTrackedObject.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ofx::MediaPipe {
+// Temporal compression of the keypoints of one tracked object type, used by Frame::OSC_ENCODING_DELTA
+// messages and Frame::KEYPOINTS_DELTA recordings. Use one codec per type and per stream.
+// The keypoints are quantized to uint16, posN like Frame::KEYPOINTS_QUANTIZED and posWorld over sWorldMin - sWorldMax.
+// Each object is written as the difference to the values of the same ID in the frame before, as zigzag varints
+// with runs of unchanged values folded into a single varint. Keyframes are written as the difference to 0.
+// Encoder and decoder keep the same quantized values, so the error does not build up between keyframes.
+// A decoder that missed a frame skips the objects that depend on it until their next keyframe.
+class DeltaCodec {
+public:
+	// u32 sequence, u8 bKeyframe, u8 reserved, u16 reserved
+	static const size_t sFrameHeaderSize = 8;
+	// u8 bKeyframe, u8 reserved, u16 reserved, u32 base sequence, u32 numBytes, followed by the varints
+	static const size_t sObjectHeaderSize = 12;
+	// meters, media pipe world landmarks are relative to the hips or the center of the hand.
+	// The step is 2^-14, ie. 0.06 mm, and 0 is stored exactly.
+	static constexpr float sWorldMin = -2.f;
+	static constexpr float sWorldMax = 1.99993896484375f;
+
+	// a keyframe is written every aNumFrames frames, 30 by default. 1 writes only keyframes.
+	void setKeyframeInterval( int aNumFrames ) { mKeyframeInterval = aNumFrames; }
+	int getKeyframeInterval() { return mKeyframeInterval; }
+	// the next frame is written as a keyframe, ie. after a frame was dropped
+	void requestKeyframe() { mBKeyframeRequested = true; }
+	// clears the encoder and decoder state, the next frame is a keyframe
+	void reset();
+
+	// Encoding, appendFrameHeader followed by appendKeypoints for every object of the frame.
+	// returns true if the frame is a keyframe
+	bool appendFrameHeader( std::string& aout );
+	// appends the object header and the first aNum keypoints of the object with aID
+	void appendKeypoints( std::string& aout, std::int32_t aID, const std::vector<TrackedObject::Keypoint>& akps, size_t aNum );
+
+	// Decoding, readFrameHeader followed by readKeypoints for every object of the frame.
+	// returns false if the header is cut off
+	bool readFrameHeader( const char*& adata, const char* aend );
+	// Moves adata past the object. akps is set when the frame that the object depends on was decoded, abDecoded tells if it was.
+	// returns false if the data is cut off or corrupt.
+	bool readKeypoints( const char*& adata, const char* aend, std::int32_t aID, size_t aNum, std::vector<TrackedObject::Keypoint>& akps, bool& abDecoded );
+	// checks the frame header without decoding, returns false if it is cut off
+	static bool sIsKeyframe( const char* adata, size_t anumBytes, bool& abKeyframe );
+
+	// objects that were skipped while waiting for a keyframe
+	std::uint64_t getNumSkipped() { return mNumSkipped; }
+
+protected:
+	struct State {
+		std::uint32_t sequence = 0;
+		std::vector<std::uint16_t> values;
+	};
+
+	void _quantize( const std::vector<TrackedObject::Keypoint>& akps, size_t aNum );
+	void _dequantize( const std::vector<std::uint16_t>& avalues, size_t aNum, std::vector<TrackedObject::Keypoint>& akps );
+
+	int mKeyframeInterval = 30;
+	bool mBKeyframeRequested = true;
+	int mFramesSinceKeyframe = 0;
+	std::uint32_t mEncodeSequence = 0;
+	std::unordered_map<std::int32_t, State> mEncodeStates;
+
+	std::uint32_t mDecodeSequence = 0;
+	std::unordered_map<std::int32_t, State> mDecodeStates;
+	std::uint64_t mNumSkipped = 0;
+
+	// reused so that coding does not allocate
+	std::vector<float> mFloats;
+	std::vector<std::uint16_t> mValues;
+};
+}
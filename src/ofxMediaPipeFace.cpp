@@ -129,6 +129,19 @@ void Face::updateFromFaceWithSmoothing( std::shared_ptr<Face>& aother, float pct
 	updateBlendShapes(aother->getIncomingBlendShapes());
 }
 
+//-------------------------------------------
+void Face::updateFromInterpolated( std::shared_ptr<Face>& aA, std::shared_ptr<Face>& aB, float apct ) {
+	updateKeypointsFromInterpolation( aA, aB, apct );
+	updateBlendShapes(aA->getIncomingBlendShapes());
+	auto& bshapesB = aB->getIncomingBlendShapes();
+	if( mBlendShapes.size() == bshapesB.size() ) {
+		float pct = ofClamp(apct, 0.f, 1.f);
+		for( size_t i = 0; i < mBlendShapes.size(); i++ ) {
+			mBlendShapes[i].score += (bshapesB[i].score - mBlendShapes[i].score) * pct;
+		}
+	}
+}
+
 //-------------------------------------------
 void Face::updateFromKeypoints() {
 	updateDrawMeshes();
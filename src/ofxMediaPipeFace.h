@@ -144,6 +144,8 @@ public:
 	
 	void updateFrom( std::shared_ptr<Face>& aother );
 	void updateFromFaceWithSmoothing( std::shared_ptr<Face>& aother, float pct );
+	// keypoints and blend shape scores between two recorded frames
+	void updateFromInterpolated( std::shared_ptr<Face>& aA, std::shared_ptr<Face>& aB, float apct );
 	
 	void updateFromKeypoints() override;
 	void updateBlendShapes(const std::vector< Face::BlendShape >& aOtherBlendShapes );
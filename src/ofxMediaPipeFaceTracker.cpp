@@ -60,7 +60,8 @@ bool FaceTracker::setup( const Tracker::Settings& asettings ) {
 
 //-------------------------------------------------
 bool FaceTracker::setup( const FaceSettings& asettings ) {
-	if (!Py_IsInitialized()) {
+	// a worker process has its own interpreter
+	if (!Py_IsInitialized() && asettings.backend != Tracker::BACKEND_WORKER_PROCESS) {
 		ofLogNotice("FaceTracker") << "initing PYTHON";
 		py::initialize_interpreter();
 	}
@@ -70,6 +71,7 @@ bool FaceTracker::setup( const FaceSettings& asettings ) {
 	}
 	
 	mSettings = asettings;
+	_applyBaseSettings( mSettings );
 	mHasNewThreadValues = false;
 	mBSetup = false;
 	
@@ -90,7 +92,19 @@ bool FaceTracker::setup( const FaceSettings& asettings ) {
 	Tracker::release();
 	mBExiting = false;
 	
-	py::gil_scoped_acquire acquire;
+	if( mSettings.backend == Tracker::BACKEND_WORKER_PROCESS ) {
+		// results arrive on the reader thread of the worker and are applied in update, like the video thread
+		mSettings.runningMode = Tracker::MODE_OF_VIDEO_THREAD;
+		ofJson jconfig;
+		jconfig["outputFaceBlendshapes"] = mSettings.outputFaceBlendshapes;
+		// the blend shape names are cached by index, see _process_packed_results
+		jconfig["categoryNamesOnce"] = true;
+		return _setupWorker( mSettings, jconfig );
+	}
+	
+	_setupInterpreter( mSettings );
+	// acquires the GIL of the tracker's interpreter
+	ScopedGilAcquire acquire( nullptr, nullptr, &mInterpreter );
 	py_mediapipe = py::module::import("mediapipe");
 	
 	py::object BaseOptions = py_mediapipe.attr("tasks").attr("BaseOptions");
@@ -106,16 +120,10 @@ bool FaceTracker::setup( const FaceSettings& asettings ) {
 	// base_options = python.BaseOptions(model_asset_path = 'gesture_recognizer.task', delegate = python.BaseOptions.Delegate.GPU)
 
 	
-	process_results_lambda = [this](py::object& aresults, py::object& aMpImage, int aTimestamp) {
+	process_results_lambda = [this](py::object& aresults, py::object& aMpImage, std::int64_t aTimestamp) {
 		//		std::cout << "Class Lambda Result callback called. " << aTimestamp << std::endl;
 //		_process_results_callback( aresults, aMpImage, aTimestamp );
-		if( mBExiting.load() ) {
-			mThreadCallCount--;
-			if( mThreadCallCount < 0 ) {
-				mThreadCallCount = 0;
-			}
-			return;
-		}
+		// _process_results_callback clears the in flight frames when exiting
 		try {
 			_process_results_callback( aresults, aMpImage, aTimestamp );
 		} catch(...) {
@@ -179,7 +187,9 @@ void FaceTracker::_update() {
 		if(mHasNewThreadValues.load() ) {
 			std::lock_guard<std::mutex> lck(mMutex);
 //			mFaces = mThreadedFaces;
+			mTimestampMicros = mThreadedTimestampMicros;
 			_matchFaces(mThreadedFaces, mFaces);
+			_trace( Trace::STAGE_MATCH_DONE, mTimestampMicros );
 //			mThreadedFaces.clear();
 			mHasNewThreadValues = false;
 			mBHasNewData = true;
@@ -277,13 +287,13 @@ std::vector< std::shared_ptr<Face> >& FaceTracker::getFaces() {
 //										   1.00000000e+00]])]
 
 //----------------------------------------------------------
-void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp) {
+void FaceTracker::_process_landmark_results(py::object& aresults, std::int64_t aTimestampMicros) {
 	if (mBExiting.load()) {
 		return;
 	}
 	
 	if (aresults.is_none()) {
-		ofLogNotice("FaceTracker::_process_landmark_results") << "Results are bad, returning. " << aTimestamp;
+		ofLogNotice("FaceTracker::_process_landmark_results") << "Results are bad, returning. " << aTimestampMicros;
 		return;
 	}
 	
@@ -291,12 +301,11 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 //	return;
 	
 	if( !Utils::has_attribute(aresults, "face_landmarks")) {
-		ofLogError("FaceTracker::_process_landmark_results") << "Does not contain either face_landmarks or face_world_landmarks attributes. " << aTimestamp;
+		ofLogError("FaceTracker::_process_landmark_results") << "Does not contain either face_landmarks or face_world_landmarks attributes. " << aTimestampMicros;
 		return;
 	}
 	
 	//https://developers.google.com/mediapipe/solutions/vision/hand_landmarker/python#live-stream_2
-	std::vector< std::shared_ptr<Face> > tfaces;
 	try {
 //		py::gil_scoped_acquire acquire;
 		py::list face_landmarks_list = aresults.attr("face_landmarks").cast<py::list>();
@@ -305,14 +314,14 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 		//	Check if results is iterable
 		if (!py::isinstance<py::iterable>(face_landmarks_list)) {
-			ofLogError("FaceTracker::_process_landmark_results") << "'results' face_landmarks is not iterable." << aTimestamp;
+			ofLogError("FaceTracker::_process_landmark_results") << "'results' face_landmarks is not iterable." << aTimestampMicros;
 			//py::gil_scoped_release release;
 			return;
 		}
 
 		if (mSettings.outputFaceBlendshapes) {
 			if (!Utils::has_attribute(aresults, "face_blendshapes")) {
-				ofLogError("FaceTracker::_process_landmark_results") << "Does not contain face_blendshapes attributes." << aTimestamp;
+				ofLogError("FaceTracker::_process_landmark_results") << "Does not contain face_blendshapes attributes." << aTimestampMicros;
 				//py::gil_scoped_release release;
 				return;
 			}
@@ -321,7 +330,7 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 			//	Check if results are iterable
 			if (!py::isinstance<py::iterable>(face_blendshapes_list)) {
-				ofLogError("FaceTracker::_process_landmark_results") << "'results' face_blendshapes is not iterable." << aTimestamp;
+				ofLogError("FaceTracker::_process_landmark_results") << "'results' face_blendshapes is not iterable." << aTimestampMicros;
 				//py::gil_scoped_release release;
 				return;
 			}
@@ -329,7 +338,7 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 		//	if( mSettings.outputFacialTransformationMatrices ) {
 		//		if( !Utils::has_attribute(aresults, "facial_transformation_matrixes")) {
-		//			ofLogError("FaceTracker::_process_landmark_results") << "Does not contain facial_transformation_matrixes attributes." << aTimestamp;
+		//			ofLogError("FaceTracker::_process_landmark_results") << "Does not contain facial_transformation_matrixes attributes." << aTimestampMicros;
 		//			return;
 		//		}
 		//		
@@ -337,7 +346,7 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 		//		
 		//		//	Check if results is iterable
 		//		if (!py::isinstance<py::iterable>(face_trans_mats_list)) {
-		//			ofLogError("FaceTracker::_process_landmark_results") << "'results' facial_transformation_matrixes is not iterable." << aTimestamp;
+		//			ofLogError("FaceTracker::_process_landmark_results") << "'results' facial_transformation_matrixes is not iterable." << aTimestampMicros;
 		//			return;
 		//		}
 		//	}
@@ -348,69 +357,20 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 		//	std::cout << "_________________________________________" << std::endl;
 		// std::vector< std::shared_ptr<Face> > tfaces;
-		int numMarks = py::len(face_landmarks_list);
-		for (int i = 0; i < numMarks; i++) {
-
-			//		Face tface;
-			auto tface = std::make_shared<Face>();
-
-			py::list face_landmarks = face_landmarks_list[i];
-			//		py::list face_world_landmarks = face_world_landmarks_list[i];
-
-			if (mSettings.outputFaceBlendshapes) {
-				py::list face_blendshapes = face_blendshapes_list[i];
-				int numBlends = py::len(face_blendshapes);
-				for (int j = 0; j < numBlends; j++) {
-					py::object hbs = face_blendshapes[j];
-					std::string hcategory = py::str(hbs.attr("category_name"));
-					float hscore = py::float_(hbs.attr("score"));
-					int hindex = py::int_(hbs.attr("index"));
-					//				std::cout << "index: " << hindex << " hcategory: " << hcategory << " score: " << hscore << std::endl;
-					tface->setIncomingBlendShape(hcategory, hscore, hindex);
-				}
-			}
-
-			//		if( mSettings.outputFacialTransformationMatrices ) {
-			////			py::array face_matrices = py::array(face_trans_mats_list[i]);
-			////			float f1 = py::float_(face_matrices[0][0]);
-			////			cout << "face matrices: " << f1 << std::endl;
-			//		}
-
-			int num = py::len(face_landmarks);
-
-			tface->keypoints.assign(num, TrackedObject::Keypoint());
-
-			//		for( int j = 0; j < num; j++ ) {
-			//			py::object hl = face_landmarks[j];
-			int j = 0;
-			for (py::handle hl : face_landmarks) {
-				//			py::object hwl = face_world_landmarks[j];
-
-				auto& kp = tface->keypoints[j];
-				//			tface.keypoints[j].pos = glm::vec3(py::float_(hl.attr("x")), py::float_(hl.attr("y")), py::float_(hl.attr("z")) );
-				kp.pos.x = py::float_(py::getattr(hl, "x"));
-				kp.pos.y = py::float_(py::getattr(hl, "y"));
-				kp.pos.z = py::float_(py::getattr(hl, "z"));
-
-				kp.posN = kp.pos;
-				kp.pos.x *= mOutRect.width;
-				kp.pos.y *= mOutRect.height;
-				kp.pos.x += mOutRect.x;
-				kp.pos.y += mOutRect.y;
-
-				kp.pos.z *= mOutRect.width;
-
-				//			thand.keypoints[j].posWorld = glm::vec3(py::float_(hwl.attr("x")), py::float_(hwl.attr("y")), py::float_(hwl.attr("z")) );
-							//			thand.keypoints[j].worldPos.z *= mOutRect.width;
-
-				//			kp.visibility = py::float_(hl.attr("visibility"));
-				//			kp.presence = py::float_(hl.attr("presence"));
-
-				j++;
+		// pack the landmarks into a contiguous buffer instead of looking up every coordinate
+		if( !mLandmarkPacker.packLandmarks(face_landmarks_list, mPackedLandmarks) ) {
+			ofLogError("FaceTracker::_process_landmark_results") << "unable to pack the face landmarks. " << aTimestampMicros;
+			return;
+		}
+		
+		if (mSettings.outputFaceBlendshapes) {
+			// the blend shape names do not change, so they are only requested when they are not cached
+			if( !_packBlendshapes(face_blendshapes_list) ) {
+				ofLogError("FaceTracker::_process_landmark_results") << "unable to pack the face blendshapes. " << aTimestampMicros;
+				return;
 			}
-
-			tfaces.push_back(tface);
 		}
+		
 		//py::gil_scoped_release release;
 	} catch (...) {
 		ofLogError("FaceTracker") << __FUNCTION__ << " error with gil";
@@ -418,28 +378,121 @@ void FaceTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 	}
 
 	// Release GIL while performing intensive C++ operations
-	//py::gil_scoped_release release;		
+	//py::gil_scoped_release release;
+	_apply_packed_results(aTimestampMicros);
+}
 
+//-----------------------------------------------------------------------
+void FaceTracker::_process_packed_results(std::int64_t aTimestampMicros) {
+	// cache the blend shape names by index, they are only packed when they are not cached yet
+	if( mPackedCategories.names.size() == mPackedCategories.indices.size() ) {
+		for( size_t i = 0; i < mPackedCategories.indices.size(); i++ ) {
+			int index = mPackedCategories.indices[i];
+			if( index < 0 ) {
+				continue;
+			}
+			if( index >= (int)mBlendshapeNames.size() ) {
+				mBlendshapeNames.resize(index+1);
+			}
+			mBlendshapeNames[index] = mPackedCategories.names[i];
+		}
+	}
 	
+	std::vector< std::shared_ptr<Face> > tfaces;
+	int numMarks = (int)mPackedLandmarks.getNumLists();
+	size_t landmarkOffset = 0;
+	size_t blendOffset = 0;
+	for (int i = 0; i < numMarks; i++) {
+
+		//		Face tface;
+		auto tface = std::make_shared<Face>();
+
+		if (mSettings.outputFaceBlendshapes && i < (int)mPackedCategories.getNumLists() ) {
+			int numBlends = mPackedCategories.counts[i];
+			for (int j = 0; j < numBlends; j++) {
+				int hindex = mPackedCategories.indices[blendOffset+j];
+				float hscore = mPackedCategories.scores[blendOffset+j];
+				if( hindex < 0 || hindex >= (int)mBlendshapeNames.size() ) {
+					continue;
+				}
+				//				std::cout << "index: " << hindex << " hcategory: " << hcategory << " score: " << hscore << std::endl;
+				tface->setIncomingBlendShape(mBlendshapeNames[hindex], hscore, hindex);
+			}
+			blendOffset += numBlends;
+		}
+
+		int num = mPackedLandmarks.counts[i];
+
+		tface->keypoints.assign(num, TrackedObject::Keypoint());
+
+		const float* xyz = mPackedLandmarks.xyz.data() + landmarkOffset * 3;
+		for (int j = 0; j < num; j++) {
+			auto& kp = tface->keypoints[j];
+			kp.pos.x = xyz[j*3+0];
+			kp.pos.y = xyz[j*3+1];
+			kp.pos.z = xyz[j*3+2];
+
+			kp.posN = kp.pos;
+			kp.pos.x *= mOutRect.width;
+			kp.pos.y *= mOutRect.height;
+			kp.pos.x += mOutRect.x;
+			kp.pos.y += mOutRect.y;
+
+			kp.pos.z *= mOutRect.width;
+		}
+		landmarkOffset += num;
+
+		tfaces.push_back(tface);
+	}
+
 	if( mSettings.runningMode == Tracker::MODE_LIVE_STREAM) {
 		std::lock_guard<std::mutex> lck(mMutex);
 		//		_matchFaces( tfaces, mThreadedFaces );
 		mThreadedFaces = tfaces;
+		mThreadedTimestampMicros = aTimestampMicros;
 		mHasNewThreadValues = true;
 	} else if( mSettings.runningMode == Tracker::MODE_OF_VIDEO_THREAD ) {
 		std::lock_guard<std::mutex> lck(mMutex);
 		mThreadedFaces = tfaces;
+		mThreadedTimestampMicros = aTimestampMicros;
 		mHasNewThreadValues = true;
 	} else {
+		mTimestampMicros = aTimestampMicros;
 		_matchFaces( tfaces, mFaces );
+		_trace( Trace::STAGE_MATCH_DONE, aTimestampMicros );
+	}
+}
+
+//-----------------------------------------------------------------------
+bool FaceTracker::_packBlendshapes( py::handle aBlendshapesList ) {
+	if( !mLandmarkPacker.packCategories(aBlendshapesList, mPackedCategories, mBlendshapeNames.empty()) ) {
+		return false;
+	}
+	
+	bool bNeedsNames = false;
+	for( auto& index : mPackedCategories.indices ) {
+		if( index < 0 ) {
+			return false;
+		}
+		if( index >= (int)mBlendshapeNames.size() ) {
+			bNeedsNames = true;
+			break;
+		}
 	}
+	
+	if( bNeedsNames && mPackedCategories.names.empty() ) {
+		if( !mLandmarkPacker.packCategories(aBlendshapesList, mPackedCategories, true) ) {
+			return false;
+		}
+	}
+	return true;
 }
 
 //-----------------------------------------------------------------------
 void FaceTracker::_matchFaces( std::vector<std::shared_ptr<Face>>& aIncomingFaces, std::vector< std::shared_ptr<Face>>& aFaces ) {
+	Histogram::ScopedTimer matchingTimer( mStats.matching );
 	
-	float frameRate = ofClamp(Tracker::mFpsCounter.getFps(), 1, 200);
-	int mNumFramesToDie = Tracker::mMaxTimeToMatch * frameRate;
+	int mNumFramesToDie = _getNumFramesToDie( mTimestampMicros );
 	
 	// now lets try to track the hands
 	for( auto& face : aFaces ) {
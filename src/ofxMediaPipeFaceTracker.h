@@ -23,13 +23,7 @@ public:
 		FaceSettings() {}
 		~FaceSettings() {};
 		
-		FaceSettings( const Tracker::Settings& asettings, bool aOutputFaceBlendshapes=false, bool aOutputFacialTransformationMatrices=false ) {
-			runningMode = asettings.runningMode;
-			maxNum = asettings.maxNum;
-			minDetectionConfidence = asettings.minDetectionConfidence;
-			minPresenceConfidence = asettings.minPresenceConfidence;
-			minTrackingConfidence = asettings.minTrackingConfidence;
-			filePath = asettings.filePath;
+		FaceSettings( const Tracker::Settings& asettings, bool aOutputFaceBlendshapes=false, bool aOutputFacialTransformationMatrices=false ) : Tracker::Settings(asettings) {
 			outputFaceBlendshapes = aOutputFaceBlendshapes;
 //			outputFacialTransformationMatrices = aOutputFacialTransformationMatrices;
 		}
@@ -54,9 +48,11 @@ public:
 	
 private:
 	void _update() override;
-	void _process_landmark_results( py::object& aresults, int aTimestamp) override;
+	void _process_landmark_results( py::object& aresults, std::int64_t aTimestampMicros) override;
+	void _process_packed_results( std::int64_t aTimestampMicros ) override;
 	
 	void _matchFaces( std::vector<std::shared_ptr<Face>>& aIncomingFaces, std::vector<std::shared_ptr<Face>>& aFaces );
+	bool _packBlendshapes( py::handle aBlendshapesList );
 	
 	ofParameter<bool> mBDrawIrises;
 //	ofParameter<float> mMaxDistToMatch;
@@ -67,6 +63,8 @@ private:
 	
 	std::vector< std::shared_ptr<Face> > mThreadedFaces;
 	std::vector< std::shared_ptr<Face> > mFaces;
+	// blend shape category names by index, only read from python once
+	std::vector<std::string> mBlendshapeNames;
 	
 };
 }
@@ -6,6 +6,9 @@
 //
 
 #include "ofxMediaPipeFrame.h"
+#include "ofxMediaPipeQuantizer.h"
+#include <algorithm>
+#include <cstring>
 
 using std::string;
 using std::shared_ptr;
@@ -16,6 +19,136 @@ using std::endl;
 
 using namespace ofx::MediaPipe;
 
+namespace {
+//--------------------------------------------------------------
+template<typename T>
+void appendValue( std::string& aout, const T& avalue ) {
+	aout.append( reinterpret_cast<const char*>(&avalue), sizeof(T) );
+}
+
+//--------------------------------------------------------------
+template<typename T>
+bool readValue( const char*& adata, const char* aend, T& avalue ) {
+	if( adata + sizeof(T) > aend ) {
+		return false;
+	}
+	memcpy( &avalue, adata, sizeof(T) );
+	adata += sizeof(T);
+	return true;
+}
+}
+
+//--------------------------------------------------------------
+std::string Frame::sGetStringForOscEncoding( OscEncoding aencoding ) {
+	switch( aencoding ) {
+		case OSC_ENCODING_ARGS:
+			return "args";
+		case OSC_ENCODING_FLOAT32:
+			return "float32";
+		case OSC_ENCODING_FLOAT16:
+			return "float16";
+		case OSC_ENCODING_QUANTIZED:
+			return "quantized";
+		case OSC_ENCODING_DELTA:
+			return "delta";
+		default:
+			break;
+	}
+	return "unknown";
+}
+
+//--------------------------------------------------------------
+std::string Frame::sGetStringForKeypointEncoding( KeypointEncoding aencoding ) {
+	switch( aencoding ) {
+		case KEYPOINTS_FLOAT32:
+			return "float32";
+		case KEYPOINTS_FLOAT16:
+			return "float16";
+		case KEYPOINTS_QUANTIZED:
+			return "quantized";
+		case KEYPOINTS_DELTA:
+			return "delta";
+		default:
+			break;
+	}
+	return "unknown";
+}
+
+//--------------------------------------------------------------
+size_t Frame::sGetKeypointBytes( KeypointEncoding aencoding, size_t aNumKeypoints ) {
+	size_t coordSize = (aencoding == KEYPOINTS_FLOAT32) ? sizeof(float) : sizeof(std::uint16_t);
+	return aNumKeypoints * 6 * coordSize;
+}
+
+//--------------------------------------------------------------
+void Frame::sAppendKeypoints( std::string& aout, const std::vector<TrackedObject::Keypoint>& akps, size_t aNum, KeypointEncoding aencoding ) {
+	aNum = std::min( aNum, akps.size() );
+	size_t offset = aout.size();
+	aout.resize( offset + sGetKeypointBytes(aencoding, aNum) );
+	char* dst = &aout[offset];
+	if( aencoding == KEYPOINTS_FLOAT32 ) {
+		char* posWorld = dst + aNum * 3 * sizeof(float);
+		for( size_t i = 0; i < aNum; i++ ) {
+			memcpy( dst + i * 3 * sizeof(float), &akps[i].posN.x, 3 * sizeof(float) );
+			memcpy( posWorld + i * 3 * sizeof(float), &akps[i].posWorld.x, 3 * sizeof(float) );
+		}
+		return;
+	}
+	
+	// gathered into contiguous arrays, so that the quantizer can convert them in batches
+	thread_local std::vector<float> tFloats;
+	thread_local std::vector<std::uint16_t> tValues;
+	tFloats.resize( aNum * 6 );
+	tValues.resize( aNum * 6 );
+	float* posN = tFloats.data();
+	float* posWorld = posN + aNum * 3;
+	for( size_t i = 0; i < aNum; i++ ) {
+		memcpy( posN + i * 3, &akps[i].posN.x, 3 * sizeof(float) );
+		memcpy( posWorld + i * 3, &akps[i].posWorld.x, 3 * sizeof(float) );
+	}
+	if( aencoding == KEYPOINTS_QUANTIZED ) {
+		Quantizer::sEncodeUnorm16( posN, tValues.data(), aNum * 3, sQuantizedPosNMin, sQuantizedPosNMax );
+	} else {
+		Quantizer::sEncodeHalf( posN, tValues.data(), aNum * 3 );
+	}
+	Quantizer::sEncodeHalf( posWorld, tValues.data() + aNum * 3, aNum * 3 );
+	memcpy( dst, tValues.data(), aNum * 6 * sizeof(std::uint16_t) );
+}
+
+//--------------------------------------------------------------
+void Frame::sReadKeypoints( const char* adata, size_t aNum, KeypointEncoding aencoding, std::vector<TrackedObject::Keypoint>& akps ) {
+	if( akps.size() != aNum ) {
+		akps.resize( aNum );
+	}
+	if( aencoding == KEYPOINTS_FLOAT32 ) {
+		const char* posWorld = adata + aNum * 3 * sizeof(float);
+		for( size_t i = 0; i < aNum; i++ ) {
+			memcpy( &akps[i].posN.x, adata + i * 3 * sizeof(float), 3 * sizeof(float) );
+			memcpy( &akps[i].posWorld.x, posWorld + i * 3 * sizeof(float), 3 * sizeof(float) );
+		}
+		return;
+	}
+	
+	thread_local std::vector<float> tFloats;
+	thread_local std::vector<std::uint16_t> tValues;
+	tFloats.resize( aNum * 6 );
+	tValues.resize( aNum * 6 );
+	// the data is not aligned for uint16
+	memcpy( tValues.data(), adata, aNum * 6 * sizeof(std::uint16_t) );
+	float* posN = tFloats.data();
+	float* posWorld = posN + aNum * 3;
+	if( aencoding == KEYPOINTS_QUANTIZED ) {
+		Quantizer::sDecodeUnorm16( tValues.data(), posN, aNum * 3, sQuantizedPosNMin, sQuantizedPosNMax );
+	} else {
+		Quantizer::sDecodeHalf( tValues.data(), posN, aNum * 3 );
+	}
+	Quantizer::sDecodeHalf( tValues.data() + aNum * 3, posWorld, aNum * 3 );
+	for( size_t i = 0; i < aNum; i++ ) {
+		memcpy( &akps[i].posN.x, posN + i * 3, 3 * sizeof(float) );
+		memcpy( &akps[i].posWorld.x, posWorld + i * 3, 3 * sizeof(float) );
+	}
+}
+
 //--------------------------------------------------------------
 bool Frame::setup( ofJson& aJFrame) {
 	mFaces.clear();
@@ -182,52 +315,270 @@ ofJson Frame::jsonify( const std::int64_t& atimestamp, const std::vector<std::sh
 	return jposesHeader;
 }
 
+//--------------------------------------------------------------
+void Frame::sAppendBinary( std::string& aout, const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Face>>& afaces, KeypointEncoding aencoding, DeltaCodec* acodec ) {
+	auto recordStart = _appendBinaryHeader( aout, atimestamp, TrackedObject::FACE, afaces.size(), aencoding, acodec );
+	for( const auto& face : afaces ) {
+		_appendBinaryObject( aout, face, 0, 0, &face->getBlendShapes(), aencoding, acodec );
+	}
+	_finishBinaryRecord( aout, recordStart );
+}
+
+//--------------------------------------------------------------
+void Frame::sAppendBinary( std::string& aout, const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Hand>>& ahands, KeypointEncoding aencoding, DeltaCodec* acodec ) {
+	auto recordStart = _appendBinaryHeader( aout, atimestamp, TrackedObject::HAND, ahands.size(), aencoding, acodec );
+	for( const auto& hand : ahands ) {
+		_appendBinaryObject( aout, hand, hand->index, (hand->handed == Hand::Handedness::LEFT) ? 1 : 0, nullptr, aencoding, acodec );
+	}
+	_finishBinaryRecord( aout, recordStart );
+}
+
+//--------------------------------------------------------------
+void Frame::sAppendBinary( std::string& aout, const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Pose>>& aposes, KeypointEncoding aencoding, DeltaCodec* acodec ) {
+	auto recordStart = _appendBinaryHeader( aout, atimestamp, TrackedObject::POSE, aposes.size(), aencoding, acodec );
+	for( const auto& pose : aposes ) {
+		_appendBinaryObject( aout, pose, 0, 0, nullptr, aencoding, acodec );
+	}
+	_finishBinaryRecord( aout, recordStart );
+}
+
+//--------------------------------------------------------------
+bool Frame::sReadBinaryHeader( const char* adata, size_t anumBytes, std::uint32_t& aRecordBytes, std::int64_t& atimestamp, TrackedObject::TrackedObjectType& atype ) {
+	const char* end = adata + anumBytes;
+	std::uint8_t type = 0;
+	if( !readValue(adata, end, aRecordBytes) || !readValue(adata, end, atimestamp) || !readValue(adata, end, type) ) {
+		return false;
+	}
+	atype = (TrackedObject::TrackedObjectType)type;
+	return aRecordBytes >= sBinaryRecordHeaderSize;
+}
+
+//--------------------------------------------------------------
+bool Frame::sReadBinaryKeypointEncoding( const char* adata, size_t anumBytes, KeypointEncoding& aencoding ) {
+	// the keypoint encoding follows the type
+	size_t offset = sBinaryRecordHeaderSize - sizeof(std::uint16_t) - sizeof(std::uint8_t);
+	if( anumBytes < sBinaryRecordHeaderSize ) {
+		return false;
+	}
+	aencoding = (KeypointEncoding)(std::uint8_t)adata[offset];
+	return true;
+}
+
+//--------------------------------------------------------------
+bool Frame::setup( const char* adata, size_t anumBytes, const std::map<int, std::string>& aBlendShapeNames, DeltaCodec* adecoder ) {
+	std::uint32_t recordBytes = 0;
+	if( !sReadBinaryHeader(adata, anumBytes, recordBytes, timestamp, mType) || recordBytes > anumBytes ) {
+		ofLogWarning("ofx::MediaPipe::Frame::setup") << "binary record is cut off";
+		mFaces.clear();
+		mPoses.clear();
+		mHands.clear();
+		return false;
+	}
+	// The objects of the previous record are reused when this frame is their only owner,
+	// so decoding into a recycled frame does not allocate, see RecordingReader::getFrame.
+	if( mType != TrackedObject::FACE ) mFaces.clear();
+	if( mType != TrackedObject::HAND ) mHands.clear();
+	if( mType != TrackedObject::POSE ) mPoses.clear();
+	auto reuse = []( auto& aobjs, size_t aindex, bool& abReused ) {
+		using T = typename std::decay_t<decltype(aobjs)>::value_type::element_type;
+		abReused = aindex < aobjs.size() && aobjs[aindex].use_count() == 1;
+		if( !abReused ) {
+			auto obj = make_shared<T>();
+			if( aindex < aobjs.size() ) {
+				aobjs[aindex] = obj;
+			} else {
+				aobjs.push_back(obj);
+			}
+		}
+		return aobjs[aindex];
+	};
+	const char* end = adata + recordBytes;
+	// the keypoint encoding and the number of objects end the header
+	const char* data = adata + sBinaryRecordHeaderSize - sizeof(std::uint16_t) - sizeof(std::uint8_t);
+	std::uint8_t encoding = 0;
+	std::uint16_t numObjects = 0;
+	readValue( data, end, encoding );
+	readValue( data, end, numObjects );
+	if( encoding > KEYPOINTS_DELTA ) {
+		ofLogWarning("ofx::MediaPipe::Frame::setup") << "unknown keypoint encoding " << (int)encoding;
+		return false;
+	}
+	bool bDelta = (encoding == KEYPOINTS_DELTA);
+	if( bDelta ) {
+		if( !adecoder ) {
+			ofLogWarning("ofx::MediaPipe::Frame::setup") << "delta encoded records need a DeltaCodec";
+			return false;
+		}
+		if( !adecoder->readFrameHeader(data, end) ) {
+			return false;
+		}
+	}
+	
+	for( std::uint16_t i = 0; i < numObjects; i++ ) {
+		std::int32_t tid = 0, index = 0;
+		std::uint8_t handed = 0, reserved8 = 0;
+		std::uint16_t numKps = 0, numBlendShapes = 0, reserved16 = 0;
+		if( !readValue(data, end, tid) || !readValue(data, end, index) || !readValue(data, end, handed) || !readValue(data, end, reserved8)
+		   || !readValue(data, end, numKps) || !readValue(data, end, numBlendShapes) || !readValue(data, end, reserved16) ) {
+			return false;
+		}
+		size_t kpBytes = bDelta ? 0 : sGetKeypointBytes( (KeypointEncoding)encoding, numKps );
+		size_t blendBytes = (size_t)numBlendShapes * (2 * sizeof(std::uint16_t) + sizeof(float));
+		if( data + kpBytes + blendBytes > end ) {
+			ofLogWarning("ofx::MediaPipe::Frame::setup") << "binary object is cut off";
+			return false;
+		}
+		
+		std::shared_ptr<TrackedObject> tobj;
+		std::shared_ptr<Face> face;
+		bool bReused = false;
+		if( mType == TrackedObject::FACE ) {
+			face = reuse( mFaces, i, bReused );
+			if( bReused ) {
+				for( auto& bshape : face->getIncomingBlendShapes() ) {
+					bshape.score = 0.f;
+				}
+			}
+			tobj = face;
+		} else if( mType == TrackedObject::HAND ) {
+			auto hand = reuse( mHands, i, bReused );
+			hand->index = index;
+			hand->handed = (handed == 1) ? Hand::Handedness::LEFT : Hand::Handedness::RIGHT;
+			tobj = hand;
+		} else if( mType == TrackedObject::POSE ) {
+			tobj = reuse( mPoses, i, bReused );
+		} else {
+			ofLogWarning("ofx::MediaPipe::Frame::setup") << " unable to process type: " << (int)mType;
+			return false;
+		}
+		
+		tobj->ID = tid;
+		if( bDelta ) {
+			bool bDecoded = false;
+			if( !adecoder->readKeypoints(data, end, tid, numKps, tobj->keypoints, bDecoded) || !bDecoded || data + blendBytes > end ) {
+				// the records of a recording are decoded in order, starting with a keyframe
+				ofLogWarning("ofx::MediaPipe::Frame::setup") << "unable to decode the delta encoded keypoints of object " << tid;
+				return false;
+			}
+		} else {
+			sReadKeypoints( data, numKps, (KeypointEncoding)encoding, tobj->keypoints );
+			data += kpBytes;
+		}
+		
+		for( std::uint16_t b = 0; b < numBlendShapes; b++ ) {
+			std::uint16_t bindex = 0, breserved = 0;
+			float score = 0.f;
+			readValue( data, end, bindex );
+			readValue( data, end, breserved );
+			readValue( data, end, score );
+			if( !face ) {
+				continue;
+			}
+			auto& incoming = face->getIncomingBlendShapes();
+			if( bReused && bindex < incoming.size() && incoming[bindex].index == (int)bindex ) {
+				// the name was set by the previous record
+				incoming[bindex].score = score;
+				continue;
+			}
+			auto nameIt = aBlendShapeNames.find( bindex );
+			if( nameIt != aBlendShapeNames.end() ) {
+				face->setIncomingBlendShape( nameIt->second, score, bindex );
+			} else {
+				// the names are missing when the recording was not finished,
+				// media pipe indices start with _neutral which is -1 in Face::BlendShapeType
+				face->setIncomingBlendShape( Face::sGetBlendShapeAsString((Face::BlendShapeType)((int)bindex-1)), score, bindex );
+			}
+		}
+	}
+	// objects left from a previous record with more objects
+	if( mType == TrackedObject::FACE ) mFaces.resize( std::min(mFaces.size(), (size_t)numObjects) );
+	if( mType == TrackedObject::HAND ) mHands.resize( std::min(mHands.size(), (size_t)numObjects) );
+	if( mType == TrackedObject::POSE ) mPoses.resize( std::min(mPoses.size(), (size_t)numObjects) );
+	return numObjects > 0;
+}
+
 #if defined(OF_ADDON_HAS_OFX_OSC)
 //--------------------------------------------------------------
-ofxOscMessage Frame::getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface ) {
+ofxOscMessage Frame::getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface, const std::int64_t& aTimestampMicros ) {
 	ofxOscMessage m;
 	m.setAddress("/ofxmp/faces");
-	_setupOscMessage( m, aFrameNum, aface, false );
+	_setupOscMessage( m, aFrameNum, aTimestampMicros, aface, false );
 	return m;
 }
 
 //--------------------------------------------------------------
-ofxOscMessage Frame::getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand ) {
+ofxOscMessage Frame::getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand, const std::int64_t& aTimestampMicros ) {
 	ofxOscMessage m;
 	m.setAddress("/ofxmp/hands");
-	_setupOscMessage( m, aFrameNum, ahand, false );
+	_setupOscMessage( m, aFrameNum, aTimestampMicros, ahand, false );
 	return m;
 }
 
 //--------------------------------------------------------------
-ofxOscMessage Frame::getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose ) {
+ofxOscMessage Frame::getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose, const std::int64_t& aTimestampMicros ) {
 	ofxOscMessage m;
 	m.setAddress("/ofxmp/poses");
-	_setupOscMessage( m, aFrameNum, apose, false );
+	_setupOscMessage( m, aFrameNum, aTimestampMicros, apose, false );
 	return m;
 }
 
 //--------------------------------------------------------------
-ofxOscMessage Frame::getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface ) {
+ofxOscMessage Frame::getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface, const std::int64_t& aTimestampMicros ) {
 	ofxOscMessage m;
 	m.setAddress("/ofxmp/facesW");
-	_setupOscMessage( m, aFrameNum, aface, true );
+	_setupOscMessage( m, aFrameNum, aTimestampMicros, aface, true );
 	return m;
 }
 
 //--------------------------------------------------------------
-ofxOscMessage Frame::getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand ) {
+ofxOscMessage Frame::getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand, const std::int64_t& aTimestampMicros ) {
 	ofxOscMessage m;
 	m.setAddress("/ofxmp/handsW");
-	_setupOscMessage( m, aFrameNum, ahand, true );
+	_setupOscMessage( m, aFrameNum, aTimestampMicros, ahand, true );
 	return m;
 }
 
 //--------------------------------------------------------------
-ofxOscMessage Frame::getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose ) {
+ofxOscMessage Frame::getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose, const std::int64_t& aTimestampMicros ) {
 	ofxOscMessage m;
 	m.setAddress("/ofxmp/posesW");
-	_setupOscMessage( m, aFrameNum, apose, true );
+	_setupOscMessage( m, aFrameNum, aTimestampMicros, apose, true );
+	return m;
+}
+
+//--------------------------------------------------------------
+ofxOscMessage Frame::getOscMessagePacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Face>>& afaces, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec ) {
+	ofxOscMessage m;
+	m.setAddress("/ofxmp/facesP");
+	_appendOscPackedHeader( TrackedObject::FACE, afaces.size(), aencoding, acodec );
+	for( const auto& face : afaces ) {
+		_appendOscPackedObject( face, aencoding, acodec );
+	}
+	_setupOscMessagePacked( m, aFrameNum, aTimestampMicros );
+	return m;
+}
+
+//--------------------------------------------------------------
+ofxOscMessage Frame::getOscMessagePacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Hand>>& ahands, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec ) {
+	ofxOscMessage m;
+	m.setAddress("/ofxmp/handsP");
+	_appendOscPackedHeader( TrackedObject::HAND, ahands.size(), aencoding, acodec );
+	for( const auto& hand : ahands ) {
+		_appendOscPackedObject( hand, aencoding, acodec );
+	}
+	_setupOscMessagePacked( m, aFrameNum, aTimestampMicros );
+	return m;
+}
+
+//--------------------------------------------------------------
+ofxOscMessage Frame::getOscMessagePacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Pose>>& aposes, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec ) {
+	ofxOscMessage m;
+	m.setAddress("/ofxmp/posesP");
+	_appendOscPackedHeader( TrackedObject::POSE, aposes.size(), aencoding, acodec );
+	for( const auto& pose : aposes ) {
+		_appendOscPackedObject( pose, aencoding, acodec );
+	}
+	_setupOscMessagePacked( m, aFrameNum, aTimestampMicros );
 	return m;
 }
 
@@ -242,14 +593,21 @@ bool Frame::setup( ofxOscMessage& am, std::shared_ptr<TrackedObject>& aobject, b
 	
 	auto numArgs = am.getNumArgs();
 	
-	auto numKPS = (numArgs-2)/3;
+	// the capture timestamp follows the keypoints, senders before it was added do not send it
+	std::size_t firstKpArg = 2;
+	if( numArgs > 2 && am.getArgType(numArgs-1) == OFXOSC_TYPE_INT64 ) {
+		aobject->trackingData.timestampMicros = am.getArgAsInt64(numArgs-1);
+		numArgs--;
+	}
+	
+	auto numKPS = (numArgs-firstKpArg)/3;
 	if( aobject->keypoints.size() != numKPS ) {
 		ofLogVerbose("ofx::MediaPipe::Frame") << "resizing keypoints to " << numKPS;
 		aobject->keypoints.resize(numKPS);
 	}
 	
 	int kpIndex = 0;
-	for( std::size_t sindex = 2; sindex < numArgs; sindex += 3 ) {
+	for( std::size_t sindex = firstKpArg; sindex < numArgs; sindex += 3 ) {
 		float fx = am.getArgAsFloat(sindex+0);
 		float fy = am.getArgAsFloat(sindex+1);
 		float fz = am.getArgAsFloat(sindex+2);
@@ -269,6 +627,106 @@ bool Frame::setup( ofxOscMessage& am, std::shared_ptr<TrackedObject>& aobject, b
 	return true;
 }
 
+//--------------------------------------------------------------
+void Frame::getOscMessagesPacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Face>>& afaces, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages ) {
+	_appendOscPackedHeader( TrackedObject::FACE, afaces.size(), aencoding, acodec );
+	for( const auto& face : afaces ) {
+		_appendOscPackedObject( face, aencoding, acodec );
+	}
+	_splitOscMessagePacked( "/ofxmp/facesP", aFrameNum, aTimestampMicros, aMaxBlobBytes, aOutMessages );
+}
+
+//--------------------------------------------------------------
+void Frame::getOscMessagesPacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Hand>>& ahands, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages ) {
+	_appendOscPackedHeader( TrackedObject::HAND, ahands.size(), aencoding, acodec );
+	for( const auto& hand : ahands ) {
+		_appendOscPackedObject( hand, aencoding, acodec );
+	}
+	_splitOscMessagePacked( "/ofxmp/handsP", aFrameNum, aTimestampMicros, aMaxBlobBytes, aOutMessages );
+}
+
+//--------------------------------------------------------------
+void Frame::getOscMessagesPacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Pose>>& aposes, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages ) {
+	_appendOscPackedHeader( TrackedObject::POSE, aposes.size(), aencoding, acodec );
+	for( const auto& pose : aposes ) {
+		_appendOscPackedObject( pose, aencoding, acodec );
+	}
+	_splitOscMessagePacked( "/ofxmp/posesP", aFrameNum, aTimestampMicros, aMaxBlobBytes, aOutMessages );
+}
+
+//--------------------------------------------------------------
+bool Frame::setup( ofxOscMessage& am, TrackedObject::TrackedObjectType atype,
+				  const std::function<std::shared_ptr<TrackedObject>(std::int32_t aID, std::int64_t aFrameNum)>& aGetObject,
+				  std::vector<std::shared_ptr<TrackedObject>>& aOutObjects, DeltaCodec* adecoder ) {
+	if( am.getNumArgs() < 3 || am.getArgType(2) != OFXOSC_TYPE_BLOB ) {
+		return false;
+	}
+	std::int64_t frame = am.getArgAsInt64(0);
+	std::int64_t timestampMicros = am.getArgAsInt64(1);
+	auto blob = am.getArgAsBlob(2);
+	
+	const char* data = blob.getData();
+	const char* end = data + blob.size();
+	std::uint8_t encoding = 0, type = 0;
+	std::uint16_t numObjects = 0;
+	if( !readValue(data, end, encoding) || !readValue(data, end, type) || !readValue(data, end, numObjects) ) {
+		return false;
+	}
+	if( type != (std::uint8_t)atype || encoding == OSC_ENCODING_ARGS || encoding > OSC_ENCODING_DELTA ) {
+		ofLogWarning("ofx::MediaPipe::Frame::setup") << "unable to decode packed osc message, type: " << (int)type << " encoding: " << (int)encoding;
+		return false;
+	}
+	auto kpEncoding = _getKeypointEncoding( (OscEncoding)encoding );
+	bool bDelta = (encoding == OSC_ENCODING_DELTA);
+	if( bDelta ) {
+		if( !adecoder ) {
+			ofLogWarning("ofx::MediaPipe::Frame::setup") << "delta encoded osc messages need a DeltaCodec";
+			return false;
+		}
+		if( !adecoder->readFrameHeader(data, end) ) {
+			return false;
+		}
+	}
+	
+	for( std::uint16_t i = 0; i < numObjects; i++ ) {
+		std::int32_t tid = 0;
+		std::uint16_t numKps = 0, reserved16 = 0;
+		if( !readValue(data, end, tid) || !readValue(data, end, numKps) || !readValue(data, end, reserved16) ) {
+			return false;
+		}
+		if( bDelta ) {
+			// decoded even when the object is skipped, the next frame depends on it
+			bool bDecoded = false;
+			if( !adecoder->readKeypoints(data, end, tid, numKps, mOscDeltaKeypoints, bDecoded) ) {
+				ofLogWarning("ofx::MediaPipe::Frame::setup") << "delta encoded osc object is cut off";
+				return false;
+			}
+			if( !bDecoded ) {
+				continue;
+			}
+			if( auto tobj = aGetObject(tid, frame) ) {
+				tobj->trackingData.timestampMicros = timestampMicros;
+				std::swap( tobj->keypoints, mOscDeltaKeypoints );
+				aOutObjects.push_back( tobj );
+			}
+			continue;
+		}
+		size_t kpBytes = sGetKeypointBytes( kpEncoding, numKps );
+		if( data + kpBytes > end ) {
+			ofLogWarning("ofx::MediaPipe::Frame::setup") << "packed osc object is cut off";
+			return false;
+		}
+		auto tobj = aGetObject( tid, frame );
+		if( tobj ) {
+			tobj->trackingData.timestampMicros = timestampMicros;
+			sReadKeypoints( data, numKps, kpEncoding, tobj->keypoints );
+			aOutObjects.push_back( tobj );
+		}
+		data += kpBytes;
+	}
+	return true;
+}
+
 #endif
 
 //--------------------------------------------------------------
@@ -317,9 +775,60 @@ ofJson Frame::_getJsonFromKeypoints( const std::shared_ptr<TrackedObject>& aobje
 	return jkeyObj;
 }
 
+//--------------------------------------------------------------
+size_t Frame::_appendBinaryHeader( std::string& aout, const std::int64_t& atimestamp, TrackedObject::TrackedObjectType atype, size_t aNumObjects, KeypointEncoding& aencoding, DeltaCodec* acodec ) {
+	if( aencoding == KEYPOINTS_DELTA && !acodec ) {
+		ofLogWarning("ofx::MediaPipe::Frame") << "delta encoding needs a DeltaCodec, writing quantized keypoints";
+		aencoding = KEYPOINTS_QUANTIZED;
+	}
+	size_t recordStart = aout.size();
+	appendValue( aout, (std::uint32_t)0 ); // patched in _finishBinaryRecord
+	appendValue( aout, atimestamp );
+	appendValue( aout, (std::uint8_t)atype );
+	appendValue( aout, (std::uint8_t)aencoding );
+	appendValue( aout, (std::uint16_t)std::min(aNumObjects, (size_t)UINT16_MAX) );
+	if( aencoding == KEYPOINTS_DELTA ) {
+		acodec->appendFrameHeader( aout );
+	}
+	return recordStart;
+}
+
+//--------------------------------------------------------------
+void Frame::_appendBinaryObject( std::string& aout, const std::shared_ptr<TrackedObject>& aobject, int aindex, std::uint8_t ahanded, const std::vector<Face::BlendShape>* aBlendShapes, KeypointEncoding aencoding, DeltaCodec* acodec ) {
+	auto numKps = std::min( aobject->keypoints.size(), (size_t)UINT16_MAX );
+	auto numBlendShapes = aBlendShapes ? std::min( aBlendShapes->size(), (size_t)UINT16_MAX ) : 0;
+	appendValue( aout, (std::int32_t)aobject->ID );
+	appendValue( aout, (std::int32_t)aindex );
+	appendValue( aout, ahanded );
+	appendValue( aout, (std::uint8_t)0 );
+	appendValue( aout, (std::uint16_t)numKps );
+	appendValue( aout, (std::uint16_t)numBlendShapes );
+	appendValue( aout, (std::uint16_t)0 );
+	
+	// the keypoints are written as two contiguous arrays
+	if( aencoding == KEYPOINTS_DELTA ) {
+		acodec->appendKeypoints( aout, aobject->ID, aobject->keypoints, numKps );
+	} else {
+		sAppendKeypoints( aout, aobject->keypoints, numKps, aencoding );
+	}
+	
+	for( size_t i = 0; i < numBlendShapes; i++ ) {
+		const auto& bshape = (*aBlendShapes)[i];
+		appendValue( aout, (std::uint16_t)std::max(0, bshape.index) );
+		appendValue( aout, (std::uint16_t)0 );
+		appendValue( aout, bshape.score );
+	}
+}
+
+//--------------------------------------------------------------
+void Frame::_finishBinaryRecord( std::string& aout, size_t aRecordStart ) {
+	auto numBytes = (std::uint32_t)(aout.size() - aRecordStart);
+	memcpy( &aout[aRecordStart], &numBytes, sizeof(numBytes) );
+}
+
 #if defined(OF_ADDON_HAS_OFX_OSC)
 //--------------------------------------------------------------
-bool Frame::_setupOscMessage( ofxOscMessage& am, const std::uint64_t& aFrameNum, const std::shared_ptr<TrackedObject>& aobject, bool abWorld ) {
+bool Frame::_setupOscMessage( ofxOscMessage& am, const std::uint64_t& aFrameNum, const std::int64_t& aTimestampMicros, const std::shared_ptr<TrackedObject>& aobject, bool abWorld ) {
 	
 	am.addInt64Arg( (std::int64_t) aFrameNum );
 	am.addInt32Arg( (std::int32_t)aobject->ID );
@@ -337,9 +846,100 @@ bool Frame::_setupOscMessage( ofxOscMessage& am, const std::uint64_t& aFrameNum,
 				am.addFloatArg(kp.posN.z);
 			}
 		}
-		return true;
 	}
-	return false;
+	// after the keypoints, receivers that do not know about it read (numArgs-2)/3 keypoints and skip it
+	am.addInt64Arg( aTimestampMicros );
+	return aobject->keypoints.size() > 0;
+}
+
+//--------------------------------------------------------------
+void Frame::_setupOscMessagePacked( ofxOscMessage& am, const std::uint64_t& aFrameNum, const std::int64_t& aTimestampMicros ) {
+	am.addInt64Arg( (std::int64_t)aFrameNum );
+	am.addInt64Arg( aTimestampMicros );
+	am.addBlobArg( ofBuffer(mOscPackedBuffer.data(), mOscPackedBuffer.size()) );
+}
+
+//--------------------------------------------------------------
+void Frame::_appendOscPackedHeader( TrackedObject::TrackedObjectType atype, size_t aNumObjects, OscEncoding& aencoding, DeltaCodec* acodec ) {
+	if( aencoding == OSC_ENCODING_DELTA && !acodec ) {
+		ofLogWarning("ofx::MediaPipe::Frame") << "delta encoding needs a DeltaCodec, sending quantized keypoints";
+		aencoding = OSC_ENCODING_QUANTIZED;
+	}
+	mOscPackedBuffer.clear();
+	appendValue( mOscPackedBuffer, (std::uint8_t)aencoding );
+	appendValue( mOscPackedBuffer, (std::uint8_t)atype );
+	appendValue( mOscPackedBuffer, (std::uint16_t)std::min(aNumObjects, (size_t)UINT16_MAX) );
+	if( aencoding == OSC_ENCODING_DELTA ) {
+		acodec->appendFrameHeader( mOscPackedBuffer );
+	}
+	mOscPackedHeaderSize = mOscPackedBuffer.size();
+	mOscPackedObjectOffsets.clear();
+}
+
+//--------------------------------------------------------------
+void Frame::_appendOscPackedObject( const std::shared_ptr<TrackedObject>& aobject, OscEncoding aencoding, DeltaCodec* acodec ) {
+	auto numKps = std::min( aobject->keypoints.size(), (size_t)UINT16_MAX );
+	mOscPackedObjectOffsets.push_back( mOscPackedBuffer.size() );
+	appendValue( mOscPackedBuffer, (std::int32_t)aobject->ID );
+	appendValue( mOscPackedBuffer, (std::uint16_t)numKps );
+	appendValue( mOscPackedBuffer, (std::uint16_t)0 );
+	
+	if( aencoding == OSC_ENCODING_DELTA ) {
+		acodec->appendKeypoints( mOscPackedBuffer, aobject->ID, aobject->keypoints, numKps );
+	} else {
+		sAppendKeypoints( mOscPackedBuffer, aobject->keypoints, numKps, _getKeypointEncoding(aencoding) );
+	}
+}
+
+//--------------------------------------------------------------
+void Frame::_splitOscMessagePacked( const std::string& aAddress, const std::uint64_t& aFrameNum, const std::int64_t& aTimestampMicros, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages ) {
+	aOutMessages.clear();
+	size_t numObjects = mOscPackedObjectOffsets.size();
+	if( mOscPackedBuffer.size() <= aMaxBlobBytes || numObjects < 2 ) {
+		aOutMessages.emplace_back();
+		aOutMessages.back().setAddress( aAddress );
+		_setupOscMessagePacked( aOutMessages.back(), aFrameNum, aTimestampMicros );
+		return;
+	}
+	
+	auto getObjectEnd = [&]( size_t aindex ) {
+		return aindex + 1 < numObjects ? mOscPackedObjectOffsets[aindex+1] : mOscPackedBuffer.size();
+	};
+	size_t start = 0;
+	while( start < numObjects ) {
+		// at least one object, even when it is larger than aMaxBlobBytes
+		size_t end = start + 1;
+		while( end < numObjects && mOscPackedHeaderSize + getObjectEnd(end) - mOscPackedObjectOffsets[start] <= aMaxBlobBytes ) {
+			end++;
+		}
+		size_t objectsStart = mOscPackedObjectOffsets[start];
+		mOscPackedSplitBuffer.assign( mOscPackedBuffer, 0, mOscPackedHeaderSize );
+		mOscPackedSplitBuffer.append( mOscPackedBuffer, objectsStart, getObjectEnd(end-1) - objectsStart );
+		// the number of objects follows the encoding and the type
+		auto numSplitObjects = (std::uint16_t)(end - start);
+		memcpy( &mOscPackedSplitBuffer[2], &numSplitObjects, sizeof(numSplitObjects) );
+		
+		ofxOscMessage m;
+		m.setAddress( aAddress );
+		m.addInt64Arg( (std::int64_t)aFrameNum );
+		m.addInt64Arg( aTimestampMicros );
+		m.addBlobArg( ofBuffer(mOscPackedSplitBuffer.data(), mOscPackedSplitBuffer.size()) );
+		aOutMessages.push_back( m );
+		start = end;
+	}
 }
-#endif
 
+//--------------------------------------------------------------
+Frame::KeypointEncoding Frame::_getKeypointEncoding( OscEncoding aencoding ) {
+	if( aencoding == OSC_ENCODING_FLOAT16 ) {
+		return KEYPOINTS_FLOAT16;
+	}
+	if( aencoding == OSC_ENCODING_QUANTIZED ) {
+		return KEYPOINTS_QUANTIZED;
+	}
+	if( aencoding == OSC_ENCODING_DELTA ) {
+		return KEYPOINTS_DELTA;
+	}
+	return KEYPOINTS_FLOAT32;
+}
+#endif
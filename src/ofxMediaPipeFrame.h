@@ -14,6 +14,9 @@
 #include "ofxMediaPipeTracker.h"
 #endif
 #include "ofJson.h"
+#include "ofxMediaPipeDeltaCodec.h"
+#include <functional>
+#include <map>
 
 #if defined(OF_ADDON_HAS_OFX_OSC)
 #include "ofxOsc.h"
@@ -22,6 +25,46 @@
 namespace ofx::MediaPipe {
 class Frame {
 public:
+	// How the OscSender writes the keypoints.
+	// ARGS sends two messages per object with a float argument per coordinate.
+	// The packed encodings send one message per frame and type with every object in a single blob,
+	// FLOAT16 halves the size again, normalized positions stay within 1 px of a 1920 wide video.
+	// QUANTIZED is the size of FLOAT16 with a smaller error for the normalized positions, see KEYPOINTS_QUANTIZED.
+	// DELTA sends the difference to the previous frame with periodic keyframes, see DeltaCodec.
+	enum OscEncoding {
+		OSC_ENCODING_ARGS=0,
+		OSC_ENCODING_FLOAT32,
+		OSC_ENCODING_FLOAT16,
+		OSC_ENCODING_QUANTIZED,
+		OSC_ENCODING_DELTA
+	};
+	
+	static std::string sGetStringForOscEncoding( OscEncoding aencoding );
+	
+	// How the binary formats store the keypoints, posN[numKeypoints*3] followed by posWorld[numKeypoints*3].
+	// FLOAT16 stores both as half floats.
+	// QUANTIZED stores posN as uint16 fixed point over sQuantizedPosNMin - sQuantizedPosNMax, the error is at most 2.3e-5,
+	// ie. 0.05 px of a 1920 wide video, values outside of the range are clamped. posWorld is stored as half floats,
+	// the relative error is at most 2^-11, ie. 0.25 mm for coordinates within a meter.
+	// DELTA stores the difference to the previous record of the same type, written and read with a DeltaCodec.
+	// The record starts with the DeltaCodec frame header and the keypoints of each object have a variable size.
+	enum KeypointEncoding {
+		KEYPOINTS_FLOAT32=0,
+		KEYPOINTS_FLOAT16,
+		KEYPOINTS_QUANTIZED,
+		KEYPOINTS_DELTA
+	};
+	static constexpr float sQuantizedPosNMin = -1.f;
+	static constexpr float sQuantizedPosNMax = 2.f;
+	
+	static std::string sGetStringForKeypointEncoding( KeypointEncoding aencoding );
+	// not known up front for KEYPOINTS_DELTA
+	static size_t sGetKeypointBytes( KeypointEncoding aencoding, size_t aNumKeypoints );
+	// appends posN and posWorld of the first aNum keypoints, converted in batches with the Quantizer.
+	// KEYPOINTS_DELTA needs a DeltaCodec, see sAppendBinary.
+	static void sAppendKeypoints( std::string& aout, const std::vector<TrackedObject::Keypoint>& akps, size_t aNum, KeypointEncoding aencoding );
+	// adata has to hold sGetKeypointBytes( aencoding, aNum ) bytes, akps is resized to aNum
+	static void sReadKeypoints( const char* adata, size_t aNum, KeypointEncoding aencoding, std::vector<TrackedObject::Keypoint>& akps );
 	
 	bool setup(ofJson& aJFrame );
 	
@@ -29,16 +72,58 @@ public:
 	ofJson jsonify(const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Hand>>& ahands );
 	ofJson jsonify(const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Pose>>& aposes );
 	
+	// Binary frame records of .mpbin recordings, in the byte order of the machine that recorded them, ie. little endian on x86 and arm64.
+	// record: u32 numBytes, i64 timestamp, u8 type, u8 keypoint encoding, u16 numObjects, objects
+	//         KEYPOINTS_DELTA records have the DeltaCodec frame header in front of the objects.
+	// object: i32 ID, i32 index, u8 handed, u8 reserved, u16 numKeypoints, u16 numBlendShapes, u16 reserved,
+	//         keypoints, see sAppendKeypoints, (u16 index, u16 reserved, f32 score)[numBlendShapes]
+	// The blend shape names are stored once in the recording, see RecordingReader.
+	static const size_t sBinaryRecordHeaderSize = 16;
+	// KEYPOINTS_DELTA needs a DeltaCodec for the type, that was used for the records before. Without one QUANTIZED is written.
+	static void sAppendBinary( std::string& aout, const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Face>>& afaces, KeypointEncoding aencoding=KEYPOINTS_FLOAT32, DeltaCodec* acodec=nullptr );
+	static void sAppendBinary( std::string& aout, const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Hand>>& ahands, KeypointEncoding aencoding=KEYPOINTS_FLOAT32, DeltaCodec* acodec=nullptr );
+	static void sAppendBinary( std::string& aout, const std::int64_t& atimestamp, const std::vector<std::shared_ptr<Pose>>& aposes, KeypointEncoding aencoding=KEYPOINTS_FLOAT32, DeltaCodec* acodec=nullptr );
+	// reads the size, timestamp and type of a record without decoding it, returns false if the record is cut off
+	static bool sReadBinaryHeader( const char* adata, size_t anumBytes, std::uint32_t& aRecordBytes, std::int64_t& atimestamp, TrackedObject::TrackedObjectType& atype );
+	// reads the keypoint encoding of a record, returns false if the record is cut off
+	static bool sReadBinaryKeypointEncoding( const char* adata, size_t anumBytes, KeypointEncoding& aencoding );
+	// aBlendShapeNames maps the blend shape index to the category name.
+	// KEYPOINTS_DELTA records need the DeltaCodec that decoded the records of the type before this one.
+	bool setup( const char* adata, size_t anumBytes, const std::map<int, std::string>& aBlendShapeNames, DeltaCodec* adecoder=nullptr );
+	
 #if defined(OF_ADDON_HAS_OFX_OSC)
-	ofxOscMessage getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface );
-	ofxOscMessage getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand );
-	ofxOscMessage getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose );
+	// args: int64 frame, int32 ID, float x y z per keypoint, int64 capture timestamp in microseconds
+	ofxOscMessage getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface, const std::int64_t& aTimestampMicros=0 );
+	ofxOscMessage getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand, const std::int64_t& aTimestampMicros=0 );
+	ofxOscMessage getOscMessage( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose, const std::int64_t& aTimestampMicros=0 );
 	
-	ofxOscMessage getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface );
-	ofxOscMessage getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand );
-	ofxOscMessage getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose );
+	ofxOscMessage getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Face> aface, const std::int64_t& aTimestampMicros=0 );
+	ofxOscMessage getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Hand> ahand, const std::int64_t& aTimestampMicros=0 );
+	ofxOscMessage getOscMessageWorld( const std::uint64_t& aFrameNum, std::shared_ptr<Pose> apose, const std::int64_t& aTimestampMicros=0 );
 	
 	bool setup( ofxOscMessage& am, std::shared_ptr<TrackedObject>& aobject, bool abWorld);
+	
+	// Packed messages, address /ofxmp/facesP, /ofxmp/handsP or /ofxmp/posesP.
+	// args: int64 frame, int64 capture timestamp in microseconds, blob
+	// blob, in the byte order of the sender, ie. little endian on x86 and arm64: u8 encoding, u8 type, u16 numObjects, objects
+	//       OSC_ENCODING_DELTA has the DeltaCodec frame header in front of the objects.
+	// object: i32 ID, u16 numKeypoints, u16 reserved, keypoints, see sAppendKeypoints
+	// OSC_ENCODING_DELTA needs a DeltaCodec per type that is used for every message of the type.
+	ofxOscMessage getOscMessagePacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Face>>& afaces, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec=nullptr );
+	ofxOscMessage getOscMessagePacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Hand>>& ahands, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec=nullptr );
+	ofxOscMessage getOscMessagePacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Pose>>& aposes, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec=nullptr );
+	// Like getOscMessagePacked, but splits the objects over messages with blobs of at most aMaxBlobBytes.
+	// Each message has the header of the frame and at least one object, so it can be decoded on its own.
+	void getOscMessagesPacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Face>>& afaces, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages );
+	void getOscMessagesPacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Hand>>& ahands, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages );
+	void getOscMessagesPacked( const std::uint64_t& aFrameNum, const std::vector<std::shared_ptr<Pose>>& aposes, const std::int64_t& aTimestampMicros, OscEncoding aencoding, DeltaCodec* acodec, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages );
+	
+	// Decodes a packed message. aGetObject returns the object to write the keypoints of an ID into,
+	// or nullptr to skip it. The decoded objects are added to aOutObjects.
+	// OSC_ENCODING_DELTA messages need a DeltaCodec per type, aGetObject is only called for the objects it could decode.
+	bool setup( ofxOscMessage& am, TrackedObject::TrackedObjectType atype,
+			   const std::function<std::shared_ptr<TrackedObject>(std::int32_t aID, std::int64_t aFrameNum)>& aGetObject,
+			   std::vector<std::shared_ptr<TrackedObject>>& aOutObjects, DeltaCodec* adecoder=nullptr );
 #endif
 	
 	const std::int64_t& getTimestamp() { return timestamp;}
@@ -52,8 +137,24 @@ public:
 protected:
 	void _serialize( ofJson& ajobj, const std::shared_ptr<TrackedObject>& aobject );
 	ofJson _getJsonFromKeypoints( const std::shared_ptr<TrackedObject>& aobject );
+	static size_t _appendBinaryHeader( std::string& aout, const std::int64_t& atimestamp, TrackedObject::TrackedObjectType atype, size_t aNumObjects, KeypointEncoding& aencoding, DeltaCodec* acodec );
+	static void _appendBinaryObject( std::string& aout, const std::shared_ptr<TrackedObject>& aobject, int aindex, std::uint8_t ahanded, const std::vector<Face::BlendShape>* aBlendShapes, KeypointEncoding aencoding, DeltaCodec* acodec );
+	static void _finishBinaryRecord( std::string& aout, size_t aRecordStart );
 #if defined(OF_ADDON_HAS_OFX_OSC)
-	bool _setupOscMessage(ofxOscMessage& am, const std::uint64_t& aFrameNum, const std::shared_ptr<TrackedObject>& aobject, bool abWorld );
+	// int64 frame, int32 ID, int64 capture timestamp in microseconds, followed by x, y, z floats for every keypoint
+	bool _setupOscMessage(ofxOscMessage& am, const std::uint64_t& aFrameNum, const std::int64_t& aTimestampMicros, const std::shared_ptr<TrackedObject>& aobject, bool abWorld );
+	void _setupOscMessagePacked( ofxOscMessage& am, const std::uint64_t& aFrameNum, const std::int64_t& aTimestampMicros );
+	void _appendOscPackedHeader( TrackedObject::TrackedObjectType atype, size_t aNumObjects, OscEncoding& aencoding, DeltaCodec* acodec );
+	void _appendOscPackedObject( const std::shared_ptr<TrackedObject>& aobject, OscEncoding aencoding, DeltaCodec* acodec );
+	void _splitOscMessagePacked( const std::string& aAddress, const std::uint64_t& aFrameNum, const std::int64_t& aTimestampMicros, size_t aMaxBlobBytes, std::vector<ofxOscMessage>& aOutMessages );
+	static KeypointEncoding _getKeypointEncoding( OscEncoding aencoding );
+	// reused between messages so that packing does not allocate
+	std::string mOscPackedBuffer;
+	// size of the header and the start of every object in mOscPackedBuffer
+	size_t mOscPackedHeaderSize = 0;
+	std::vector<size_t> mOscPackedObjectOffsets;
+	std::string mOscPackedSplitBuffer;
+	std::vector<TrackedObject::Keypoint> mOscDeltaKeypoints;
 #endif
 	std::int64_t timestamp = 0; // nanoseconds
 	
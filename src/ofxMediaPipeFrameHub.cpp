@@ -0,0 +1,107 @@
+//
+//  ofxMediaPipeFrameHub.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeFrameHub.h"
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+void FrameHub::add( const std::shared_ptr<Tracker>& atracker ) {
+	if( !atracker ) return;
+	for( auto& tracker : mTrackers ) {
+		if( tracker == atracker ) {
+			return;
+		}
+	}
+	mTrackers.push_back(atracker);
+}
+
+//--------------------------------------------------------------
+void FrameHub::remove( const std::shared_ptr<Tracker>& atracker ) {
+	ofRemove( mTrackers, [&atracker](const std::shared_ptr<Tracker>& at) { return at == atracker; } );
+}
+
+//--------------------------------------------------------------
+void FrameHub::clear() {
+	mTrackers.clear();
+}
+
+//--------------------------------------------------------------
+void FrameHub::process( const ofPixels& apix ) {
+	process( apix, (std::int64_t)ofGetElapsedTimeMicros() );
+}
+
+//--------------------------------------------------------------
+void FrameHub::process( const ofPixels& apix, std::int64_t aTimestampMicros ) {
+	if( mTrackers.size() < 1 ) {
+		return;
+	}
+	// one timestamp for all of the trackers so that the results line up,
+	// each tracker turns it into a millisecond timestamp that media pipe accepts
+	mLastTimestampMicros = aTimestampMicros;
+
+	// trackers in the threaded video mode convert the pixels on their own thread,
+	// trackers using a worker process copy them into shared memory and trackers with an
+	// isolated interpreter can not use an mp.Image created in the main interpreter.
+	// Tracker::process releases the GIL on its own, so they are called before it is released here.
+	// converted once for all of the trackers, RGB and RGBA are passed through
+	const ofPixels& ipix = mPixelConverter.process( apix );
+	if( !ipix.isAllocated() ) {
+		ofLogWarning("FrameHub::process") << "unable to convert pixels from " << PixelConverter::sGetStringForFormat(apix.getPixelFormat());
+		return;
+	}
+	
+	std::shared_ptr<Tracker> convertingTracker;
+	bool bNeedsImage = false;
+	for( auto& tracker : mTrackers ) {
+		if( !tracker->isSetup() ) {
+			continue;
+		}
+		if( !_canShareImage(tracker) ) {
+			tracker->process(ipix, aTimestampMicros);
+		} else {
+			bNeedsImage = true;
+			if( !convertingTracker ) {
+				convertingTracker = tracker;
+			}
+		}
+	}
+
+	if( !bNeedsImage || !convertingTracker ) {
+		return;
+	}
+
+	// release the GIL held by the main thread, so that the time waiting for it is recorded
+	std::optional<py::gil_scoped_release> release;
+	if( Py_IsInitialized() && PyGILState_Check() ) {
+		release.emplace();
+	}
+
+	// the trackers do not record GIL time for this acquisition, they are called with the GIL already held
+	ScopedGilAcquire acquire( &mGilWait, &mGilHold );
+	py::object mp_image = convertingTracker->_getMpImageFromPixels(ipix);
+	if( !mp_image ) {
+		ofLogWarning("FrameHub::process") << "unable to create mp image.";
+		return;
+	}
+
+	for( auto& tracker : mTrackers ) {
+		if( !tracker->isSetup() || !_canShareImage(tracker) ) {
+			continue;
+		}
+		tracker->processShared( ipix, mp_image, aTimestampMicros );
+	}
+}
+
+//--------------------------------------------------------------
+bool FrameHub::_canShareImage( const std::shared_ptr<Tracker>& atracker ) {
+	return atracker->getRunningMode() != Tracker::MODE_OF_VIDEO_THREAD && !atracker->isUsingWorker() && !atracker->getInterpreter().isIsolated() && !atracker->getImagePrep().isEnabled();
+}
+
+#endif
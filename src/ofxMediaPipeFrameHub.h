@@ -0,0 +1,47 @@
+//
+//  ofxMediaPipeFrameHub.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofxMediaPipeTracker.h"
+
+namespace ofx::MediaPipe {
+// Converts a camera frame into a single mp.Image and hands it to every registered tracker.
+// Running hand, face and pose trackers on the same pixels through a hub costs one
+// conversion, one timestamp and one GIL acquisition per frame instead of one per tracker.
+class FrameHub {
+public:
+	void add( const std::shared_ptr<Tracker>& atracker );
+	void remove( const std::shared_ptr<Tracker>& atracker );
+	void clear();
+
+	std::vector< std::shared_ptr<Tracker> >& getTrackers() { return mTrackers; }
+	size_t getNumTrackers() { return mTrackers.size(); }
+
+	// uses ofGetElapsedTimeMicros() as the capture timestamp
+	void process( const ofPixels& apix );
+	// aTimestampMicros is the time the frame was captured, passed to every tracker, see Tracker::process
+	void process( const ofPixels& apix, std::int64_t aTimestampMicros );
+
+	std::int64_t getLastTimestampMicros() { return mLastTimestampMicros; }
+	
+	// microseconds spent waiting for and holding the GIL while passing a frame to the trackers
+	Histogram& getGilWaitHistogram() { return mGilWait; }
+	Histogram& getGilHoldHistogram() { return mGilHold; }
+
+protected:
+	bool _canShareImage( const std::shared_ptr<Tracker>& atracker );
+
+	std::vector< std::shared_ptr<Tracker> > mTrackers;
+	std::int64_t mLastTimestampMicros = -1;
+	Histogram mGilWait;
+	Histogram mGilHold;
+	PixelConverter mPixelConverter;
+};
+}
+#endif
@@ -0,0 +1,236 @@
+//
+//  ofxMediaPipeFrameQueue.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeFrameQueue.h"
+#include "ofUtils.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+std::string FrameQueue::sGetStringForPolicy( Policy apolicy ) {
+	if( apolicy == POLICY_DROP_NEWEST ) {
+		return "DROP_NEWEST";
+	} else if( apolicy == POLICY_BLOCK ) {
+		return "BLOCK";
+	}
+	return "DROP_OLDEST";
+}
+
+//--------------------------------------------------------------
+FrameQueue::FrameQueue() {
+	mEnqueuePos = 0;
+	mDequeuePos = 0;
+	mBClosed = false;
+	setup( 2, POLICY_DROP_OLDEST );
+}
+
+//--------------------------------------------------------------
+FrameQueue::~FrameQueue() {
+	close();
+}
+
+//--------------------------------------------------------------
+void FrameQueue::setup( size_t aDepth, Policy aPolicy ) {
+	size_t capacity = 2;
+	while( capacity < aDepth ) {
+		capacity = capacity << 1;
+	}
+	mPolicy = aPolicy;
+	if( capacity != mCapacity ) {
+		mSlots = std::make_unique<Slot[]>(capacity);
+		mCapacity = capacity;
+		mMask = capacity - 1;
+	}
+	for( size_t i = 0; i < mCapacity; i++ ) {
+		mSlots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	mEnqueuePos.store(0, std::memory_order_relaxed);
+	mDequeuePos.store(0, std::memory_order_relaxed);
+	resetCounters();
+}
+
+//--------------------------------------------------------------
+bool FrameQueue::push( const ofPixels& apix, std::int64_t aTimestampMicros ) {
+	if( mBClosed.load() ) {
+		return false;
+	}
+
+	bool bPushed = _tryPush( apix, aTimestampMicros );
+	if( !bPushed ) {
+		if( mPolicy == POLICY_DROP_OLDEST ) {
+			// make room by discarding the oldest frame, the consumer may have taken it in the meantime
+			while( !bPushed && !mBClosed.load() ) {
+				if( _tryPop( nullptr, nullptr, nullptr ) ) {
+					mNumDropped++;
+				}
+				bPushed = _tryPush( apix, aTimestampMicros );
+			}
+		} else if( mPolicy == POLICY_BLOCK ) {
+			std::unique_lock<std::mutex> lck(mWaitMutex);
+			while( !bPushed && !mBClosed.load() ) {
+				mCondition.wait( lck, [this]{ return mBClosed.load() || getNumQueued() < mCapacity; });
+				bPushed = _tryPush( apix, aTimestampMicros );
+			}
+		} else {
+			mNumDropped++;
+		}
+	}
+
+	if( bPushed ) {
+		mNumEnqueued++;
+		_notify();
+	}
+	return bPushed;
+}
+
+//--------------------------------------------------------------
+bool FrameQueue::pop( ofPixels& aOutPix, std::uint64_t* aOutPushMicros, std::int64_t* aOutTimestampMicros ) {
+	while( !mBClosed.load() ) {
+		if( tryPop( aOutPix, aOutPushMicros, aOutTimestampMicros ) ) {
+			return true;
+		}
+		std::unique_lock<std::mutex> lck(mWaitMutex);
+		mCondition.wait( lck, [this]{ return mBClosed.load() || getNumQueued() > 0; });
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool FrameQueue::tryPop( ofPixels& aOutPix, std::uint64_t* aOutPushMicros, std::int64_t* aOutTimestampMicros ) {
+	if( _tryPop( &aOutPix, aOutPushMicros, aOutTimestampMicros ) ) {
+		mNumDequeued++;
+		if( mPolicy == POLICY_BLOCK ) {
+			// a producer may be waiting for a free slot
+			_notify();
+		}
+		return true;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void FrameQueue::close() {
+	mBClosed = true;
+	_notify();
+}
+
+//--------------------------------------------------------------
+void FrameQueue::open() {
+	mBClosed = false;
+}
+
+//--------------------------------------------------------------
+size_t FrameQueue::getNumQueued() {
+	size_t dpos = mDequeuePos.load(std::memory_order_acquire);
+	size_t epos = mEnqueuePos.load(std::memory_order_acquire);
+	if( epos <= dpos ) {
+		return 0;
+	}
+	return std::min( epos - dpos, mCapacity );
+}
+
+//--------------------------------------------------------------
+double FrameQueue::getAverageLatencyMicros() {
+	auto numDequeued = mNumDequeued.load();
+	if( numDequeued < 1 ) {
+		return 0.0;
+	}
+	return (double)mTotalLatencyMicros.load() / (double)numDequeued;
+}
+
+//--------------------------------------------------------------
+void FrameQueue::resetCounters() {
+	mNumEnqueued = 0;
+	mNumDequeued = 0;
+	mNumDropped = 0;
+	mLastLatencyMicros = 0;
+	mMaxLatencyMicros = 0;
+	mTotalLatencyMicros = 0;
+}
+
+//--------------------------------------------------------------
+bool FrameQueue::_tryPush( const ofPixels& apix, std::int64_t aTimestampMicros ) {
+	Slot* slot = nullptr;
+	size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+	for(;;) {
+		slot = &mSlots[pos & mMask];
+		size_t seq = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+		if( diff == 0 ) {
+			if( mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+				break;
+			}
+		} else if( diff < 0 ) {
+			// full
+			return false;
+		} else {
+			pos = mEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	// the slot keeps its allocation, so this is only a copy once the frame size is stable
+	auto& spix = slot->pixels;
+	if( spix.getWidth() != apix.getWidth() || spix.getHeight() != apix.getHeight() || spix.getNumChannels() != apix.getNumChannels() ) {
+		spix.allocate( apix.getWidth(), apix.getHeight(), apix.getNumChannels() );
+	}
+	if( apix.isAllocated() ) {
+		memcpy( spix.getData(), apix.getData(), apix.getTotalBytes() );
+	}
+	slot->pushMicros = ofGetElapsedTimeMicros();
+	slot->timestampMicros = aTimestampMicros;
+	slot->sequence.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+//--------------------------------------------------------------
+bool FrameQueue::_tryPop( ofPixels* aOutPix, std::uint64_t* aOutPushMicros, std::int64_t* aOutTimestampMicros ) {
+	Slot* slot = nullptr;
+	size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+	for(;;) {
+		slot = &mSlots[pos & mMask];
+		size_t seq = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+		if( diff == 0 ) {
+			if( mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+				break;
+			}
+		} else if( diff < 0 ) {
+			// empty
+			return false;
+		} else {
+			pos = mDequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	if( aOutPix ) {
+		// swap instead of copy, the slot gets the previous buffer of aOutPix to fill next time
+		aOutPix->swap( slot->pixels );
+		std::uint64_t latency = ofGetElapsedTimeMicros() - slot->pushMicros;
+		mLastLatencyMicros = latency;
+		mTotalLatencyMicros += latency;
+		if( latency > mMaxLatencyMicros.load() ) {
+			mMaxLatencyMicros = latency;
+		}
+		if( aOutPushMicros ) {
+			*aOutPushMicros = slot->pushMicros;
+		}
+		if( aOutTimestampMicros ) {
+			*aOutTimestampMicros = slot->timestampMicros;
+		}
+	}
+	slot->sequence.store(pos + mMask + 1, std::memory_order_release);
+	return true;
+}
+
+//--------------------------------------------------------------
+void FrameQueue::_notify() {
+	{
+		// taking the lock makes sure that a thread that just checked its wait condition is now waiting
+		std::lock_guard<std::mutex> lck(mWaitMutex);
+	}
+	mCondition.notify_all();
+}
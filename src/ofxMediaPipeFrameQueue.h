@@ -0,0 +1,100 @@
+//
+//  ofxMediaPipeFrameQueue.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofPixels.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <memory>
+
+namespace ofx::MediaPipe {
+// Bounded queue of preallocated pixel slots between the thread calling Tracker::process
+// and the tracker's video thread.
+// Slots are handed off with per slot sequence numbers, so pushing and popping does not lock.
+// The mutex and condition variable are only used to put the threads to sleep when there
+// is nothing to do, instead of polling.
+class FrameQueue {
+public:
+	enum Policy {
+		// discard the oldest queued frame to make room for the new one
+		POLICY_DROP_OLDEST=0,
+		// discard the new frame when the queue is full
+		POLICY_DROP_NEWEST,
+		// wait for the consumer to make room
+		POLICY_BLOCK
+	};
+
+	static std::string sGetStringForPolicy( Policy apolicy );
+
+	FrameQueue();
+	~FrameQueue();
+
+	// the depth is rounded up to a power of two, with a minimum of 2.
+	// Should not be called while the queue is being used by another thread.
+	void setup( size_t aDepth, Policy aPolicy );
+
+	// copies apix into the next free slot, returns false if the frame was dropped.
+	// aTimestampMicros is the capture timestamp of the frame and is handed back by pop.
+	bool push( const ofPixels& apix, std::int64_t aTimestampMicros=0 );
+	// swaps the oldest queued frame into aOutPix, waits until a frame is available or the queue is closed.
+	// aOutPix keeps the previous allocation of the slot, so the buffers are reused.
+	// aOutPushMicros is set to ofGetElapsedTimeMicros() at the time the frame was pushed.
+	bool pop( ofPixels& aOutPix, std::uint64_t* aOutPushMicros=nullptr, std::int64_t* aOutTimestampMicros=nullptr );
+	bool tryPop( ofPixels& aOutPix, std::uint64_t* aOutPushMicros=nullptr, std::int64_t* aOutTimestampMicros=nullptr );
+
+	// wakes up all waiting threads, push and pop fail until the queue is opened again
+	void close();
+	void open();
+	bool isClosed() { return mBClosed.load(); }
+
+	Policy getPolicy() { return mPolicy; }
+	size_t getCapacity() { return mCapacity; }
+	size_t getNumQueued();
+
+	std::uint64_t getNumEnqueued() { return mNumEnqueued.load(); }
+	std::uint64_t getNumDequeued() { return mNumDequeued.load(); }
+	std::uint64_t getNumDropped() { return mNumDropped.load(); }
+	// time between a frame being pushed and being popped
+	std::uint64_t getLastLatencyMicros() { return mLastLatencyMicros.load(); }
+	std::uint64_t getMaxLatencyMicros() { return mMaxLatencyMicros.load(); }
+	double getAverageLatencyMicros();
+	void resetCounters();
+
+protected:
+	struct Slot {
+		std::atomic<size_t> sequence;
+		ofPixels pixels;
+		std::uint64_t pushMicros = 0;
+		std::int64_t timestampMicros = 0;
+	};
+
+	bool _tryPush( const ofPixels& apix, std::int64_t aTimestampMicros );
+	bool _tryPop( ofPixels* aOutPix, std::uint64_t* aOutPushMicros, std::int64_t* aOutTimestampMicros );
+	void _notify();
+
+	std::unique_ptr<Slot[]> mSlots;
+	size_t mCapacity = 0;
+	size_t mMask = 0;
+	Policy mPolicy = POLICY_DROP_OLDEST;
+
+	// the producer and consumer positions are written by different threads, keep them on separate cache lines
+	alignas(64) std::atomic<size_t> mEnqueuePos;
+	alignas(64) std::atomic<size_t> mDequeuePos;
+
+	alignas(64) std::atomic<bool> mBClosed;
+	std::mutex mWaitMutex;
+	std::condition_variable mCondition;
+
+	std::atomic<std::uint64_t> mNumEnqueued = 0;
+	std::atomic<std::uint64_t> mNumDequeued = 0;
+	std::atomic<std::uint64_t> mNumDropped = 0;
+	std::atomic<std::uint64_t> mLastLatencyMicros = 0;
+	std::atomic<std::uint64_t> mMaxLatencyMicros = 0;
+	std::atomic<std::uint64_t> mTotalLatencyMicros = 0;
+};
+}
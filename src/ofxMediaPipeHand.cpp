@@ -170,6 +170,14 @@ void Hand::updateFromHandWithSmoothing( std::shared_ptr<Hand> aother, float pct
 	updateFingers();
 }
 
+//-------------------------------------------
+void Hand::updateFromInterpolated( std::shared_ptr<Hand>& aA, std::shared_ptr<Hand>& aB, float apct ) {
+	handed = aA->handed;
+	index = aA->index;
+	updateKeypointsFromInterpolation(aA, aB, apct);
+	updateFingers();
+}
+
 //-------------------------------------------
 void Hand::updateFromKeypoints() {
 //	if(keypoints.size() > 1 ) {
@@ -100,6 +100,8 @@ public:
 	
 	void updateFrom( std::shared_ptr<Hand>& aother );
 	void updateFromHandWithSmoothing( std::shared_ptr<Hand> aother, float pct );
+	// keypoints between two recorded frames, the handedness is taken from aA
+	void updateFromInterpolated( std::shared_ptr<Hand>& aA, std::shared_ptr<Hand>& aB, float apct );
 	void updateFromKeypoints() override;
 	
 	void setMaxDegreesForOpenFinger( float adegrees ) { mMaxDegForOpenFinger = adegrees;}
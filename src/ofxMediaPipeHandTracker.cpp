@@ -77,7 +77,8 @@ bool HandTracker::setup(const Tracker::Settings& asettings) {
 
 //----------------------------------------------------------
 bool HandTracker::setup(const HandSettings& asettings) {
-	if (!Py_IsInitialized()) {
+	// a worker process has its own interpreter
+	if (!Py_IsInitialized() && asettings.backend != Tracker::BACKEND_WORKER_PROCESS) {
 		ofLogNotice("HandTracker") << "initing PYTHON";
 		py::initialize_interpreter();
 	}
@@ -87,6 +88,7 @@ bool HandTracker::setup(const HandSettings& asettings) {
 	}
 	
 	mSettings = asettings;
+	_applyBaseSettings( mSettings );
 	mHasNewThreadValues = false;
 	mBSetup = false;
 	
@@ -108,7 +110,16 @@ bool HandTracker::setup(const HandSettings& asettings) {
 	
 	mBExiting = false;
 	
-	py::gil_scoped_acquire acquire;
+	if( mSettings.backend == Tracker::BACKEND_WORKER_PROCESS ) {
+		// results arrive on the reader thread of the worker and are applied in update, like the video thread
+		mSettings.runningMode = Tracker::MODE_OF_VIDEO_THREAD;
+		ofJson jconfig;
+		return _setupWorker( mSettings, jconfig );
+	}
+	
+	_setupInterpreter( mSettings );
+	// acquires the GIL of the tracker's interpreter
+	ScopedGilAcquire acquire( nullptr, nullptr, &mInterpreter );
 	
 	py_mediapipe = py::module::import("mediapipe");
 	
@@ -121,16 +132,10 @@ bool HandTracker::setup(const HandSettings& asettings) {
 	// Create BaseOptions object
 	py::object base_options = BaseOptions.attr("__call__")(py::arg("model_asset_path") = mSettings.filePath.string());
 	
-	process_results_lambda = [this](py::object& aresults, py::object& aMpImage, int aTimestamp) {
+	process_results_lambda = [this](py::object& aresults, py::object& aMpImage, std::int64_t aTimestamp) {
 		//		std::cout << "Class Lambda Result callback called. " << aTimestamp << std::endl;
 //		_process_results_callback( aresults, aMpImage, aTimestamp );
-		if( mBExiting.load() ) {
-			mThreadCallCount--;
-			if( mThreadCallCount < 0 ) {
-				mThreadCallCount = 0;
-			}
-			return;
-		}
+		// _process_results_callback clears the in flight frames when exiting
 		try {
 			_process_results_callback( aresults, aMpImage, aTimestamp );
 		} catch(...) {
@@ -189,7 +194,9 @@ void HandTracker::_update() {
 		if(mHasNewThreadValues.load() ) {
 			std::lock_guard<std::mutex> lck(mMutex);
 //			mHands = mThreadedHands;
+			mTimestampMicros = mThreadedTimestampMicros;
 			_matchHands(mThreadedHands, mHands);
+			_trace( Trace::STAGE_MATCH_DONE, mTimestampMicros );
 //			mThreadedHands.clear();
 			mHasNewThreadValues = false;
 			mBHasNewData = true;
@@ -257,13 +264,13 @@ std::vector< std::shared_ptr<Hand> >& HandTracker::getHands() {
 //hand_world_landmarks : [[Landmark(x=0.006685516331344843, y=0.07610618323087692, z=0.040495019406080246, visibility=0.0, presence=0.0), Landmark(x=-0.022024918347597122, y=0.05909471958875656, z=0.018718942999839783, visibility=0.0, presence=0.0), Landmark(x=-0.045786432921886444, y=0.04494400694966316, z=0.01305803656578064, visibility=0.0, presence=0.0), Landmark(x=-0.07290252298116684, y=0.02922983467578888, z=0.00031625479459762573, visibility=0.0, presence=0.0), Landmark(x=-0.09517879039049149, y=0.016235588118433952, z=-0.003068894147872925, visibility=0.0, presence=0.0), Landmark(x=-0.029854686930775642, y=0.0006955352146178484, z=0.0006534606218338013, visibility=0.0, presence=0.0), Landmark(x=-0.03406838700175285, y=-0.026650594547390938, z=-0.008894145488739014, visibility=0.0, presence=0.0), Landmark(x=-0.03962825983762741, y=-0.04460236802697182, z=-0.01850660890340805, visibility=0.0, presence=0.0), Landmark(x=-0.04587438330054283, y=-0.05410303920507431, z=-0.047971874475479126, visibility=0.0, presence=0.0), Landmark(x=-0.00511194858700037, y=-0.003661972237750888, z=0.003855682909488678, visibility=0.0, presence=0.0), Landmark(x=-0.005253266543149948, y=-0.037635669112205505, z=-0.01105014979839325, visibility=0.0, presence=0.0), Landmark(x=-0.009853962808847427, y=-0.05410832539200783, z=-0.033931247889995575, visibility=0.0, presence=0.0), Landmark(x=-0.011906065978109837, y=-0.07113976776599884, z=-0.04982277750968933, visibility=0.0, presence=0.0), Landmark(x=0.019932344555854797, y=-0.002301717409864068, z=0.0006671473383903503, visibility=0.0, presence=0.0), Landmark(x=0.022409604862332344, y=-0.029750555753707886, z=-0.011924408376216888, visibility=0.0, presence=0.0), Landmark(x=0.02385624498128891, y=-0.04673103243112564, z=-0.031734734773635864, visibility=0.0, presence=0.0), Landmark(x=0.020600594580173492, y=-0.061787888407707214, z=-0.050707537680864334, visibility=0.0, presence=0.0), Landmark(x=0.03504936769604683, y=0.012213998474180698, z=-0.0012091100215911865, visibility=0.0, presence=0.0), Landmark(x=0.04779692366719246, y=-0.0056094881147146225, z=-0.004539430141448975, visibility=0.0, presence=0.0), Landmark(x=0.05846109613776207, y=-0.020058535039424896, z=-0.0188915953040123, visibility=0.0, presence=0.0), Landmark(x=0.060523319989442825, y=-0.029996195808053017, z=-0.033676162362098694, visibility=0.0, presence=0.0)]]
 
 //----------------------------------------------------------
-void HandTracker::_process_landmark_results(py::object& aresults, int aTimestamp) {
+void HandTracker::_process_landmark_results(py::object& aresults, std::int64_t aTimestampMicros) {
 	if (mBExiting.load()) {
 		return;
 	}
 	
 	if (aresults.is_none()) {
-		ofLogNotice("HandTracker::_process_landmark_results") << "Results are bad, returning. " << aTimestamp;
+		ofLogNotice("HandTracker::_process_landmark_results") << "Results are bad, returning. " << aTimestampMicros;
 		return;
 	}
 	
@@ -278,13 +285,12 @@ void HandTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 	//	for (auto item : attributes) {
 	//		py::print(item.first, ":", item.second);
 	//	}
-	std::vector< std::shared_ptr<Hand> > thands;
 	try {
 //		py::gil_scoped_acquire acquire;
 
 		//	if( !Utils::has_attribute(aresults, "hand_landmarks") || !Utils::has_attribute(aresults, "hand_world_landmarks") || !Utils::has_attribute(aresults, "handedness")) {
 		if (!Utils::has_all_attributes(aresults, { "hand_landmarks", "hand_world_landmarks", "handedness" })) {
-			ofLogError("HandTracker::_process_landmark_results") << "Does not contain either hand_landmarks or hand_world_landmarks or handedness attributes. " << aTimestamp;
+			ofLogError("HandTracker::_process_landmark_results") << "Does not contain either hand_landmarks or hand_world_landmarks or handedness attributes. " << aTimestampMicros;
 			//py::gil_scoped_release release;
 			return;
 		}
@@ -295,7 +301,7 @@ void HandTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 		//	Check if results is iterable
 		if (!py::isinstance<py::iterable>(hand_landmarks_list)) {
-			ofLogError("HandTracker::_process_landmark_results") << "'results' hand_landmarks is not iterable. " << aTimestamp;
+			ofLogError("HandTracker::_process_landmark_results") << "'results' hand_landmarks is not iterable. " << aTimestampMicros;
 			//py::gil_scoped_release release;
 			return;
 		}
@@ -306,115 +312,115 @@ void HandTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 		//py::gil_scoped_acquire acquire;
 
 		// std::vector< std::shared_ptr<Hand> > thands;
-		int numMarks = py::len(hand_landmarks_list);
-		for (int i = 0; i < numMarks; i++) {
+		// pack the landmarks into contiguous buffers instead of looking up every coordinate
+		if( !mLandmarkPacker.packLandmarks(hand_landmarks_list, mPackedLandmarks) ||
+		   !mLandmarkPacker.packLandmarks(hand_world_landmarks_list, mPackedWorldLandmarks) ||
+		   !mLandmarkPacker.packCategories(handedness_list, mPackedCategories, true) ) {
+			ofLogError("HandTracker::_process_landmark_results") << "unable to pack the results. " << aTimestampMicros;
+			return;
+		}
+		
+		//py::gil_scoped_release release;
 
-			//		Hand thand;
-			auto thand = std::make_shared<Hand>();
+	} catch (...) {
+		ofLogError("HandTracker") << __FUNCTION__ << " error with gil";
+		return;
+	}
 
-			py::list handedness = handedness_list[i];
-			if (py::len(handedness) > 0) {
-				py::object handed = handedness[0];
-				// (index=1, score=0.9968175888061523, display_name='Left', category_name='Left')
-				std::string hcategory = py::str(handed.attr("category_name"));
-				//			cout << "Handed: " << hcategory << endl;
+	// Release GIL while performing intensive C++ operations
+	//py::gil_scoped_release release;
+	_apply_packed_results(aTimestampMicros);
+}
 
-				if (ofToLower(hcategory) == "left") {
-					thand->handed = Hand::Handedness::LEFT;
+//-----------------------------------------------------------------------
+void HandTracker::_process_packed_results(std::int64_t aTimestampMicros) {
+	std::vector< std::shared_ptr<Hand> > thands;
+	
+	int numMarks = (int)mPackedLandmarks.getNumLists();
+	size_t landmarkOffset = 0;
+	size_t worldOffset = 0;
+	size_t categoryOffset = 0;
+	for (int i = 0; i < numMarks; i++) {
+
+		//		Hand thand;
+		auto thand = std::make_shared<Hand>();
+
+		if( i < (int)mPackedCategories.getNumLists() ) {
+			int numCategories = mPackedCategories.counts[i];
+			if (numCategories > 0 && categoryOffset < mPackedCategories.indices.size()) {
+				// (index=1, score=0.9968175888061523, display_name='Left', category_name='Left')
+				if( categoryOffset < mPackedCategories.names.size() ) {
+					const std::string& hcategory = mPackedCategories.names[categoryOffset];
+					if (ofToLower(hcategory) == "left") {
+						thand->handed = Hand::Handedness::LEFT;
+					}
 				}
-				thand->index = py::int_(handed.attr("index"));
+				thand->index = mPackedCategories.indices[categoryOffset];
 			}
+			categoryOffset += numCategories;
+		}
 
+		int num = mPackedLandmarks.counts[i];
+		int numWorld = 0;
+		if( i < (int)mPackedWorldLandmarks.getNumLists() ) {
+			numWorld = std::min( num, mPackedWorldLandmarks.counts[i] );
+		}
 
-			py::list hand_landmarks = hand_landmarks_list[i];
-			py::list hand_world_landmarks = hand_world_landmarks_list[i];
-
-			int num = py::len(hand_landmarks);
-
-			thand->keypoints.assign(num, TrackedObject::Keypoint());
-
-			//		for( int j = 0; j < num; j++ ) {
-			int j = 0;
-			for (py::handle hl : hand_landmarks) {
-				//			py::object hl = hand_landmarks[j];
-				//			py::object hwl = hand_world_landmarks[j];
-
-				auto& kp = thand->keypoints[j];
-				//			thand.keypoints[j].pos = glm::vec3(py::float_(hl.attr("x")), py::float_(hl.attr("y")), py::float_(hl.attr("z")) );
-				kp.pos.x = py::float_(py::getattr(hl, "x"));
-				kp.pos.y = py::float_(py::getattr(hl, "y"));
-				kp.pos.z = py::float_(py::getattr(hl, "z"));
+		thand->keypoints.assign(num, TrackedObject::Keypoint());
 
-				kp.posN = kp.pos;
-				kp.pos.x *= mOutRect.width;
-				kp.pos.y *= mOutRect.height;
-				kp.pos.x += mOutRect.x;
-				kp.pos.y += mOutRect.y;
+		const float* xyz = mPackedLandmarks.xyz.data() + landmarkOffset * 3;
+		for (int j = 0; j < num; j++) {
+			auto& kp = thand->keypoints[j];
+			kp.pos.x = xyz[j*3+0];
+			kp.pos.y = xyz[j*3+1];
+			kp.pos.z = xyz[j*3+2];
 
-				kp.pos.z *= mOutRect.width;
+			kp.posN = kp.pos;
+			kp.pos.x *= mOutRect.width;
+			kp.pos.y *= mOutRect.height;
+			kp.pos.x += mOutRect.x;
+			kp.pos.y += mOutRect.y;
 
-				//			kp.visibility = py::float_(hl.attr("visibility"));
-				//			kp.presence = py::float_(hl.attr("presence"));
-				j++;
-			}
-
-			j = 0;
-			for (py::handle hwl : hand_world_landmarks) {
-				//			thand.keypoints[j].posWorld = glm::vec3(py::float_(hwl.attr("x")), py::float_(hwl.attr("y")), py::float_(hwl.attr("z")) );
-				auto& kp = thand->keypoints[j];
-				kp.posWorld.x = py::float_(py::getattr(hwl, "x"));
-				kp.posWorld.y = py::float_(py::getattr(hwl, "y"));
-				kp.posWorld.z = py::float_(py::getattr(hwl, "z"));
-				j++;
-			}
+			kp.pos.z *= mOutRect.width;
+		}
 
-			//		if(thand.keypoints.size() > 1 ) {
-			//			thand.pos = thand.keypoints[0].pos;
-			//			thand.posN = thand.keypoints[0].posN;
-			//			thand.posWorld = thand.keypoints[0].posWorld;
-			//		}
-					//
-					////		https://developers.google.com/mediapipe/solutions/vision/hand_landmarker/python#video_2
-					////		The 21 hand landmarks are also presented in world coordinates. Each landmark is composed of x, y, and z, representing real-world 3D coordinates in meters with the origin at the hand’s geometric center.
-					//		for( int j = 1; j < thand.keypoints.size(); j++ ) {
-					//			thand.keypoints[j].posWorld += thand.posWorld;
-					//		}
-
-			thands.push_back(thand);
-
-			//		std::string attr_name = py::str(handedness_list[i]);
-			//		std::cout << "Attribute/Method " << i << " / " << numMarks << " : num land marks: " << py::len(hand_landmarks) << std::endl;
-			//		std::cout << " output: " << attr_name << endl;
+		const float* wxyz = mPackedWorldLandmarks.xyz.data() + worldOffset * 3;
+		for (int j = 0; j < numWorld; j++) {
+			auto& kp = thand->keypoints[j];
+			kp.posWorld.x = wxyz[j*3+0];
+			kp.posWorld.y = wxyz[j*3+1];
+			kp.posWorld.z = wxyz[j*3+2];
 		}
 
-		//py::gil_scoped_release release;
+		landmarkOffset += num;
+		if( i < (int)mPackedWorldLandmarks.getNumLists() ) {
+			worldOffset += mPackedWorldLandmarks.counts[i];
+		}
 
-	} catch (...) {
-		ofLogError("HandTracker") << __FUNCTION__ << " error with gil";
-		return;
+		thands.push_back(thand);
 	}
 
-	// Release GIL while performing intensive C++ operations
-	//py::gil_scoped_release release;
-		
-	
 	if( mSettings.runningMode == Tracker::MODE_LIVE_STREAM) {
 		std::lock_guard<std::mutex> lck(mMutex);
 		mThreadedHands = thands;
+		mThreadedTimestampMicros = aTimestampMicros;
 		mHasNewThreadValues = true;
 	} else if( mSettings.runningMode == Tracker::MODE_OF_VIDEO_THREAD ) {
 		std::lock_guard<std::mutex> lck(mMutex);
 		mThreadedHands = thands;
+		mThreadedTimestampMicros = aTimestampMicros;
 		mHasNewThreadValues = true;
 	} else {
+		mTimestampMicros = aTimestampMicros;
 		_matchHands( thands, mHands );
+		_trace( Trace::STAGE_MATCH_DONE, aTimestampMicros );
 	}
 }
 
 //-----------------------------------------------------------------------
 void HandTracker::_matchHands( std::vector<std::shared_ptr<Hand>>& aIncomingHands, std::vector<std::shared_ptr<Hand>> & aHands ) {
-	float frameRate = ofClamp(Tracker::mFpsCounter.getFps(), 1, 200);
-	int mNumFramesToDie = Tracker::mMaxTimeToMatch * frameRate;
+	Histogram::ScopedTimer matchingTimer( mStats.matching );
+	int mNumFramesToDie = _getNumFramesToDie( mTimestampMicros );
 	
 	// now lets try to track the hands
 	for( auto& hand : aHands ) {
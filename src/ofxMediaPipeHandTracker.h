@@ -23,14 +23,7 @@ public:
 	public:
 		HandSettings() {};
 		~HandSettings() {};
-		HandSettings( const Tracker::Settings& asettings ) {
-			runningMode = asettings.runningMode;
-			maxNum = asettings.maxNum;
-			minDetectionConfidence = asettings.minDetectionConfidence;
-			minPresenceConfidence = asettings.minPresenceConfidence;
-			minTrackingConfidence = asettings.minTrackingConfidence;
-			filePath = asettings.filePath;
-		}
+		HandSettings( const Tracker::Settings& asettings ) : Tracker::Settings(asettings) {}
 	};
 	
 	ofParameterGroup& getParams() override;
@@ -54,7 +47,8 @@ protected:
 	ofParameter<bool> mBDrawFingers, mBDrawFingerInfo;
 	ofParameter<float> mPosSmoothing;
 	
-	void _process_landmark_results( py::object& aresults, int aTimestamp) override;
+	void _process_landmark_results( py::object& aresults, std::int64_t aTimestampMicros) override;
+	void _process_packed_results( std::int64_t aTimestampMicros ) override;
 	
 	std::vector< std::shared_ptr<Hand> > mThreadedHands;
 	std::vector< std::shared_ptr<Hand> > mHands;
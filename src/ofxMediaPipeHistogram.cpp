@@ -0,0 +1,130 @@
+//
+//  ofxMediaPipeHistogram.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeHistogram.h"
+#include <limits>
+#include <sstream>
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+Histogram::Histogram() {
+	reset();
+}
+
+//--------------------------------------------------------------
+void Histogram::add( std::uint64_t aValue ) {
+	mBuckets[_getBucketIndex(aValue)].fetch_add(1, std::memory_order_relaxed);
+	mCount.fetch_add(1, std::memory_order_relaxed);
+	mSum.fetch_add(aValue, std::memory_order_relaxed);
+
+	auto cmin = mMin.load(std::memory_order_relaxed);
+	while( aValue < cmin && !mMin.compare_exchange_weak(cmin, aValue, std::memory_order_relaxed) ) {}
+	auto cmax = mMax.load(std::memory_order_relaxed);
+	while( aValue > cmax && !mMax.compare_exchange_weak(cmax, aValue, std::memory_order_relaxed) ) {}
+}
+
+//--------------------------------------------------------------
+void Histogram::reset() {
+	for( auto& bucket : mBuckets ) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	mCount = 0;
+	mSum = 0;
+	mMin = std::numeric_limits<std::uint64_t>::max();
+	mMax = 0;
+}
+
+//--------------------------------------------------------------
+std::uint64_t Histogram::getMin() {
+	if( getCount() < 1 ) {
+		return 0;
+	}
+	return mMin.load();
+}
+
+//--------------------------------------------------------------
+double Histogram::getMean() {
+	auto count = getCount();
+	if( count < 1 ) {
+		return 0.0;
+	}
+	return (double)mSum.load() / (double)count;
+}
+
+//--------------------------------------------------------------
+std::uint64_t Histogram::getPercentile( double apercent ) {
+	auto count = getCount();
+	if( count < 1 ) {
+		return 0;
+	}
+	if( apercent < 0.0 ) apercent = 0.0;
+	if( apercent > 100.0 ) apercent = 100.0;
+
+	std::uint64_t target = (std::uint64_t)((apercent / 100.0) * (double)count + 0.5);
+	if( target < 1 ) target = 1;
+
+	std::uint64_t total = 0;
+	for( int i = 0; i < NUM_BUCKETS; i++ ) {
+		total += mBuckets[i].load(std::memory_order_relaxed);
+		if( total >= target ) {
+			// the bucket bound can not be larger than the largest value that was added
+			return std::min( _getBucketUpperBound(i), getMax() );
+		}
+	}
+	return getMax();
+}
+
+//--------------------------------------------------------------
+std::string Histogram::toString() {
+	std::stringstream ss;
+	ss << "count: " << getCount() << " mean: " << getMean() << " min: " << getMin();
+	ss << " p50: " << getPercentile(50.0) << " p99: " << getPercentile(99.0) << " max: " << getMax();
+	return ss.str();
+}
+
+//--------------------------------------------------------------
+ofJson Histogram::jsonify() {
+	ofJson jhist;
+	jhist["count"] = getCount();
+	jhist["mean"] = getMean();
+	jhist["min"] = getMin();
+	jhist["max"] = getMax();
+	jhist["p50"] = getPercentile(50.0);
+	jhist["p90"] = getPercentile(90.0);
+	jhist["p99"] = getPercentile(99.0);
+	return jhist;
+}
+
+//--------------------------------------------------------------
+int Histogram::_getBucketIndex( std::uint64_t aValue ) {
+	if( aValue < NUM_SUB_BUCKETS ) {
+		return (int)aValue;
+	}
+	int msb = 0;
+	auto tv = aValue;
+	while( tv > 1 ) {
+		tv = tv >> 1;
+		msb++;
+	}
+	// msb is at least 3, the next 3 bits select the sub bucket
+	int shift = msb - 3;
+	int sub = (int)((aValue >> shift) & (NUM_SUB_BUCKETS - 1));
+	return (msb - 2) * NUM_SUB_BUCKETS + sub;
+}
+
+//--------------------------------------------------------------
+std::uint64_t Histogram::_getBucketUpperBound( int aIndex ) {
+	if( aIndex < NUM_SUB_BUCKETS ) {
+		return (std::uint64_t)aIndex;
+	}
+	int msb = (aIndex / NUM_SUB_BUCKETS) + 2;
+	int sub = aIndex % NUM_SUB_BUCKETS;
+	int shift = msb - 3;
+	std::uint64_t lower = ((std::uint64_t)(NUM_SUB_BUCKETS + sub)) << shift;
+	return lower + ((std::uint64_t)1 << shift) - 1;
+}
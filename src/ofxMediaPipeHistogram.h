@@ -0,0 +1,63 @@
+//
+//  ofxMediaPipeHistogram.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofJson.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace ofx::MediaPipe {
+// Log linear histogram of unsigned values, ie. latencies in microseconds.
+// Every power of two is split into 8 buckets, so percentiles are accurate to about 12%.
+// Values can be added from one thread while another thread reads the percentiles.
+class Histogram {
+public:
+	static constexpr int NUM_SUB_BUCKETS = 8;
+	static constexpr int NUM_BUCKETS = 64 * NUM_SUB_BUCKETS;
+	
+	// adds the microseconds between construction and destruction to the histogram
+	class ScopedTimer {
+	public:
+		ScopedTimer( Histogram& ahist ) : mHist(ahist), mStart(std::chrono::steady_clock::now()) {}
+		~ScopedTimer() {
+			mHist.add( (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - mStart).count() );
+		}
+	protected:
+		Histogram& mHist;
+		std::chrono::steady_clock::time_point mStart;
+	};
+
+	Histogram();
+
+	void add( std::uint64_t aValue );
+	void reset();
+
+	std::uint64_t getCount() { return mCount.load(); }
+	std::uint64_t getMin();
+	std::uint64_t getMax() { return mMax.load(); }
+	double getMean();
+	// apercent in the range 0 - 100, returns the upper bound of the bucket containing the percentile
+	std::uint64_t getPercentile( double apercent );
+
+	std::string toString();
+	// count, mean, min, max and the 50th, 90th and 99th percentiles
+	ofJson jsonify();
+
+protected:
+	static int _getBucketIndex( std::uint64_t aValue );
+	static std::uint64_t _getBucketUpperBound( int aIndex );
+
+	std::array< std::atomic<std::uint64_t>, NUM_BUCKETS > mBuckets;
+	std::atomic<std::uint64_t> mCount;
+	std::atomic<std::uint64_t> mSum;
+	std::atomic<std::uint64_t> mMin;
+	std::atomic<std::uint64_t> mMax;
+};
+}
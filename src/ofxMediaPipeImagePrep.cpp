@@ -0,0 +1,256 @@
+//
+//  ofxMediaPipeImagePrep.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeImagePrep.h"
+#include <cstring>
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+void ImagePrep::setup( int aTargetWidth, int aTargetHeight, const ofRectangle& aRoi ) {
+	mTargetWidth = std::max(0, aTargetWidth);
+	mTargetHeight = std::max(0, aTargetHeight);
+
+	float rx = ofClamp( aRoi.x, 0.f, 1.f );
+	float ry = ofClamp( aRoi.y, 0.f, 1.f );
+	float rw = ofClamp( aRoi.width, 0.f, 1.f - rx );
+	float rh = ofClamp( aRoi.height, 0.f, 1.f - ry );
+	if( rw <= 0.f || rh <= 0.f ) {
+		rx = ry = 0.f;
+		rw = rh = 1.f;
+	}
+	mRoi.set( rx, ry, rw, rh );
+	mBFullRoi = (rx == 0.f && ry == 0.f && rw == 1.f && rh == 1.f);
+	mBEnabled = !mBFullRoi || mTargetWidth > 0 || mTargetHeight > 0;
+	mPixels.reset();
+}
+
+//--------------------------------------------------------------
+const ofPixels& ImagePrep::process( const ofPixels& apix ) {
+	mLastWidth = apix.getWidth();
+	mLastHeight = apix.getHeight();
+	if( !mBEnabled || !apix.isAllocated() ) {
+		return apix;
+	}
+
+	int pw = (int)apix.getWidth();
+	int ph = (int)apix.getHeight();
+	int sx = std::min( pw-1, (int)(mRoi.x * (float)pw) );
+	int sy = std::min( ph-1, (int)(mRoi.y * (float)ph) );
+	int sw = std::max( 1, std::min( pw-sx, (int)(mRoi.width * (float)pw + 0.5f) ) );
+	int sh = std::max( 1, std::min( ph-sy, (int)(mRoi.height * (float)ph + 0.5f) ) );
+
+	int tw = sw;
+	int th = sh;
+	if( mTargetWidth > 0 && mTargetHeight > 0 ) {
+		tw = mTargetWidth;
+		th = mTargetHeight;
+	} else if( mTargetWidth > 0 ) {
+		tw = mTargetWidth;
+		th = (int)((float)mTargetWidth * (float)sh / (float)sw + 0.5f);
+	} else if( mTargetHeight > 0 ) {
+		th = mTargetHeight;
+		tw = (int)((float)mTargetHeight * (float)sw / (float)sh + 0.5f);
+	}
+	// never scale up, media pipe scales to the model input on its own
+	tw = std::max( 1, std::min(tw, sw) );
+	th = std::max( 1, std::min(th, sh) );
+
+	if( tw == pw && th == ph ) {
+		return apix;
+	}
+
+	// the previous buffer is returned to the pool when it is replaced
+	mPixels = mPool.acquire( tw, th, apix.getNumChannels() );
+	if( tw == sw && th == sh ) {
+		_crop( apix, sx, sy, *mPixels );
+	} else {
+		sResize( apix, ofRectangle(sx, sy, sw, sh), *mPixels );
+	}
+	mLastWidth = tw;
+	mLastHeight = th;
+	return *mPixels;
+}
+
+//--------------------------------------------------------------
+void ImagePrep::mapToSource( float* axyz, size_t aNumPoints ) const {
+	if( mBFullRoi || !axyz ) {
+		return;
+	}
+	for( size_t i = 0; i < aNumPoints; i++ ) {
+		float* p = axyz + i * 3;
+		p[0] = mRoi.x + p[0] * mRoi.width;
+		p[1] = mRoi.y + p[1] * mRoi.height;
+		// z is on roughly the same scale as x
+		p[2] = p[2] * mRoi.width;
+	}
+}
+
+//--------------------------------------------------------------
+void ImagePrep::sResize( const ofPixels& aSrc, const ofRectangle& aSrcRect, ofPixels& aDst ) {
+	int sx = (int)aSrcRect.x;
+	int sy = (int)aSrcRect.y;
+	int sw = (int)aSrcRect.width;
+	int sh = (int)aSrcRect.height;
+	int dw = (int)aDst.getWidth();
+	int dh = (int)aDst.getHeight();
+	if( sw < 1 || sh < 1 || dw < 1 || dh < 1 || aSrc.getNumChannels() != aDst.getNumChannels() ) {
+		return;
+	}
+	if( sw >= dw * 2 || sh >= dh * 2 ) {
+		_resizeArea( aSrc, sx, sy, sw, sh, aDst );
+	} else {
+		_resizeBilinear( aSrc, sx, sy, sw, sh, aDst );
+	}
+}
+
+//--------------------------------------------------------------
+void ImagePrep::_resizeArea( const ofPixels& aSrc, int asx, int asy, int asw, int ash, ofPixels& aDst ) {
+	const int nch = (int)aSrc.getNumChannels();
+	const int dw = (int)aDst.getWidth();
+	const int dh = (int)aDst.getHeight();
+	const size_t srcStride = aSrc.getWidth() * nch;
+	const int rowLen = asw * nch;
+
+	// source columns of every destination column
+	std::vector<int> xstarts( dw+1 );
+	for( int x = 0; x <= dw; x++ ) {
+		xstarts[x] = (int)(((std::int64_t)x * asw) / dw);
+	}
+
+	// rows are summed into the accumulator first, the loop over the contiguous row vectorizes
+	std::vector<std::uint32_t> accum( rowLen );
+	const std::uint8_t* src = aSrc.getData();
+	std::uint8_t* dst = aDst.getData();
+
+	for( int y = 0; y < dh; y++ ) {
+		int ys = (int)(((std::int64_t)y * ash) / dh);
+		int ye = std::max( ys+1, (int)(((std::int64_t)(y+1) * ash) / dh) );
+
+		std::fill( accum.begin(), accum.end(), 0 );
+		std::uint32_t* acc = accum.data();
+		for( int r = ys; r < ye; r++ ) {
+			const std::uint8_t* row = src + (size_t)(asy + r) * srcStride + (size_t)asx * nch;
+			for( int i = 0; i < rowLen; i++ ) {
+				acc[i] += row[i];
+			}
+		}
+
+		const int numRows = ye - ys;
+		std::uint8_t* drow = dst + (size_t)y * dw * nch;
+		for( int x = 0; x < dw; x++ ) {
+			int xs = xstarts[x];
+			int xe = std::max( xs+1, xstarts[x+1] );
+			std::uint32_t count = (std::uint32_t)((xe - xs) * numRows);
+			std::uint32_t half = count / 2;
+			for( int c = 0; c < nch; c++ ) {
+				std::uint32_t sum = 0;
+				for( int sxi = xs; sxi < xe; sxi++ ) {
+					sum += acc[sxi * nch + c];
+				}
+				drow[x * nch + c] = (std::uint8_t)((sum + half) / count);
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ImagePrep::_resizeBilinear( const ofPixels& aSrc, int asx, int asy, int asw, int ash, ofPixels& aDst ) {
+	const int nch = (int)aSrc.getNumChannels();
+	const int dw = (int)aDst.getWidth();
+	const int dh = (int)aDst.getHeight();
+	const size_t srcStride = aSrc.getWidth() * nch;
+	const int dstRowLen = dw * nch;
+
+	// 8 bit fixed point weights, sampling at the pixel centers
+	std::vector<int> xoffsets( dstRowLen );
+	std::vector<std::uint16_t> xweights( dstRowLen );
+	float xscale = (float)asw / (float)dw;
+	for( int x = 0; x < dw; x++ ) {
+		float fx = ((float)x + 0.5f) * xscale - 0.5f;
+		int x0 = std::max( 0, std::min( asw-2, (int)std::floor(fx) ) );
+		int w = (int)((fx - (float)x0) * 256.f + 0.5f);
+		w = std::max( 0, std::min(256, w) );
+		if( asw < 2 ) {
+			x0 = 0;
+			w = 0;
+		}
+		for( int c = 0; c < nch; c++ ) {
+			xoffsets[x * nch + c] = (asx + x0) * nch + c;
+			xweights[x * nch + c] = (std::uint16_t)w;
+		}
+	}
+	const int nextOffset = asw < 2 ? 0 : nch;
+
+	// horizontally interpolated rows, scaled by 256
+	std::vector<std::uint16_t> row0( dstRowLen );
+	std::vector<std::uint16_t> row1( dstRowLen );
+	int row0Index = -1;
+	int row1Index = -1;
+
+	const std::uint8_t* src = aSrc.getData();
+	std::uint8_t* dst = aDst.getData();
+	float yscale = (float)ash / (float)dh;
+
+	auto interpRow = [&]( int asrcRow, std::vector<std::uint16_t>& aOut ) {
+		const std::uint8_t* srow = src + (size_t)(asy + asrcRow) * srcStride;
+		std::uint16_t* out = aOut.data();
+		for( int i = 0; i < dstRowLen; i++ ) {
+			const std::uint8_t* p = srow + xoffsets[i];
+			int w = xweights[i];
+			out[i] = (std::uint16_t)(p[0] * (256 - w) + p[nextOffset] * w);
+		}
+	};
+
+	for( int y = 0; y < dh; y++ ) {
+		float fy = ((float)y + 0.5f) * yscale - 0.5f;
+		int y0 = std::max( 0, std::min( ash-2, (int)std::floor(fy) ) );
+		int wy = (int)((fy - (float)y0) * 256.f + 0.5f);
+		wy = std::max( 0, std::min(256, wy) );
+		int y1 = y0 + 1;
+		if( ash < 2 ) {
+			y1 = y0 = 0;
+			wy = 0;
+		}
+
+		// consecutive destination rows usually share source rows
+		if( row0Index != y0 ) {
+			if( row1Index == y0 ) {
+				std::swap( row0, row1 );
+				std::swap( row0Index, row1Index );
+			} else {
+				interpRow( y0, row0 );
+				row0Index = y0;
+			}
+		}
+		if( row1Index != y1 ) {
+			interpRow( y1, row1 );
+			row1Index = y1;
+		}
+
+		const std::uint16_t* r0 = row0.data();
+		const std::uint16_t* r1 = row1.data();
+		const std::uint32_t w1 = (std::uint32_t)wy;
+		const std::uint32_t w0 = 256 - w1;
+		std::uint8_t* drow = dst + (size_t)y * dstRowLen;
+		for( int i = 0; i < dstRowLen; i++ ) {
+			drow[i] = (std::uint8_t)((r0[i] * w0 + r1[i] * w1 + 32768) >> 16);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void ImagePrep::_crop( const ofPixels& aSrc, int asx, int asy, ofPixels& aDst ) {
+	const size_t nch = aSrc.getNumChannels();
+	const size_t srcStride = aSrc.getWidth() * nch;
+	const size_t dstStride = aDst.getWidth() * nch;
+	const std::uint8_t* src = aSrc.getData() + (size_t)asy * srcStride + (size_t)asx * nch;
+	std::uint8_t* dst = aDst.getData();
+	for( size_t y = 0; y < aDst.getHeight(); y++ ) {
+		std::memcpy( dst + y * dstStride, src + y * srcStride, dstStride );
+	}
+}
@@ -0,0 +1,58 @@
+//
+//  ofxMediaPipeImagePrep.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofPixels.h"
+#include "ofRectangle.h"
+#include "ofxMediaPipePixelPool.h"
+#include <vector>
+
+namespace ofx::MediaPipe {
+// Crops the source to a region of interest and scales it down to the inference size before the
+// pixels are handed to media pipe, so large camera frames are not copied and converted at full size.
+// Keypoints are returned normalized to the processed image, mapToSource maps them back into
+// normalized coordinates of the full source.
+class ImagePrep {
+public:
+	// a target size of 0 keeps the size of the region, when only one is set the other keeps the aspect ratio.
+	// aRoi is normalized to the source, the pixels are never scaled up.
+	void setup( int aTargetWidth, int aTargetHeight, const ofRectangle& aRoi );
+	// true if process changes the pixels
+	bool isEnabled() const { return mBEnabled; }
+
+	// returns apix when there is nothing to do, otherwise pixels from the pool that are valid until the next call
+	const ofPixels& process( const ofPixels& apix );
+
+	const ofRectangle& getRoi() const { return mRoi; }
+	// size of the pixels returned by the last call to process
+	size_t getLastWidth() const { return mLastWidth; }
+	size_t getLastHeight() const { return mLastHeight; }
+
+	// maps normalized x,y,z triplets from the processed image into the source, in place
+	void mapToSource( float* axyz, size_t aNumPoints ) const;
+
+	// resizes the aSrcRect region of aSrc into aDst, which must be allocated with the target size and the same number of channels.
+	// Uses an area average when shrinking by 2 or more, bilinear otherwise.
+	static void sResize( const ofPixels& aSrc, const ofRectangle& aSrcRect, ofPixels& aDst );
+
+protected:
+	static void _resizeArea( const ofPixels& aSrc, int asx, int asy, int asw, int ash, ofPixels& aDst );
+	static void _resizeBilinear( const ofPixels& aSrc, int asx, int asy, int asw, int ash, ofPixels& aDst );
+	static void _crop( const ofPixels& aSrc, int asx, int asy, ofPixels& aDst );
+
+	bool mBEnabled = false;
+	bool mBFullRoi = true;
+	int mTargetWidth = 0;
+	int mTargetHeight = 0;
+	ofRectangle mRoi = ofRectangle(0, 0, 1, 1);
+
+	PixelPool mPool;
+	std::shared_ptr<ofPixels> mPixels;
+	size_t mLastWidth = 0;
+	size_t mLastHeight = 0;
+};
+}
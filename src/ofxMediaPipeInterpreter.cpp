@@ -0,0 +1,286 @@
+//
+//  ofxMediaPipeInterpreter.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeInterpreter.h"
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofLog.h"
+#include <unordered_map>
+
+using namespace ofx::MediaPipe;
+
+std::atomic<std::uint64_t> Interpreter::sNextId = 1;
+
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+namespace {
+//--------------------------------------------------------------
+PyThreadState* getCurrentThreadState() {
+#if PY_VERSION_HEX >= 0x030D0000
+	return PyThreadState_GetUnchecked();
+#else
+	return _PyThreadState_UncheckedGet();
+#endif
+}
+
+//--------------------------------------------------------------
+std::string fetchPythonError() {
+	std::string msg = "unknown error";
+	PyObject *ptype = nullptr, *pvalue = nullptr, *ptraceback = nullptr;
+	PyErr_Fetch( &ptype, &pvalue, &ptraceback );
+	if( pvalue ) {
+		PyObject* pstr = PyObject_Str( pvalue );
+		if( pstr ) {
+			const char* cstr = PyUnicode_AsUTF8( pstr );
+			if( cstr ) {
+				msg = cstr;
+			}
+			Py_DECREF( pstr );
+		}
+	}
+	Py_XDECREF( ptype );
+	Py_XDECREF( pvalue );
+	Py_XDECREF( ptraceback );
+	PyErr_Clear();
+	return msg;
+}
+}
+#endif
+
+//--------------------------------------------------------------
+Interpreter::ScopedActivate::ScopedActivate( Interpreter& ainterpreter ) {
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+	if( !ainterpreter.isIsolated() ) {
+		return;
+	}
+	PyThreadState* tstate = ainterpreter._getThreadState();
+	PyThreadState* current = getCurrentThreadState();
+	if( !tstate || current == tstate ) {
+		return;
+	}
+	mPreviousState = current;
+	if( mPreviousState ) {
+		// releases the GIL of the other interpreter
+		PyEval_SaveThread();
+	}
+	PyEval_RestoreThread( tstate );
+	mBActive = true;
+#endif
+}
+
+//--------------------------------------------------------------
+Interpreter::ScopedActivate::~ScopedActivate() {
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+	if( !mBActive ) {
+		return;
+	}
+	PyEval_SaveThread();
+	if( mPreviousState ) {
+		PyEval_RestoreThread( mPreviousState );
+	}
+#endif
+}
+
+//--------------------------------------------------------------
+std::string Interpreter::sGetStringForMode( Mode amode ) {
+	if( amode == MODE_ISOLATED ) {
+		return "ISOLATED";
+	} else if( amode == MODE_FREE_THREADED ) {
+		return "FREE_THREADED";
+	}
+	return "SHARED";
+}
+
+//--------------------------------------------------------------
+bool Interpreter::sIsModeSupported( Mode amode ) {
+	if( amode == MODE_ISOLATED ) {
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+		return true;
+#else
+		return false;
+#endif
+	} else if( amode == MODE_FREE_THREADED ) {
+#if defined(Py_GIL_DISABLED)
+		return true;
+#else
+		return false;
+#endif
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool Interpreter::sIsGilDisabled() {
+#if defined(Py_GIL_DISABLED)
+	if( !Py_IsInitialized() ) {
+		return false;
+	}
+	py::gil_scoped_acquire acquire;
+	try {
+		auto sys = py::module_::import("sys");
+		if( py::hasattr(sys, "_is_gil_enabled") ) {
+			return !sys.attr("_is_gil_enabled")().cast<bool>();
+		}
+	} catch( std::exception& e ) {
+		ofLogError("ofxMediaPipe::Interpreter") << "unable to check the GIL: " << e.what();
+	}
+#endif
+	return false;
+}
+
+//--------------------------------------------------------------
+Interpreter::Interpreter() {
+
+}
+
+//--------------------------------------------------------------
+Interpreter::~Interpreter() {
+	release();
+}
+
+//--------------------------------------------------------------
+bool Interpreter::setup( Mode arequestedMode ) {
+	release();
+	mRequestedMode = arequestedMode;
+	mMode = MODE_SHARED;
+
+	if( arequestedMode == MODE_SHARED ) {
+		return true;
+	}
+
+	if( !Py_IsInitialized() ) {
+		ofLogError("ofxMediaPipe::Interpreter") << "the main interpreter must be initialized before setup.";
+		return false;
+	}
+
+	if( !sIsModeSupported(arequestedMode) ) {
+		ofLogWarning("ofxMediaPipe::Interpreter") << sGetStringForMode(arequestedMode) << " is not supported by this python build, using the shared interpreter.";
+		return false;
+	}
+
+	if( arequestedMode == MODE_FREE_THREADED ) {
+		{
+			// media pipe turns the GIL back on when it is imported and does not support running without it
+			py::gil_scoped_acquire acquire;
+			try {
+				py::module_::import("mediapipe");
+			} catch( std::exception& e ) {
+				ofLogError("ofxMediaPipe::Interpreter") << "unable to import mediapipe: " << e.what();
+			}
+		}
+		if( !sIsGilDisabled() ) {
+			ofLogWarning("ofxMediaPipe::Interpreter") << "the GIL is enabled, using the shared interpreter.";
+			return false;
+		}
+		mMode = MODE_FREE_THREADED;
+		return true;
+	}
+
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+	py::gil_scoped_acquire acquire;
+	PyThreadState* mainState = PyThreadState_Get();
+
+	PyInterpreterConfig config = {};
+	config.use_main_obmalloc = 0;
+	config.allow_fork = 0;
+	config.allow_exec = 0;
+	config.allow_threads = 1;
+	config.allow_daemon_threads = 0;
+	config.check_multi_interp_extensions = 1;
+	config.gil = PyInterpreterConfig_OWN_GIL;
+
+	// releases the main GIL and returns holding the GIL of the new interpreter
+	PyThreadState* subState = nullptr;
+	PyStatus status = Py_NewInterpreterFromConfig( &subState, &config );
+	if( PyStatus_Exception(status) || !subState ) {
+		PyThreadState_Swap( mainState );
+		ofLogWarning("ofxMediaPipe::Interpreter") << "unable to create a sub interpreter: " << (status.err_msg ? status.err_msg : "") << ", using the shared interpreter.";
+		return false;
+	}
+
+	// extensions that only support a single interpreter fail to import with their own GIL
+	PyObject* mediapipe = PyImport_ImportModule("mediapipe");
+	if( !mediapipe ) {
+		auto msg = fetchPythonError();
+		Py_EndInterpreter( subState );
+		PyThreadState_Swap( mainState );
+		ofLogWarning("ofxMediaPipe::Interpreter") << "mediapipe can not be imported in a sub interpreter: " << msg << ", using the shared interpreter.";
+		return false;
+	}
+	Py_DECREF( mediapipe );
+
+	mId = sNextId++;
+	mState = PyThreadState_GetInterpreter( subState );
+	mMainThreadState = subState;
+	mSetupThreadId = std::this_thread::get_id();
+	mMode = MODE_ISOLATED;
+
+	PyEval_SaveThread();
+	PyEval_RestoreThread( mainState );
+	return true;
+#else
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+void Interpreter::release() {
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+	if( mMainThreadState && Py_IsInitialized() ) {
+		PyThreadState* current = getCurrentThreadState();
+		if( current ) {
+			PyEval_SaveThread();
+		}
+		PyEval_RestoreThread( mMainThreadState );
+		{
+			// the threads that used the interpreter have to be joined before release is called
+			std::lock_guard<std::mutex> lck(mMutex);
+			for( auto& tstate : mThreadStates ) {
+				PyThreadState_Clear( tstate );
+				PyThreadState_Delete( tstate );
+			}
+			mThreadStates.clear();
+		}
+		// Py_EndInterpreter leaves no current thread state
+		Py_EndInterpreter( mMainThreadState );
+		if( current ) {
+			PyEval_RestoreThread( current );
+		}
+	}
+#endif
+	mMainThreadState = nullptr;
+	mState = nullptr;
+	mMode = MODE_SHARED;
+}
+
+//--------------------------------------------------------------
+PyThreadState* Interpreter::_getThreadState() {
+#if defined(OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS)
+	if( !mState ) {
+		return nullptr;
+	}
+	// one thread state per thread and interpreter, created the first time the thread activates the interpreter
+	thread_local std::unordered_map<std::uint64_t, PyThreadState*> tThreadStates;
+	auto it = tThreadStates.find( mId );
+	if( it != tThreadStates.end() ) {
+		return it->second;
+	}
+	PyThreadState* tstate = nullptr;
+	if( mMainThreadState && std::this_thread::get_id() == mSetupThreadId ) {
+		tstate = mMainThreadState;
+	} else {
+		tstate = PyThreadState_New( mState );
+		std::lock_guard<std::mutex> lck(mMutex);
+		mThreadStates.push_back( tstate );
+	}
+	tThreadStates[mId] = tstate;
+	return tstate;
+#else
+	return nullptr;
+#endif
+}
+
+#endif
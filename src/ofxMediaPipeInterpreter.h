@@ -0,0 +1,95 @@
+//
+//  ofxMediaPipeInterpreter.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include <pybind11/embed.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// sub interpreters with their own GIL need python 3.12 (PEP 684) and a pybind11 that keeps its
+// internals per interpreter, otherwise pybind objects can not be used in more than one interpreter.
+#if PY_VERSION_HEX >= 0x030C0000 && defined(PYBIND11_HAS_SUBINTERPRETER_SUPPORT)
+#define OFX_MEDIAPIPE_HAS_ISOLATED_INTERPRETERS
+#endif
+
+namespace py = pybind11;
+
+namespace ofx::MediaPipe {
+// The python interpreter used by a tracker.
+// MODE_SHARED uses the main interpreter, all of the trackers take turns on its GIL.
+// MODE_ISOLATED creates a sub interpreter with its own GIL, so trackers on different threads run in parallel.
+// MODE_FREE_THREADED uses the main interpreter of a free threaded python build (3.13t), which has no GIL.
+// The requested mode falls back to MODE_SHARED when it is not available, see getMode().
+class Interpreter {
+public:
+	enum Mode {
+		MODE_SHARED=0,
+		MODE_ISOLATED,
+		MODE_FREE_THREADED
+	};
+
+	// makes the interpreter current on the calling thread and holds its GIL until destroyed.
+	// Does nothing when the interpreter is already current on the thread.
+	class ScopedActivate {
+	public:
+		ScopedActivate( Interpreter& ainterpreter );
+		~ScopedActivate();
+
+		ScopedActivate( const ScopedActivate& ) = delete;
+		ScopedActivate& operator=( const ScopedActivate& ) = delete;
+		
+		// false when the interpreter was already current on the thread
+		bool isActivated() const { return mBActive; }
+	protected:
+		PyThreadState* mPreviousState = nullptr;
+		bool mBActive = false;
+	};
+
+	static std::string sGetStringForMode( Mode amode );
+	// compile time support, does not check if media pipe can be imported
+	static bool sIsModeSupported( Mode amode );
+	// true for free threaded builds that are running without the GIL,
+	// importing an extension that is not marked as free threading safe turns the GIL back on.
+	static bool sIsGilDisabled();
+
+	Interpreter();
+	~Interpreter();
+
+	// the main interpreter must be initialized, returns false if the mode fell back to MODE_SHARED
+	bool setup( Mode arequestedMode );
+	// ends the sub interpreter, all python objects created in it must be released before calling
+	void release();
+
+	Mode getMode() { return mMode; }
+	Mode getRequestedMode() { return mRequestedMode; }
+	bool isIsolated() { return mMode == MODE_ISOLATED; }
+
+protected:
+	PyThreadState* _getThreadState();
+
+	Mode mMode = MODE_SHARED;
+	Mode mRequestedMode = MODE_SHARED;
+
+	// unique for every sub interpreter, so thread states of an ended interpreter are never reused
+	std::uint64_t mId = 0;
+	PyInterpreterState* mState = nullptr;
+	// created by setup on the calling thread
+	PyThreadState* mMainThreadState = nullptr;
+	std::thread::id mSetupThreadId;
+	// created for the other threads that activated the interpreter, deleted in release
+	std::mutex mMutex;
+	std::vector<PyThreadState*> mThreadStates;
+
+	static std::atomic<std::uint64_t> sNextId;
+};
+}
+#endif
@@ -0,0 +1,149 @@
+//
+//  ofxMediaPipeLandmarkPacker.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeLandmarkPacker.h"
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofLog.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+static py::object _getInternedString( const char* astr ) {
+	// interned strings are compared by pointer in the attribute lookup
+	return py::reinterpret_steal<py::object>( PyUnicode_InternFromString(astr) );
+}
+
+//--------------------------------------------------------------
+static bool _getAttrFloat( PyObject* aobj, PyObject* aname, float& aout ) {
+	PyObject* value = PyObject_GetAttr( aobj, aname );
+	if( !value ) {
+		return false;
+	}
+	double dvalue = PyFloat_AsDouble( value );
+	Py_DECREF( value );
+	if( dvalue == -1.0 && PyErr_Occurred() ) {
+		return false;
+	}
+	aout = (float)dvalue;
+	return true;
+}
+
+//--------------------------------------------------------------
+bool LandmarkPacker::packLandmarks( const py::handle& aLists, Landmarks& aOut ) {
+	aOut.counts.clear();
+	aOut.xyz.clear();
+	_setup();
+
+	try {
+		py::sequence lists = py::reinterpret_borrow<py::sequence>(aLists);
+		size_t numLists = py::len(lists);
+		aOut.counts.resize( numLists, 0 );
+
+		// size the buffer once, so that the landmarks are written in a single pass
+		std::vector<py::sequence> landmarkLists;
+		landmarkLists.reserve( numLists );
+		size_t total = 0;
+		for( size_t i = 0; i < numLists; i++ ) {
+			landmarkLists.push_back( lists[i].cast<py::sequence>() );
+			aOut.counts[i] = (int)py::len( landmarkLists.back() );
+			total += aOut.counts[i];
+		}
+		aOut.xyz.resize( total * 3 );
+
+		PyObject* names[3] = { py_x.ptr(), py_y.ptr(), py_z.ptr() };
+		float* dst = aOut.xyz.data();
+		for( auto& landmarks : landmarkLists ) {
+			for( py::handle lm : landmarks ) {
+				for( int k = 0; k < 3; k++ ) {
+					if( !_getAttrFloat( lm.ptr(), names[k], dst[k] ) ) {
+						throw py::error_already_set();
+					}
+				}
+				dst += 3;
+			}
+		}
+	} catch( const std::exception& e ) {
+		ofLogError("LandmarkPacker::packLandmarks") << e.what();
+		aOut.counts.clear();
+		aOut.xyz.clear();
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool LandmarkPacker::packCategories( const py::handle& aLists, Categories& aOut, bool aBWithNames ) {
+	aOut.counts.clear();
+	aOut.indices.clear();
+	aOut.scores.clear();
+	aOut.names.clear();
+	_setup();
+
+	try {
+		py::sequence lists = py::reinterpret_borrow<py::sequence>(aLists);
+		size_t numLists = py::len(lists);
+		aOut.counts.resize( numLists, 0 );
+		for( size_t i = 0; i < numLists; i++ ) {
+			py::sequence categories = lists[i].cast<py::sequence>();
+			aOut.counts[i] = (int)py::len(categories);
+			for( py::handle cat : categories ) {
+				float score = 0.f;
+				if( !_getAttrFloat( cat.ptr(), py_score.ptr(), score ) ) {
+					throw py::error_already_set();
+				}
+				PyObject* index = PyObject_GetAttr( cat.ptr(), py_index.ptr() );
+				if( !index ) {
+					throw py::error_already_set();
+				}
+				long lindex = PyLong_AsLong( index );
+				Py_DECREF( index );
+				if( lindex == -1 && PyErr_Occurred() ) {
+					throw py::error_already_set();
+				}
+				aOut.scores.push_back( score );
+				aOut.indices.push_back( (int)lindex );
+				if( aBWithNames ) {
+					aOut.names.push_back( py::reinterpret_steal<py::object>( PyObject_GetAttr(cat.ptr(), py_categoryName.ptr()) ).cast<std::string>() );
+				}
+			}
+		}
+	} catch( const std::exception& e ) {
+		ofLogError("LandmarkPacker::packCategories") << e.what();
+		aOut.counts.clear();
+		aOut.indices.clear();
+		aOut.scores.clear();
+		aOut.names.clear();
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void LandmarkPacker::release() {
+	py_x = py::object();
+	py_y = py::object();
+	py_z = py::object();
+	py_score = py::object();
+	py_index = py::object();
+	py_categoryName = py::object();
+}
+
+//--------------------------------------------------------------
+void LandmarkPacker::_setup() {
+	if( py_x ) {
+		return;
+	}
+	py_x = _getInternedString("x");
+	py_y = _getInternedString("y");
+	py_z = _getInternedString("z");
+	py_score = _getInternedString("score");
+	py_index = _getInternedString("index");
+	py_categoryName = _getInternedString("category_name");
+}
+
+#endif
@@ -0,0 +1,57 @@
+//
+//  ofxMediaPipeLandmarkPacker.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include <pybind11/embed.h>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace ofx::MediaPipe {
+// Flattens the nested landmark and category lists of the media pipe results into contiguous arrays.
+// The attributes are read through the python C api with interned names, which avoids creating a
+// new string for every attribute lookup, and the values are written straight into one buffer.
+// The GIL must be held when calling any of the functions.
+class LandmarkPacker {
+public:
+	// landmarks of all of the lists, ie. one list per hand, stored as x,y,z
+	struct Landmarks {
+		std::vector<int> counts;
+		std::vector<float> xyz;
+
+		size_t getNumLists() const { return counts.size(); }
+		size_t getTotalNum() const { return xyz.size() / 3; }
+	};
+
+	// categories of all of the lists, ie. handedness or face blend shapes
+	struct Categories {
+		std::vector<int> counts;
+		std::vector<int> indices;
+		std::vector<float> scores;
+		// only filled when requested, the names do not change between frames
+		std::vector<std::string> names;
+
+		size_t getNumLists() const { return counts.size(); }
+	};
+
+	bool packLandmarks( const py::handle& aLists, Landmarks& aOut );
+	bool packCategories( const py::handle& aLists, Categories& aOut, bool aBWithNames );
+
+	// releases the python objects, must be called with the GIL held before the interpreter is finalized
+	void release();
+
+protected:
+	void _setup();
+
+	py::object py_x, py_y, py_z;
+	py::object py_score, py_index, py_categoryName;
+};
+}
+#endif
@@ -0,0 +1,109 @@
+//
+//  ofxMediaPipeMappedFile.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeMappedFile.h"
+#include "ofLog.h"
+
+#if defined(TARGET_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+MappedFile::~MappedFile() {
+	close();
+}
+
+#if defined(TARGET_WIN32)
+//--------------------------------------------------------------
+bool MappedFile::open( const of::filesystem::path& afile ) {
+	close();
+	HANDLE file = CreateFileW( afile.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if( file == INVALID_HANDLE_VALUE ) {
+		ofLogVerbose("MappedFile::open") << "unable to open " << afile;
+		return false;
+	}
+	LARGE_INTEGER size;
+	if( !GetFileSizeEx(file, &size) || size.QuadPart == 0 ) {
+		CloseHandle( file );
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingW( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	if( !mapping ) {
+		CloseHandle( file );
+		return false;
+	}
+	void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+	if( !data ) {
+		CloseHandle( mapping );
+		CloseHandle( file );
+		return false;
+	}
+	mFileHandle = file;
+	mMappingHandle = mapping;
+	mData = static_cast<const char*>(data);
+	mSize = (std::uint64_t)size.QuadPart;
+	return true;
+}
+
+//--------------------------------------------------------------
+void MappedFile::close() {
+	if( mData ) {
+		UnmapViewOfFile( mData );
+	}
+	if( mMappingHandle ) {
+		CloseHandle( (HANDLE)mMappingHandle );
+	}
+	if( mFileHandle ) {
+		CloseHandle( (HANDLE)mFileHandle );
+	}
+	mData = nullptr;
+	mMappingHandle = nullptr;
+	mFileHandle = nullptr;
+	mSize = 0;
+}
+#else
+//--------------------------------------------------------------
+bool MappedFile::open( const of::filesystem::path& afile ) {
+	close();
+	int fd = ::open( afile.string().c_str(), O_RDONLY );
+	if( fd < 0 ) {
+		ofLogVerbose("MappedFile::open") << "unable to open " << afile;
+		return false;
+	}
+	struct stat st;
+	if( fstat(fd, &st) != 0 || st.st_size == 0 ) {
+		::close( fd );
+		return false;
+	}
+	void* data = mmap( nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	// the mapping keeps its own reference to the file
+	::close( fd );
+	if( data == MAP_FAILED ) {
+		ofLogVerbose("MappedFile::open") << "unable to map " << afile;
+		return false;
+	}
+	mData = static_cast<const char*>(data);
+	mSize = (std::uint64_t)st.st_size;
+	return true;
+}
+
+//--------------------------------------------------------------
+void MappedFile::close() {
+	if( mData ) {
+		munmap( (void*)mData, (size_t)mSize );
+	}
+	mData = nullptr;
+	mSize = 0;
+}
+#endif
@@ -0,0 +1,37 @@
+//
+//  ofxMediaPipeMappedFile.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofFileUtils.h"
+#include <cstdint>
+
+namespace ofx::MediaPipe {
+// Read only memory mapping of a file.
+// Pages are loaded by the os when they are touched, so opening a large recording does not read it.
+class MappedFile {
+public:
+	MappedFile() {}
+	~MappedFile();
+	MappedFile( const MappedFile& ) = delete;
+	MappedFile& operator=( const MappedFile& ) = delete;
+
+	bool open( const of::filesystem::path& afile );
+	void close();
+	bool isOpen() { return mData != nullptr; }
+
+	const char* getData() const { return mData; }
+	std::uint64_t getSize() const { return mSize; }
+
+protected:
+	const char* mData = nullptr;
+	std::uint64_t mSize = 0;
+#if defined(TARGET_WIN32)
+	void* mFileHandle = nullptr;
+	void* mMappingHandle = nullptr;
+#endif
+};
+}
@@ -340,119 +340,19 @@ void OscReceiver::update( ofEventArgs& args ) {
 		unsigned int numMessages = 0;
 		ofxOscMessage m;
 		while(mOSCRX->getNextMessage(m)) {
-			std::string address = m.getAddress();
-			
-			//ofLogNotice("OscReceiver::update") << "received data from " << address << " | " << ofGetFrameNum();
-//			auto vec = ofSplitString( address, "/", true, true );
-			// hm.setAddress("/ofxmp/frame");
-//			m.setAddress("/ofxmp/faces");
-//			m.setAddress("/ofxmp/hands");
-//			m.setAddress("/ofxmp/poses");
-			
-//			send the width and height from the osc sender
-			
-			bool bWorldPos = false;
-			std::optional<TrackedObject::TrackedObjectType> objType;
-			if( address == "/ofxmp/frame/video" ) {
-				if( m.getNumArgs() > 3 ) {
-					mVideoWidth = m.getArgAsInt(2);
-					mVideoHeight = m.getArgAsInt(3);
-					mVideoRect.setWidth(mVideoWidth);
-					mVideoRect.setHeight(mVideoHeight);
-				}
-			} else if( address == "/ofxmp/frame/faces" ) {
-				if( m.getNumArgs() > 3 ) {
-					auto& tinfo = getTrackedObjectInfo(TrackedObject::FACE);
-					tinfo.outRect.x = m.getArgAsInt(0);
-					tinfo.outRect.y = m.getArgAsInt(1);
-					tinfo.outRect.width = m.getArgAsInt(2);
-					tinfo.outRect.height = m.getArgAsInt(3);
-					
-				}
-			} else if( address == "/ofxmp/frame/hands" ) {
-				if( m.getNumArgs() > 3 ) {
-					auto& tinfo = getTrackedObjectInfo(TrackedObject::HAND);
-					tinfo.outRect.x = m.getArgAsInt(0);
-					tinfo.outRect.y = m.getArgAsInt(1);
-					tinfo.outRect.width = m.getArgAsInt(2);
-					tinfo.outRect.height = m.getArgAsInt(3);
+			if( mNumPartMessages > 0 ) {
+				// the messages of a part follow its /ofxmp/frame/part message, they were sent in the same bundle
+				mNumPartMessages--;
+				if( mPartFrame ) {
+					mPartFrame->messages.push_back( m );
 				}
-			} else if( address == "/ofxmp/frame/poses" ) {
-				if( m.getNumArgs() > 3 ) {
-					auto& tinfo = getTrackedObjectInfo(TrackedObject::POSE);
-					tinfo.outRect.x = m.getArgAsInt(0);
-					tinfo.outRect.y = m.getArgAsInt(1);
-					tinfo.outRect.width = m.getArgAsInt(2);
-					tinfo.outRect.height = m.getArgAsInt(3);
-				}
-			} else if( address == "/ofxmp/faces" ) {
-				objType = TrackedObject::FACE;
-			} else if( address == "/ofxmp/hands" ) {
-				objType = TrackedObject::HAND;
-			} else if( address == "/ofxmp/poses" ) {
-				objType = TrackedObject::POSE;
-			} else if( address == "/ofxmp/facesW" ) {
-				objType = TrackedObject::FACE;
-				bWorldPos = true;
-			} else if(address == "/ofxmp/handsW") {
-				objType = TrackedObject::HAND;
-				bWorldPos = true;
-			} else if(address == "/ofxmp/posesW") {
-				objType = TrackedObject::POSE;
-				bWorldPos = true;
-			}
-			
-			if( objType.has_value() && m.getNumArgs() > 2) {
-				
-				getTrackedObjectInfo(objType.value()).bHasNewData = true;
-				
-				std::shared_ptr<TrackedObject> tobj;
-				std::int64_t frame = m.getArgAsInt64(0);
-				std::int32_t tid = m.getArgAsInt32(1);
-				
-				if( objType.value() == TrackedObject::FACE ) {
-					tobj = getFace(tid);
-				} else if( objType.value() == TrackedObject::HAND ) {
-					tobj = getHand(tid);
-				} else if( objType.value() == TrackedObject::POSE ) {
-					tobj = getPose(tid);
-				}
-				
-				if( tobj ) {
-					
-					//ofLogNotice("MpOscReceiver") << "id: " << tid << " obj->id: " << tobj->ID << " age: " << tobj->age << " world: " << bWorldPos << " frame: " << frame << " obj frame: " << tobj->trackingData.mostRecentFrame << " | " << ofGetFrameNum();
-					
-					tobj->trackingData.bFoundThisFrame = true;
-					tobj->trackingData.numFramesNotFound = 0;
-					if( tobj->trackingData.mostRecentFrame < frame ) {
-						tobj->trackingData.mostRecentFrame = frame;
-						mFrame->setup(m, tobj, bWorldPos );
-						// now lets set the pos by multiplying the posN
-//						float tw = (float)getWidth(tobj->getType());
-//						float th = (float)getHeight(tobj->getType());
-						ofRectangle trect = getRect(tobj->getType());
-						for( auto& kp : tobj->keypoints ) {
-							
-							if( bWorldPos ) {
-								
-							} else {
-								kp.posN *= glm::vec3( mScaleX, mScaleY, mScaleX );
-							}
-							
-							kp.pos.x = kp.posN.x * trect.width + trect.x + mShiftX;
-							kp.pos.y = kp.posN.y * trect.height + trect.y + mShiftY;
-							kp.pos.z = kp.posN.z * trect.width;
-						}
-						tobj->updateFromKeypoints();
-					}
-					
-					if( bWorldPos ) {
-						tobj->trackingData.worldPositionsSet = true;
-					} else {
-						tobj->trackingData.positionsSet = true;
-						tobj->trackingData.fps.newFrame();
-					}
+				if( mNumPartMessages == 0 ) {
+					_endPart();
 				}
+			} else if( m.getAddress() == "/ofxmp/frame/part" ) {
+				_beginPart( m );
+			} else {
+				_processMessage( m );
 			}
 			
 			mTimeSinceReceivedData = 0.f;
@@ -493,6 +393,230 @@ void OscReceiver::update( ofEventArgs& args ) {
 	
 }
 
+#if defined(OF_ADDON_HAS_OFX_OSC)
+//--------------------------------------------------------------
+void OscReceiver::_processMessage( ofxOscMessage& m ) {
+	std::string address = m.getAddress();
+	
+	//ofLogNotice("OscReceiver::update") << "received data from " << address << " | " << ofGetFrameNum();
+//			auto vec = ofSplitString( address, "/", true, true );
+	// hm.setAddress("/ofxmp/frame");
+//			m.setAddress("/ofxmp/faces");
+//			m.setAddress("/ofxmp/hands");
+//			m.setAddress("/ofxmp/poses");
+	
+//			send the width and height from the osc sender
+	
+	bool bWorldPos = false;
+	std::optional<TrackedObject::TrackedObjectType> objType;
+	std::optional<TrackedObject::TrackedObjectType> packedType;
+	if( address == "/ofxmp/frame/video" ) {
+		if( m.getNumArgs() > 3 ) {
+			mVideoWidth = m.getArgAsInt(2);
+			mVideoHeight = m.getArgAsInt(3);
+			mVideoRect.setWidth(mVideoWidth);
+			mVideoRect.setHeight(mVideoHeight);
+		}
+	} else if( address == "/ofxmp/frame/faces" ) {
+		if( m.getNumArgs() > 3 ) {
+			auto& tinfo = getTrackedObjectInfo(TrackedObject::FACE);
+			tinfo.outRect.x = m.getArgAsInt(0);
+			tinfo.outRect.y = m.getArgAsInt(1);
+			tinfo.outRect.width = m.getArgAsInt(2);
+			tinfo.outRect.height = m.getArgAsInt(3);
+			
+		}
+	} else if( address == "/ofxmp/frame/hands" ) {
+		if( m.getNumArgs() > 3 ) {
+			auto& tinfo = getTrackedObjectInfo(TrackedObject::HAND);
+			tinfo.outRect.x = m.getArgAsInt(0);
+			tinfo.outRect.y = m.getArgAsInt(1);
+			tinfo.outRect.width = m.getArgAsInt(2);
+			tinfo.outRect.height = m.getArgAsInt(3);
+		}
+	} else if( address == "/ofxmp/frame/poses" ) {
+		if( m.getNumArgs() > 3 ) {
+			auto& tinfo = getTrackedObjectInfo(TrackedObject::POSE);
+			tinfo.outRect.x = m.getArgAsInt(0);
+			tinfo.outRect.y = m.getArgAsInt(1);
+			tinfo.outRect.width = m.getArgAsInt(2);
+			tinfo.outRect.height = m.getArgAsInt(3);
+		}
+	} else if( address == "/ofxmp/faces" ) {
+		objType = TrackedObject::FACE;
+	} else if( address == "/ofxmp/hands" ) {
+		objType = TrackedObject::HAND;
+	} else if( address == "/ofxmp/poses" ) {
+		objType = TrackedObject::POSE;
+	} else if( address == "/ofxmp/facesW" ) {
+		objType = TrackedObject::FACE;
+		bWorldPos = true;
+	} else if(address == "/ofxmp/handsW") {
+		objType = TrackedObject::HAND;
+		bWorldPos = true;
+	} else if(address == "/ofxmp/posesW") {
+		objType = TrackedObject::POSE;
+		bWorldPos = true;
+	} else if( address == "/ofxmp/facesP" ) {
+		packedType = TrackedObject::FACE;
+	} else if( address == "/ofxmp/handsP" ) {
+		packedType = TrackedObject::HAND;
+	} else if( address == "/ofxmp/posesP" ) {
+		packedType = TrackedObject::POSE;
+	}
+	
+	if( packedType.has_value() ) {
+		// every object of the frame with normalized and world positions in one blob
+		auto ptype = packedType.value();
+		getTrackedObjectInfo(ptype).bHasNewData = true;
+		mPackedObjects.clear();
+		mFrame->setup( m, ptype, [this, ptype]( std::int32_t aid, std::int64_t aframe ) -> std::shared_ptr<TrackedObject> {
+			std::shared_ptr<TrackedObject> tobj;
+			if( ptype == TrackedObject::FACE ) {
+				tobj = getFace(aid);
+			} else if( ptype == TrackedObject::HAND ) {
+				tobj = getHand(aid);
+			} else if( ptype == TrackedObject::POSE ) {
+				tobj = getPose(aid);
+			}
+			if( tobj ) {
+				tobj->trackingData.bFoundThisFrame = true;
+				tobj->trackingData.numFramesNotFound = 0;
+				if( tobj->trackingData.mostRecentFrame >= aframe ) {
+					return nullptr;
+				}
+				tobj->trackingData.mostRecentFrame = aframe;
+			}
+			return tobj;
+		}, mPackedObjects, &mDeltaCodecs[std::min((size_t)ptype, mDeltaCodecs.size()-1)] );
+		
+		auto& tinfo = getTrackedObjectInfo(ptype);
+		for( auto& tobj : mPackedObjects ) {
+			tinfo.timestampMicros = std::max( tinfo.timestampMicros, tobj->trackingData.timestampMicros );
+			_updateReceivedPositions( tobj, false );
+			tobj->trackingData.positionsSet = true;
+			tobj->trackingData.worldPositionsSet = true;
+			tobj->trackingData.fps.newFrame();
+		}
+	}
+	
+	if( objType.has_value() && m.getNumArgs() > 2) {
+		
+		getTrackedObjectInfo(objType.value()).bHasNewData = true;
+		
+		std::shared_ptr<TrackedObject> tobj;
+		std::int64_t frame = m.getArgAsInt64(0);
+		std::int32_t tid = m.getArgAsInt32(1);
+		
+		if( objType.value() == TrackedObject::FACE ) {
+			tobj = getFace(tid);
+		} else if( objType.value() == TrackedObject::HAND ) {
+			tobj = getHand(tid);
+		} else if( objType.value() == TrackedObject::POSE ) {
+			tobj = getPose(tid);
+		}
+		
+		if( tobj ) {
+			
+			//ofLogNotice("MpOscReceiver") << "id: " << tid << " obj->id: " << tobj->ID << " age: " << tobj->age << " world: " << bWorldPos << " frame: " << frame << " obj frame: " << tobj->trackingData.mostRecentFrame << " | " << ofGetFrameNum();
+			
+			tobj->trackingData.bFoundThisFrame = true;
+			tobj->trackingData.numFramesNotFound = 0;
+			if( tobj->trackingData.mostRecentFrame < frame ) {
+				tobj->trackingData.mostRecentFrame = frame;
+				mFrame->setup(m, tobj, bWorldPos );
+				auto& tinfo = getTrackedObjectInfo(objType.value());
+				tinfo.timestampMicros = std::max( tinfo.timestampMicros, tobj->trackingData.timestampMicros );
+				_updateReceivedPositions( tobj, bWorldPos );
+			}
+			
+			if( bWorldPos ) {
+				tobj->trackingData.worldPositionsSet = true;
+			} else {
+				tobj->trackingData.positionsSet = true;
+				tobj->trackingData.fps.newFrame();
+			}
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void OscReceiver::_beginPart( ofxOscMessage& am ) {
+	mPartFrame = nullptr;
+	mNumPartMessages = 0;
+	if( am.getNumArgs() < 5 ) {
+		return;
+	}
+	std::int64_t frameNum = am.getArgAsInt64(0);
+	int type = am.getArgAsInt32(1);
+	int part = am.getArgAsInt32(2);
+	int numParts = am.getArgAsInt32(3);
+	mNumPartMessages = std::max( 0, am.getArgAsInt32(4) );
+	if( type < 0 || type >= (int)mStagedFrames.size() || numParts < 1 || part < 0 || part >= numParts ) {
+		// the messages of the part are skipped
+		return;
+	}
+	
+	auto& staged = mStagedFrames[type];
+	if( staged.frameNum != frameNum || staged.numParts != numParts ) {
+		// a part of the frame before did not arrive, it is never applied
+		if( staged.numPartsReceived > 0 && staged.numPartsReceived < staged.numParts ) {
+			mNumIncompleteFrames++;
+		}
+		staged.frameNum = frameNum;
+		staged.numParts = numParts;
+		staged.numPartsReceived = 0;
+		staged.partsReceived.assign( numParts, false );
+		staged.messages.clear();
+	}
+	// parts that arrive twice and parts of a frame that was applied already are skipped
+	if( !staged.partsReceived[part] ) {
+		staged.partsReceived[part] = true;
+		mPartFrame = &staged;
+	}
+	if( mNumPartMessages == 0 ) {
+		_endPart();
+	}
+}
+
+//--------------------------------------------------------------
+void OscReceiver::_endPart() {
+	if( !mPartFrame ) {
+		return;
+	}
+	auto& staged = *mPartFrame;
+	mPartFrame = nullptr;
+	staged.numPartsReceived++;
+	if( staged.numPartsReceived == staged.numParts ) {
+		for( auto& sm : staged.messages ) {
+			_processMessage( sm );
+		}
+		staged.messages.clear();
+	}
+}
+#endif
+
+//--------------------------------------------------------------
+void OscReceiver::_updateReceivedPositions( const std::shared_ptr<TrackedObject>& aobj, bool abWorld ) {
+	// now lets set the pos by multiplying the posN
+//	float tw = (float)getWidth(aobj->getType());
+//	float th = (float)getHeight(aobj->getType());
+	ofRectangle trect = getRect(aobj->getType());
+	for( auto& kp : aobj->keypoints ) {
+		
+		if( abWorld ) {
+			
+		} else {
+			kp.posN *= glm::vec3( mScaleX, mScaleY, mScaleX );
+		}
+		
+		kp.pos.x = kp.posN.x * trect.width + trect.x + mShiftX;
+		kp.pos.y = kp.posN.y * trect.height + trect.y + mShiftY;
+		kp.pos.z = kp.posN.z * trect.width;
+	}
+	aobj->updateFromKeypoints();
+}
+
 //--------------------------------------------------------------
 bool OscReceiver::isSetupForRx() {
 #if defined(OF_ADDON_HAS_OFX_OSC)
@@ -522,6 +646,14 @@ void OscReceiver::setupForRecieve(int port) {
 	settings.reuse = true;
 	settings.start = true;
 	mOSCRX->setup(settings);
+	for( auto& codec : mDeltaCodecs ) {
+		codec.reset();
+	}
+	for( auto& staged : mStagedFrames ) {
+		staged = StagedFrame();
+	}
+	mPartFrame = nullptr;
+	mNumPartMessages = 0;
 #endif
 }
 
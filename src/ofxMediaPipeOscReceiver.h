@@ -8,6 +8,7 @@
 #pragma once
 #include "ofxMediaPipeFrame.h"
 #include "ofGraphicsBaseTypes.h"
+#include <array>
 #if defined(OF_ADDON_HAS_OFX_OSC)
 #include "ofxOsc.h"
 #endif
@@ -19,6 +20,8 @@ public:
 	struct TrackedObjectRxInfo {
 		ofRectangle outRect;
 		bool bHasNewData = false;
+		// newest capture timestamp received, in the clock of the sender
+		std::int64_t timestampMicros = 0;
 	};
 	
 	OscReceiver();
@@ -56,6 +59,9 @@ public:
 	
 	TrackedObjectRxInfo& getTrackedObjectInfo(ofx::MediaPipe::TrackedObject::TrackedObjectType atype);
 	
+	// frames that were sent in several bundles and not applied because one of them did not arrive
+	std::uint64_t getNumIncompleteFrames() { return mNumIncompleteFrames; }
+	
 protected:
 	void update( ofEventArgs& args );
 	
@@ -71,6 +77,15 @@ protected:
 	void deleteReceiver();
 	void setupForRecieve(int port);
 	
+#if defined(OF_ADDON_HAS_OFX_OSC)
+	void _processMessage( ofxOscMessage& m );
+	// the objects of a frame are sent in bundles that start with a /ofxmp/frame/part message,
+	// the messages are staged until every part of the frame arrived so that a frame is applied at once
+	void _beginPart( ofxOscMessage& am );
+	void _endPart();
+#endif
+	// sets the pixel positions from the normalized positions and updates the object
+	void _updateReceivedPositions( const std::shared_ptr<TrackedObject>& aobj, bool abWorld );
 	void _checkEnabled();
 	
 	void _addAppEventListeners();
@@ -104,6 +119,26 @@ protected:
 	std::vector< std::shared_ptr<ofx::MediaPipe::Pose>> mPoses, mValidPoses;
 	
 	std::shared_ptr<Frame> mFrame;
+	// objects decoded from a packed message, reused between messages
+	std::vector< std::shared_ptr<TrackedObject> > mPackedObjects;
+	// state of the delta encoded messages of HAND, FACE and POSE
+	std::array<DeltaCodec, 3> mDeltaCodecs;
+	
+#if defined(OF_ADDON_HAS_OFX_OSC)
+	struct StagedFrame {
+		std::int64_t frameNum = -1;
+		int numParts = 0;
+		int numPartsReceived = 0;
+		std::vector<bool> partsReceived;
+		std::vector<ofxOscMessage> messages;
+	};
+	// HAND, FACE and POSE
+	std::array<StagedFrame, 3> mStagedFrames;
+	// receives the messages of the current part, nullptr when they are skipped
+	StagedFrame* mPartFrame = nullptr;
+	int mNumPartMessages = 0;
+#endif
+	std::uint64_t mNumIncompleteFrames = 0;
 	
 };
 }
@@ -0,0 +1,151 @@
+//
+//  ofxMediaPipeOscSendQueue.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeOscSendQueue.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+OscSendQueue::OscSendQueue() {
+	mEnqueuePos = 0;
+	mDequeuePos = 0;
+	mBClosed = false;
+	for( auto& sequence : mTypeSequences ) {
+		sequence = 0;
+	}
+	setup( 8 );
+}
+
+//--------------------------------------------------------------
+OscSendQueue::~OscSendQueue() {
+	close();
+}
+
+//--------------------------------------------------------------
+void OscSendQueue::setup( size_t aDepth ) {
+	size_t capacity = 2;
+	while( capacity < aDepth ) {
+		capacity = capacity << 1;
+	}
+	if( capacity != mCapacity ) {
+		mSlots = std::make_unique<Slot[]>(capacity);
+		mCapacity = capacity;
+		mMask = capacity - 1;
+	}
+	for( size_t i = 0; i < mCapacity; i++ ) {
+		mSlots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	mEnqueuePos.store(0, std::memory_order_relaxed);
+	mDequeuePos.store(0, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------
+bool OscSendQueue::pop( Job& aOutJob ) {
+	while( !mBClosed.load() ) {
+		if( tryPop( aOutJob ) ) {
+			return true;
+		}
+		std::unique_lock<std::mutex> lck(mWaitMutex);
+		mCondition.wait( lck, [this]{ return mBClosed.load() || getNumQueued() > 0; });
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool OscSendQueue::tryPop( Job& aOutJob ) {
+	return _tryPop( &aOutJob );
+}
+
+//--------------------------------------------------------------
+bool OscSendQueue::isStale( const Job& ajob ) {
+	size_t type = std::min( (size_t)ajob.type, mTypeSequences.size()-1 );
+	return ajob.typeSequence < mTypeSequences[type].load();
+}
+
+//--------------------------------------------------------------
+void OscSendQueue::close() {
+	mBClosed = true;
+	_notify();
+}
+
+//--------------------------------------------------------------
+void OscSendQueue::open() {
+	mBClosed = false;
+}
+
+//--------------------------------------------------------------
+size_t OscSendQueue::getNumQueued() {
+	size_t dpos = mDequeuePos.load(std::memory_order_acquire);
+	size_t epos = mEnqueuePos.load(std::memory_order_acquire);
+	if( epos <= dpos ) {
+		return 0;
+	}
+	return std::min( epos - dpos, mCapacity );
+}
+
+//--------------------------------------------------------------
+OscSendQueue::Slot* OscSendQueue::_tryClaim( size_t& aOutPos ) {
+	size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+	for(;;) {
+		Slot* slot = &mSlots[pos & mMask];
+		size_t seq = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+		if( diff == 0 ) {
+			if( mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+				aOutPos = pos;
+				return slot;
+			}
+		} else if( diff < 0 ) {
+			// full
+			return nullptr;
+		} else {
+			pos = mEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void OscSendQueue::_publish( Slot* aslot, size_t apos ) {
+	aslot->sequence.store(apos + 1, std::memory_order_release);
+}
+
+//--------------------------------------------------------------
+bool OscSendQueue::_tryPop( Job* aOutJob ) {
+	Slot* slot = nullptr;
+	size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+	for(;;) {
+		slot = &mSlots[pos & mMask];
+		size_t seq = slot->sequence.load(std::memory_order_acquire);
+		intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+		if( diff == 0 ) {
+			if( mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+				break;
+			}
+		} else if( diff < 0 ) {
+			// empty
+			return false;
+		} else {
+			pos = mDequeuePos.load(std::memory_order_relaxed);
+		}
+	}
+
+	if( aOutJob ) {
+		// swap instead of copy, the slot gets the previous objects of aOutJob to fill next time
+		std::swap( *aOutJob, slot->job );
+	}
+	slot->sequence.store(pos + mMask + 1, std::memory_order_release);
+	return true;
+}
+
+//--------------------------------------------------------------
+void OscSendQueue::_notify() {
+	{
+		// taking the lock makes sure that a thread that just checked its wait condition is now waiting
+		std::lock_guard<std::mutex> lck(mWaitMutex);
+	}
+	mCondition.notify_all();
+}
@@ -0,0 +1,176 @@
+//
+//  ofxMediaPipeOscSendQueue.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofxMediaPipeFace.h"
+#include "ofxMediaPipeHand.h"
+#include "ofxMediaPipePose.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace ofx::MediaPipe {
+// Bounded queue of the frames that the OscSender hands to its send thread.
+// Every slot keeps the objects that were copied into it, so pushing a frame only copies the ids
+// and keypoints once the number of objects is stable. Slots are handed off with per slot sequence
+// numbers like the FrameQueue, so pushing and popping does not lock.
+// The newest frame of a type wins: when the queue is full the oldest frame is dropped, and a popped
+// frame is stale when a newer frame of its type was pushed after it, see isStale.
+// The messages are not pooled, ofxOscMessage allocates its arguments and copies blobs,
+// they are built by the send thread from the objects in the slot.
+class OscSendQueue {
+public:
+	template<typename T>
+	struct Objects {
+		std::vector<std::shared_ptr<T>> objects;
+		// objects of a frame with more objects, kept so that they are not allocated again
+		std::vector<std::shared_ptr<T>> spare;
+	};
+
+	struct Job {
+		TrackedObject::TrackedObjectType type = TrackedObject::HAND;
+		std::uint64_t frameNum = 0;
+		std::int64_t timestampMicros = 0;
+		// Frame::OscEncoding when the frame was pushed
+		int encoding = 0;
+		int keyframeInterval = 30;
+		// frames of the type pushed before and including this one
+		std::uint64_t typeSequence = 0;
+		// only the objects of type are valid
+		Objects<Face> faces;
+		Objects<Hand> hands;
+		Objects<Pose> poses;
+	};
+
+	OscSendQueue();
+	~OscSendQueue();
+
+	// the depth is rounded up to a power of two, with a minimum of 2.
+	// Should not be called while the queue is being used by another thread.
+	void setup( size_t aDepth );
+
+	// copies the ids and keypoints of the objects into the next free slot, drops the oldest frame when the queue is full
+	template<typename T>
+	bool push( const std::vector<std::shared_ptr<T>>& aobjs, TrackedObject::TrackedObjectType atype, std::uint64_t aFrameNum, std::int64_t aTimestampMicros, int aEncoding, int aKeyframeInterval ) {
+		if( mBClosed.load() ) {
+			return false;
+		}
+		size_t pos = 0;
+		Slot* slot = _tryClaim( pos );
+		while( !slot && !mBClosed.load() ) {
+			// make room by discarding the oldest frame, the consumer may have taken it in the meantime
+			if( _tryPop(nullptr) ) {
+				mNumDropped++;
+			}
+			slot = _tryClaim( pos );
+		}
+		if( !slot ) {
+			return false;
+		}
+		auto& job = slot->job;
+		job.type = atype;
+		job.frameNum = aFrameNum;
+		job.timestampMicros = aTimestampMicros;
+		job.encoding = aEncoding;
+		job.keyframeInterval = aKeyframeInterval;
+		job.typeSequence = ++mTypeSequences[std::min((size_t)atype, mTypeSequences.size()-1)];
+		_copyObjects( _getObjects<T>(job), aobjs );
+		_publish( slot, pos );
+		mNumPushed++;
+		_notify();
+		return true;
+	}
+
+	// swaps the oldest frame into aOutJob, waits until a frame is available or the queue is closed.
+	// aOutJob keeps its objects, they are handed back to the slot.
+	bool pop( Job& aOutJob );
+	bool tryPop( Job& aOutJob );
+	// a newer frame of the same type was pushed after ajob
+	bool isStale( const Job& ajob );
+
+	// wakes up the waiting thread, push and pop fail until the queue is opened again
+	void close();
+	void open();
+	bool isClosed() { return mBClosed.load(); }
+
+	size_t getCapacity() { return mCapacity; }
+	size_t getNumQueued();
+	std::uint64_t getNumPushed() { return mNumPushed.load(); }
+	// frames that were dropped because the queue was full
+	std::uint64_t getNumDropped() { return mNumDropped.load(); }
+
+	template<typename T>
+	static std::vector<std::shared_ptr<T>>& sGetObjects( Job& ajob ) {
+		return _getObjects<T>( ajob ).objects;
+	}
+
+protected:
+	struct Slot {
+		std::atomic<size_t> sequence;
+		Job job;
+	};
+
+	template<typename T>
+	static Objects<T>& _getObjects( Job& ajob ) {
+		if constexpr( std::is_same<T, Face>::value ) {
+			return ajob.faces;
+		} else if constexpr( std::is_same<T, Hand>::value ) {
+			return ajob.hands;
+		} else {
+			return ajob.poses;
+		}
+	}
+
+	template<typename T>
+	static void _copyObjects( Objects<T>& aDst, const std::vector<std::shared_ptr<T>>& aSrc ) {
+		auto& objs = aDst.objects;
+		while( objs.size() > aSrc.size() ) {
+			aDst.spare.push_back( std::move(objs.back()) );
+			objs.pop_back();
+		}
+		while( objs.size() < aSrc.size() ) {
+			if( aDst.spare.size() > 0 ) {
+				objs.push_back( std::move(aDst.spare.back()) );
+				aDst.spare.pop_back();
+			} else {
+				objs.push_back( std::make_shared<T>() );
+			}
+		}
+		// the osc messages only hold the id and the keypoints, assigning the keypoints reuses their allocation
+		for( size_t i = 0; i < aSrc.size(); i++ ) {
+			objs[i]->ID = aSrc[i]->ID;
+			objs[i]->keypoints = aSrc[i]->keypoints;
+		}
+	}
+
+	Slot* _tryClaim( size_t& aOutPos );
+	void _publish( Slot* aslot, size_t apos );
+	bool _tryPop( Job* aOutJob );
+	void _notify();
+
+	std::unique_ptr<Slot[]> mSlots;
+	size_t mCapacity = 0;
+	size_t mMask = 0;
+
+	// the producer and consumer positions are written by different threads, keep them on separate cache lines
+	alignas(64) std::atomic<size_t> mEnqueuePos;
+	alignas(64) std::atomic<size_t> mDequeuePos;
+
+	alignas(64) std::atomic<bool> mBClosed;
+	std::mutex mWaitMutex;
+	std::condition_variable mCondition;
+
+	// HAND, FACE and POSE
+	std::array<std::atomic<std::uint64_t>, 3> mTypeSequences;
+	std::atomic<std::uint64_t> mNumPushed = 0;
+	std::atomic<std::uint64_t> mNumDropped = 0;
+};
+}
@@ -22,12 +22,17 @@ OscSender::OscSender() {
 	mBroadcastIp.set("Broadcast IP", "127.0.0.1");
 	mBroadcastPort.set("Port", 9009, 8000, 12000);
 	mHeartbeatFreq.set("HeartBeatFreq", 1.0, 0.0, 5.0);
+	// 0 = args, 1 = float32 blob, 2 = float16 blob, 3 = quantized blob, 4 = delta blob, see Frame::OscEncoding
+	mEncoding.set("Encoding", (int)Frame::OSC_ENCODING_ARGS, (int)Frame::OSC_ENCODING_ARGS, (int)Frame::OSC_ENCODING_DELTA );
+	mKeyframeInterval.set("Keyframe Interval", 30, 1, 300 );
+	mBSendThread.set("Send Thread", true );
 #endif
 }
 
 //--------------------------------------------------------------
 OscSender::~OscSender() {
 	_remoteEventListeners();
+	_stopThread();
 }
 
 //--------------------------------------------------------------
@@ -39,6 +44,9 @@ ofParameterGroup& OscSender::getParams() {
 		mParams.add(mBroadcastIp);
 		mParams.add(mBroadcastPort);
 		mParams.add(mHeartbeatFreq);
+		mParams.add(mEncoding);
+		mParams.add(mKeyframeInterval);
+		mParams.add(mBSendThread);
 #endif
 	}
 
@@ -98,7 +106,9 @@ void OscSender::update( ofEventArgs& args ) {
 	
 	if (mHeartbeatFreq > 0.0f) {
 		mHeartBeatDelta += deltaTime;
-		if (mHeartBeatDelta >= mHeartbeatFreq) {
+		// the send thread holds the lock while it sends a frame, try again on the next update instead of waiting
+		std::unique_lock<std::mutex> lck( mSendMutex, std::defer_lock );
+		if (mHeartBeatDelta >= mHeartbeatFreq && lck.try_lock() ) {
 			mHeartBeatDelta = 0.0f;
 			
 			if( mOSCSend ) {
@@ -108,7 +118,7 @@ void OscSender::update( ofEventArgs& args ) {
 				hm.addIntArg(0);
 				hm.addIntArg(mVideoWidth);
 				hm.addIntArg(mVideoHeight);
-				mOSCSend->sendMessage(hm);
+				_sendMessage(hm);
 				
 				if( mOutRectMap.count(TrackedObject::FACE) > 0 ) {
 					ofxOscMessage hm;
@@ -117,7 +127,7 @@ void OscSender::update( ofEventArgs& args ) {
 					hm.addIntArg(mOutRectMap[TrackedObject::FACE].y);
 					hm.addIntArg(mOutRectMap[TrackedObject::FACE].width);
 					hm.addIntArg(mOutRectMap[TrackedObject::FACE].height);
-					mOSCSend->sendMessage(hm);
+					_sendMessage(hm);
 				}
 				
 				if( mOutRectMap.count(TrackedObject::HAND) > 0 ) {
@@ -127,7 +137,7 @@ void OscSender::update( ofEventArgs& args ) {
 					hm.addIntArg(mOutRectMap[TrackedObject::HAND].y);
 					hm.addIntArg(mOutRectMap[TrackedObject::HAND].width);
 					hm.addIntArg(mOutRectMap[TrackedObject::HAND].height);
-					mOSCSend->sendMessage(hm);
+					_sendMessage(hm);
 				}
 				
 				if( mOutRectMap.count(TrackedObject::POSE) > 0 ) {
@@ -137,7 +147,7 @@ void OscSender::update( ofEventArgs& args ) {
 					hm.addIntArg(mOutRectMap[TrackedObject::POSE].y);
 					hm.addIntArg(mOutRectMap[TrackedObject::POSE].width);
 					hm.addIntArg(mOutRectMap[TrackedObject::POSE].height);
-					mOSCSend->sendMessage(hm);
+					_sendMessage(hm);
 				}
 			}
 		}
@@ -153,12 +163,20 @@ void OscSender::setupForSend(std::string ipAddress, int port) {
 #if defined(OF_ADDON_HAS_OFX_OSC)
 	if( mOSCSend ) {deleteSender();}
 	_addAppEventListeners();
-	mOSCSend = make_shared<ofxOscSender>();
+	auto sender = make_shared<ofxOscSender>();
 	ofxOscSenderSettings settings;
 	settings.host = ipAddress;
 	settings.port = port;
 	
-	mOSCSend->setup(settings);
+	sender->setup(settings);
+	{
+		std::lock_guard<std::mutex> lck( mSendMutex );
+		mOSCSend = sender;
+		// a receiver on the new address needs a keyframe to decode the deltas
+		for( auto& codec : mDeltaCodecs ) {
+			codec.reset();
+		}
+	}
 	
 	// force send a heartbeat data on update 
 	mHeartBeatDelta = 9999.f;
@@ -178,6 +196,7 @@ bool OscSender::isSetupForSend() {
 //--------------------------------------------------------------
 void OscSender::deleteSender() {
 #if defined(OF_ADDON_HAS_OFX_OSC)
+	std::lock_guard<std::mutex> lck( mSendMutex );
 	if(mOSCSend) {
 		mOSCSend->clear();
 		mOSCSend.reset();
@@ -185,6 +204,142 @@ void OscSender::deleteSender() {
 #endif
 }
 
+//--------------------------------------------------------------
+void OscSender::setQueueDepth( size_t aDepth ) {
+	_stopThread();
+	mSendQueue.setup( aDepth );
+}
+
+//--------------------------------------------------------------
+void OscSender::_startThread() {
+	if( !mThread.joinable() ) {
+		mSendQueue.open();
+		mThread = std::thread( &OscSender::_threadedFunction, this );
+	}
+}
+
+//--------------------------------------------------------------
+void OscSender::_stopThread() {
+	if( mThread.joinable() ) {
+		mSendQueue.close();
+		mThread.join();
+		// frames that were not sent before the thread stopped
+		OscSendQueue::Job job;
+		while( mSendQueue.tryPop(job) ) {
+			mNumStale++;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+void OscSender::_threadedFunction() {
+#if defined(OF_ADDON_HAS_OFX_OSC)
+	OscSendQueue::Job job;
+	while( mSendQueue.pop(job) ) {
+		// a newer frame of the type is waiting, it replaces the positions of this one
+		if( mSendQueue.isStale(job) ) {
+			mNumStale++;
+			continue;
+		}
+		if( job.type == TrackedObject::FACE ) {
+			_send( OscSendQueue::sGetObjects<Face>(job), job.type, job.frameNum, job.timestampMicros, job.encoding, job.keyframeInterval );
+		} else if( job.type == TrackedObject::HAND ) {
+			_send( OscSendQueue::sGetObjects<Hand>(job), job.type, job.frameNum, job.timestampMicros, job.encoding, job.keyframeInterval );
+		} else if( job.type == TrackedObject::POSE ) {
+			_send( OscSendQueue::sGetObjects<Pose>(job), job.type, job.frameNum, job.timestampMicros, job.encoding, job.keyframeInterval );
+		}
+	}
+#endif
+}
+
+#if defined(OF_ADDON_HAS_OFX_OSC)
+//--------------------------------------------------------------
+void OscSender::_sendMessage( const ofxOscMessage& am ) {
+	mOSCSend->sendMessage( am );
+	mNumSent++;
+	// sendMessage wraps the message in a bundle: "#bundle", time tag and size
+	mNumBytesSent += 20 + _getNumBytes( am );
+}
+
+//--------------------------------------------------------------
+void OscSender::_sendBundles( std::uint64_t aFrameNum, TrackedObject::TrackedObjectType atype ) {
+	if( mBundleMessages.empty() ) {
+		return;
+	}
+	auto getPartMessage = [&]( size_t apart ) {
+		ofxOscMessage pm;
+		pm.setAddress("/ofxmp/frame/part");
+		pm.addInt64Arg( (std::int64_t)aFrameNum );
+		pm.addInt32Arg( (std::int32_t)atype );
+		pm.addInt32Arg( (std::int32_t)apart );
+		pm.addInt32Arg( (std::int32_t)mBundleSizes.size() );
+		pm.addInt32Arg( (std::int32_t)mBundleSizes[apart] );
+		return pm;
+	};
+	
+	// a bundle is "#bundle", a time tag and every message prefixed with its size
+	const size_t bundleHeaderSize = 16;
+	size_t maxSize = mMaxBundleSize.load();
+	mBundleSizes.assign( 1, 0 );
+	const size_t partSize = 4 + _getNumBytes( getPartMessage(0) );
+	
+	// first count the parts, the number is sent with every part
+	mBundleSizes.clear();
+	size_t bundleSize = maxSize;
+	for( const auto& m : mBundleMessages ) {
+		size_t numBytes = 4 + _getNumBytes( m );
+		if( mBundleSizes.empty() || bundleSize + numBytes > maxSize ) {
+			mBundleSizes.push_back( 0 );
+			bundleSize = bundleHeaderSize + partSize;
+		}
+		mBundleSizes.back()++;
+		bundleSize += numBytes;
+	}
+	
+	size_t index = 0;
+	for( size_t i = 0; i < mBundleSizes.size(); i++ ) {
+		ofxOscBundle bundle;
+		bundle.addMessage( getPartMessage(i) );
+		size_t numBytes = bundleHeaderSize + partSize;
+		for( size_t j = 0; j < mBundleSizes[i]; j++, index++ ) {
+			bundle.addMessage( mBundleMessages[index] );
+			numBytes += 4 + _getNumBytes( mBundleMessages[index] );
+		}
+		mOSCSend->sendBundle( bundle );
+		mNumSent += mBundleSizes[i] + 1;
+		mNumBytesSent += numBytes;
+	}
+}
+
+//--------------------------------------------------------------
+size_t OscSender::_getMaxPackedBlobSize() {
+	// "#bundle" and the time tag: 16, the part message with its size: 56,
+	// the packed message with its size, address, frame, timestamp and blob size: 48, blob padding: 3
+	const size_t overhead = 16 + 56 + 48 + 3;
+	return std::max( mMaxBundleSize.load(), overhead * 2 ) - overhead;
+}
+
+//--------------------------------------------------------------
+size_t OscSender::_getNumBytes( const ofxOscMessage& am ) {
+	// osc strings are null terminated and padded to 4 bytes
+	auto padded = []( size_t anum ) { return (anum + 4) & ~(size_t)3; };
+	size_t numBytes = padded( am.getAddress().size() ) + padded( am.getNumArgs() + 1 );
+	for( size_t i = 0; i < am.getNumArgs(); i++ ) {
+		auto type = am.getArgType(i);
+		if( type == OFXOSC_TYPE_INT64 ) {
+			numBytes += 8;
+		} else if( type == OFXOSC_TYPE_BLOB ) {
+			numBytes += 4 + ((am.getArgAsBlob(i).size() + 3) & ~(size_t)3);
+		} else if( type == OFXOSC_TYPE_STRING ) {
+			numBytes += padded( am.getArgAsString(i).size() );
+		} else {
+			numBytes += 4;
+		}
+	}
+	return numBytes;
+}
+#endif
+
 
 //--------------------------------------------------------------
 void OscSender::onIpParamChanged(string& aIp) {
@@ -7,6 +7,13 @@
 
 #pragma once
 #include "ofxMediaPipeFrame.h"
+#include "ofxMediaPipeTrace.h"
+#include "ofxMediaPipeOscSendQueue.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #if defined(OF_ADDON_HAS_OFX_OSC)
 #include "ofxOsc.h"
 #endif
@@ -27,31 +34,34 @@ public:
 //	void setHeight( const TrackedObject::TrackedObjectType& atype, int ah );
 	void setOutRect( const TrackedObject::TrackedObjectType& atype, ofRectangle arect );
 	
+	// sends ofGetElapsedTimeMicros() as the capture timestamp
 	template<typename T>
 	void send( const std::vector<std::shared_ptr<T>>& aobjs ) {
+		send( aobjs, (std::int64_t)ofGetElapsedTimeMicros() );
+	}
+	
+	// aTimestampMicros is the capture timestamp of the frame that the objects were detected in, see Tracker::getTimestampMicros().
+	// It is sent with every object, so that the receiver can measure the latency from the moment of capture.
+	// With the send thread the ids and keypoints are copied into the send queue and the messages are built and sent
+	// on the thread, otherwise they are sent before returning.
+	template<typename T>
+	void send( const std::vector<std::shared_ptr<T>>& aobjs, std::int64_t aTimestampMicros ) {
 #if !defined(OF_ADDON_HAS_OFX_OSC)
 		ofLogWarning("ofx::MediaPipe::OscSender") << "Make sure to define OF_ADDON_HAS_OFX_OSC and include the ofxOsc addon!";
 		return;
 		#endif
 		
-		if( !mFrame ) {
-			mFrame = std::make_shared<Frame>();
-		}
-		
 		#if defined(OF_ADDON_HAS_OFX_OSC)
-		if( mOSCSend ) {
-			auto frameNum = ofGetFrameNum();
-//			unsigned int counter = 0;
-			for( const auto& obj : aobjs ) {
-//				ofLogNotice("ofx::MediaPipe::OscSender") << " getting osx message for " << counter;
-				auto m = mFrame->getOscMessage(frameNum, obj);
-				mOSCSend->sendMessage( m );
-				
-				auto wm = mFrame->getOscMessageWorld(frameNum, obj);
-				mOSCSend->sendMessage( wm );
-				
-//				counter++;
+		if( mOSCSend && aobjs.size() > 0 ) {
+			auto type = aobjs.front()->getType();
+			std::uint64_t frameNum = ofGetFrameNum();
+			if( mBSendThread ) {
+				_startThread();
+				mSendQueue.push( aobjs, type, frameNum, aTimestampMicros, (int)getEncoding(), mKeyframeInterval.get() );
+				return;
 			}
+			_stopThread();
+			_send( aobjs, type, frameNum, aTimestampMicros, (int)getEncoding(), mKeyframeInterval.get() );
 		}
 		#endif
 	}
@@ -61,6 +71,32 @@ public:
 #endif
 	bool isSetupForSend();
 	
+	// Frame::OSC_ENCODING_ARGS by default, the packed encodings need an OscReceiver that knows them
+	void setEncoding( Frame::OscEncoding aencoding ) { mEncoding = (int)aencoding; }
+	Frame::OscEncoding getEncoding() { return (Frame::OscEncoding)std::clamp( mEncoding.get(), (int)Frame::OSC_ENCODING_ARGS, (int)Frame::OSC_ENCODING_DELTA ); }
+	// frames between keyframes of Frame::OSC_ENCODING_DELTA, a receiver that lost a message recovers on the next keyframe
+	void setKeyframeInterval( int aNumFrames ) { mKeyframeInterval = std::max( 1, aNumFrames ); }
+	int getKeyframeInterval() { return mKeyframeInterval; }
+	
+	// enabled by default, sending on a background thread keeps a slow network from stalling the caller of send
+	void setSendThreadEnabled( bool ab ) { mBSendThread = ab; }
+	bool isSendThreadEnabled() { return mBSendThread; }
+	// frames waiting for the send thread, when it falls behind the oldest frames are dropped. Stops the send thread.
+	void setQueueDepth( size_t aDepth );
+	OscSendQueue& getSendQueue() { return mSendQueue; }
+	
+	// osc messages and their size in bytes, including the heartbeat
+	std::uint64_t getNumSent() { return mNumSent.load(); }
+	std::uint64_t getNumBytesSent() { return mNumBytesSent.load(); }
+	// frames that were not sent because a newer frame of the same type was waiting or the queue was full
+	std::uint64_t getNumDropped() { return mNumStale.load() + mSendQueue.getNumDropped(); }
+	
+	// The messages of the objects of a frame are grouped into bundles of at most aNumBytes, 1472 by default,
+	// ie. an ethernet MTU of 1500 minus the IP and UDP headers. A message that is larger is sent in a bundle of its own.
+	// Packed frames that are larger are split into a message per group of objects.
+	void setMaxBundleSize( size_t aNumBytes ) { mMaxBundleSize = aNumBytes; }
+	size_t getMaxBundleSize() { return mMaxBundleSize.load(); }
+	
 	ofParameter<int>& getPortParam() { return mBroadcastPort;}
 	
 protected:
@@ -70,6 +106,55 @@ protected:
 	
 	void update( ofEventArgs& args );
 	
+	void _startThread();
+	void _stopThread();
+	void _threadedFunction();
+	
+#if defined(OF_ADDON_HAS_OFX_OSC)
+	template<typename T>
+	void _send( const std::vector<std::shared_ptr<T>>& aobjs, TrackedObject::TrackedObjectType atype, std::uint64_t aFrameNum, std::int64_t aTimestampMicros, int aEncoding, int aKeyframeInterval ) {
+		// held for the whole frame, so that the sender is not replaced while it is in use
+		std::lock_guard<std::mutex> lck( mSendMutex );
+		if( !mOSCSend ) {
+			return;
+		}
+		if( !mFrame ) {
+			mFrame = std::make_shared<Frame>();
+		}
+		if( Trace::sIsEnabled() ) {
+			Trace::sMark( Trace::STAGE_SEND, atype, aTimestampMicros );
+		}
+		auto encoding = (Frame::OscEncoding)aEncoding;
+		if( encoding != Frame::OSC_ENCODING_ARGS ) {
+			auto& codec = mDeltaCodecs[std::min((size_t)atype, mDeltaCodecs.size()-1)];
+			codec.setKeyframeInterval( aKeyframeInterval );
+			// a frame that does not fit into a bundle is split by object and sent in parts, like the args messages
+			mFrame->getOscMessagesPacked(aFrameNum, aobjs, aTimestampMicros, encoding, &codec, _getMaxPackedBlobSize(), mBundleMessages);
+			if( mBundleMessages.size() == 1 ) {
+				_sendMessage( mBundleMessages.front() );
+			} else {
+				_sendBundles( aFrameNum, atype );
+			}
+			return;
+		}
+		mBundleMessages.clear();
+		for( const auto& obj : aobjs ) {
+			mBundleMessages.push_back( mFrame->getOscMessage(aFrameNum, obj, aTimestampMicros) );
+			mBundleMessages.push_back( mFrame->getOscMessageWorld(aFrameNum, obj, aTimestampMicros) );
+		}
+		_sendBundles( aFrameNum, atype );
+	}
+	// call with mSendMutex locked
+	void _sendMessage( const ofxOscMessage& am );
+	// sends mBundleMessages in as few bundles as fit into mMaxBundleSize, each one starting with a /ofxmp/frame/part message:
+	// int64 frame, int32 type, int32 part, int32 number of parts, int32 number of messages that follow in the bundle.
+	// The receiver applies the frame once it received all of its parts. Call with mSendMutex locked.
+	void _sendBundles( std::uint64_t aFrameNum, TrackedObject::TrackedObjectType atype );
+	// blob size of a packed message that fits into a bundle with its part message
+	size_t _getMaxPackedBlobSize();
+	static size_t _getNumBytes( const ofxOscMessage& am );
+#endif
+	
 	void onIpParamChanged(std::string& aIp);
 	void onPortParamChanged(int& aPort);
 	
@@ -86,10 +171,29 @@ protected:
 	ofParameter<bool> mBOscEnabled;
 	ofParameter<int> mBroadcastPort;
 	ofParameter<float> mHeartbeatFreq;
+	ofParameter<int> mEncoding;
+	ofParameter<int> mKeyframeInterval;
+	ofParameter<bool> mBSendThread;
 	float mHeartBeatDelta = 0.0f;
 	float mNextCheckOscSenderTimef = 0.0f;
 	
 	std::shared_ptr<Frame> mFrame;
+	// HAND, FACE and POSE, used by the thread that sends
+	std::array<DeltaCodec, 3> mDeltaCodecs;
+	
+	OscSendQueue mSendQueue;
+	std::thread mThread;
+	// guards mOSCSend while the send thread uses it
+	std::mutex mSendMutex;
+	std::atomic<std::uint64_t> mNumSent = 0;
+	std::atomic<std::uint64_t> mNumBytesSent = 0;
+	std::atomic<std::uint64_t> mNumStale = 0;
+	std::atomic<size_t> mMaxBundleSize = 1472;
+#if defined(OF_ADDON_HAS_OFX_OSC)
+	// messages of the frame that is being sent, used by the thread that sends
+	std::vector<ofxOscMessage> mBundleMessages;
+	std::vector<size_t> mBundleSizes;
+#endif
 
 	
 	bool bHasEventListeners = false;
@@ -0,0 +1,540 @@
+//
+//  ofxMediaPipePixelConverter.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipePixelConverter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define OFX_MEDIAPIPE_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define OFX_MEDIAPIPE_TARGET_SSSE3
+#else
+// compiled for ssse3 on its own, so the rest of the addon does not need -mssse3
+#define OFX_MEDIAPIPE_TARGET_SSSE3 __attribute__((target("ssse3")))
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OFX_MEDIAPIPE_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace ofx::MediaPipe;
+
+namespace {
+std::atomic<bool> sBSimdEnabled = true;
+
+// BT.601 video range in fixed point, the results are in 1/32 steps.
+// The vector paths use 16 bit multiplies that keep the high half, ie. (a * b) >> 16.
+constexpr int kYScale = 19070;  // 1.164 * 32 * 512
+constexpr int kVToR = 26149;    // 1.596 * 32 * 512
+constexpr int kUToG = 6406;     // 0.391 * 32 * 512
+constexpr int kVToG = 13320;    // 0.813 * 32 * 512
+constexpr int kUToB = 16679;    // (2.018 - 1) * 32 * 512, the rest is added with a shift
+
+//--------------------------------------------------------------
+inline int mulHigh( int a, int b ) {
+	// matches _mm_mulhi_epi16 and vqdmulhq_s16 with a halved shift
+	return (a * b) >> 16;
+}
+
+//--------------------------------------------------------------
+inline std::uint8_t clampToByte( int av ) {
+	return (std::uint8_t)(av < 0 ? 0 : (av > 255 ? 255 : av));
+}
+
+//--------------------------------------------------------------
+inline void yuvToRgb( int ay, int au, int av, std::uint8_t* aDst ) {
+	int y = std::max( ay - 16, 0 );
+	int d = au - 128;
+	int e = av - 128;
+	int yc = mulHigh( y << 7, kYScale );
+	aDst[0] = clampToByte( (yc + mulHigh(e << 7, kVToR) + 16) >> 5 );
+	aDst[1] = clampToByte( (yc - mulHigh(d << 7, kUToG) - mulHigh(e << 7, kVToG) + 16) >> 5 );
+	aDst[2] = clampToByte( (yc + (d << 5) + mulHigh(d << 7, kUToB) + 16) >> 5 );
+}
+
+//--------------------------------------------------------------
+// offsets of r, g and b in a source pixel
+void getShuffleOrder( ofPixelFormat aformat, int& aBpp, int* aOrder ) {
+	aBpp = 3;
+	aOrder[0] = 0; aOrder[1] = 1; aOrder[2] = 2;
+	if( aformat == OF_PIXELS_BGR || aformat == OF_PIXELS_BGRA ) {
+		aOrder[0] = 2; aOrder[2] = 0;
+	} else if( aformat == OF_PIXELS_GRAY ) {
+		aOrder[0] = aOrder[1] = aOrder[2] = 0;
+	}
+	if( aformat == OF_PIXELS_BGRA || aformat == OF_PIXELS_RGBA ) {
+		aBpp = 4;
+	} else if( aformat == OF_PIXELS_GRAY ) {
+		aBpp = 1;
+	}
+}
+
+#if defined(OFX_MEDIAPIPE_X86)
+//--------------------------------------------------------------
+bool hasSsse3() {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid( info, 1 );
+	return (info[2] & (1 << 9)) != 0;
+#else
+	return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+// pshufb masks that gather 16 rgb pixels (3 output registers) from up to 4 input registers,
+// a mask byte with the high bit set writes a zero.
+struct ShuffleMasks {
+	alignas(16) std::uint8_t masks[3][4][16];
+	bool used[3][4];
+};
+
+//--------------------------------------------------------------
+ShuffleMasks makePixelMasks( int aBpp, const int* aOrder ) {
+	ShuffleMasks sm;
+	for( int k = 0; k < 3; k++ ) {
+		for( int j = 0; j < 4; j++ ) {
+			sm.used[k][j] = false;
+			for( int i = 0; i < 16; i++ ) {
+				int out = k * 16 + i;
+				int src = (out / 3) * aBpp + aOrder[out % 3];
+				bool bInReg = (src / 16 == j);
+				sm.masks[k][j][i] = bInReg ? (std::uint8_t)(src % 16) : 0x80;
+				sm.used[k][j] = sm.used[k][j] || bInReg;
+			}
+		}
+	}
+	return sm;
+}
+
+//--------------------------------------------------------------
+// the inputs are the r, g and b planes of 16 pixels
+ShuffleMasks makePlaneMasks() {
+	ShuffleMasks sm;
+	for( int k = 0; k < 3; k++ ) {
+		for( int j = 0; j < 4; j++ ) {
+			sm.used[k][j] = false;
+			for( int i = 0; i < 16; i++ ) {
+				int out = k * 16 + i;
+				bool bInReg = (out % 3 == j);
+				sm.masks[k][j][i] = bInReg ? (std::uint8_t)(out / 3) : 0x80;
+				sm.used[k][j] = sm.used[k][j] || bInReg;
+			}
+		}
+	}
+	return sm;
+}
+
+//--------------------------------------------------------------
+OFX_MEDIAPIPE_TARGET_SSSE3 inline void storeShuffled( const __m128i* aIn, int aNumIn, const ShuffleMasks& asm_, std::uint8_t* aDst ) {
+	for( int k = 0; k < 3; k++ ) {
+		__m128i out = _mm_setzero_si128();
+		for( int j = 0; j < aNumIn; j++ ) {
+			if( asm_.used[k][j] ) {
+				__m128i mask = _mm_load_si128( (const __m128i*)asm_.masks[k][j] );
+				out = _mm_or_si128( out, _mm_shuffle_epi8(aIn[j], mask) );
+			}
+		}
+		_mm_storeu_si128( (__m128i*)(aDst + k * 16), out );
+	}
+}
+
+//--------------------------------------------------------------
+OFX_MEDIAPIPE_TARGET_SSSE3 size_t shuffleToRgbSsse3( const std::uint8_t* aSrc, std::uint8_t* aDst, size_t aNumPixels, int aBpp, const ShuffleMasks& asm_ ) {
+	size_t i = 0;
+	__m128i in[4];
+	for( ; i + 16 <= aNumPixels; i += 16 ) {
+		const std::uint8_t* src = aSrc + i * aBpp;
+		for( int j = 0; j < aBpp; j++ ) {
+			in[j] = _mm_loadu_si128( (const __m128i*)(src + j * 16) );
+		}
+		storeShuffled( in, aBpp, asm_, aDst + i * 3 );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+OFX_MEDIAPIPE_TARGET_SSSE3 inline void yuvToRgb8Ssse3( __m128i ay, __m128i au, __m128i av, __m128i& ar, __m128i& ag, __m128i& ab ) {
+	// 8 pixels in 16 bit lanes
+	const __m128i zero = _mm_setzero_si128();
+	__m128i y = _mm_max_epi16( _mm_sub_epi16(ay, _mm_set1_epi16(16)), zero );
+	__m128i d = _mm_sub_epi16( au, _mm_set1_epi16(128) );
+	__m128i e = _mm_sub_epi16( av, _mm_set1_epi16(128) );
+	__m128i d7 = _mm_slli_epi16( d, 7 );
+	__m128i e7 = _mm_slli_epi16( e, 7 );
+	__m128i yc = _mm_add_epi16( _mm_mulhi_epi16(_mm_slli_epi16(y, 7), _mm_set1_epi16(kYScale)), _mm_set1_epi16(16) );
+
+	ar = _mm_add_epi16( yc, _mm_mulhi_epi16(e7, _mm_set1_epi16(kVToR)) );
+	ag = _mm_sub_epi16( _mm_sub_epi16(yc, _mm_mulhi_epi16(d7, _mm_set1_epi16(kUToG))), _mm_mulhi_epi16(e7, _mm_set1_epi16(kVToG)) );
+	ab = _mm_add_epi16( _mm_add_epi16(yc, _mm_slli_epi16(d, 5)), _mm_mulhi_epi16(d7, _mm_set1_epi16(kUToB)) );
+	ar = _mm_srai_epi16( ar, 5 );
+	ag = _mm_srai_epi16( ag, 5 );
+	ab = _mm_srai_epi16( ab, 5 );
+}
+
+//--------------------------------------------------------------
+OFX_MEDIAPIPE_TARGET_SSSE3 size_t yuvRowToRgbSsse3( const std::uint8_t* ay, const std::uint8_t* au, const std::uint8_t* av, std::uint8_t* aDst, size_t aWidth, const ShuffleMasks& asm_ ) {
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+	__m128i planes[3];
+	for( ; i + 16 <= aWidth; i += 16 ) {
+		__m128i y = _mm_loadu_si128( (const __m128i*)(ay + i) );
+		// one chroma sample for every two pixels
+		__m128i u = _mm_loadl_epi64( (const __m128i*)(au + i / 2) );
+		__m128i v = _mm_loadl_epi64( (const __m128i*)(av + i / 2) );
+		u = _mm_unpacklo_epi8( u, u );
+		v = _mm_unpacklo_epi8( v, v );
+
+		__m128i rlo, glo, blo, rhi, ghi, bhi;
+		yuvToRgb8Ssse3( _mm_unpacklo_epi8(y, zero), _mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(v, zero), rlo, glo, blo );
+		yuvToRgb8Ssse3( _mm_unpackhi_epi8(y, zero), _mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(v, zero), rhi, ghi, bhi );
+
+		// packus clamps to 0 - 255
+		planes[0] = _mm_packus_epi16( rlo, rhi );
+		planes[1] = _mm_packus_epi16( glo, ghi );
+		planes[2] = _mm_packus_epi16( blo, bhi );
+		storeShuffled( planes, 3, asm_, aDst + i * 3 );
+	}
+	return i;
+}
+#endif
+
+#if defined(OFX_MEDIAPIPE_NEON)
+//--------------------------------------------------------------
+size_t shuffleToRgbNeon( const std::uint8_t* aSrc, std::uint8_t* aDst, size_t aNumPixels, int aBpp, const int* aOrder ) {
+	size_t i = 0;
+	uint8x16x3_t out;
+	for( ; i + 16 <= aNumPixels; i += 16 ) {
+		const std::uint8_t* src = aSrc + i * aBpp;
+		if( aBpp == 1 ) {
+			uint8x16_t g = vld1q_u8( src );
+			out.val[0] = out.val[1] = out.val[2] = g;
+		} else if( aBpp == 3 ) {
+			uint8x16x3_t in = vld3q_u8( src );
+			out.val[0] = in.val[aOrder[0]];
+			out.val[1] = in.val[aOrder[1]];
+			out.val[2] = in.val[aOrder[2]];
+		} else {
+			uint8x16x4_t in = vld4q_u8( src );
+			out.val[0] = in.val[aOrder[0]];
+			out.val[1] = in.val[aOrder[1]];
+			out.val[2] = in.val[aOrder[2]];
+		}
+		vst3q_u8( aDst + i * 3, out );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+inline void yuvToRgb8Neon( uint8x8_t ay, uint8x8_t au, uint8x8_t av, uint8x8_t& ar, uint8x8_t& ag, uint8x8_t& ab ) {
+	// vqdmulh doubles the product, so the inputs are shifted by one less than on x86
+	int16x8_t y = vmaxq_s16( vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(ay)), vdupq_n_s16(16)), vdupq_n_s16(0) );
+	int16x8_t d = vsubq_s16( vreinterpretq_s16_u16(vmovl_u8(au)), vdupq_n_s16(128) );
+	int16x8_t e = vsubq_s16( vreinterpretq_s16_u16(vmovl_u8(av)), vdupq_n_s16(128) );
+	int16x8_t d6 = vshlq_n_s16( d, 6 );
+	int16x8_t e6 = vshlq_n_s16( e, 6 );
+	int16x8_t yc = vqdmulhq_n_s16( vshlq_n_s16(y, 6), kYScale );
+
+	int16x8_t r = vaddq_s16( yc, vqdmulhq_n_s16(e6, kVToR) );
+	int16x8_t g = vsubq_s16( vsubq_s16(yc, vqdmulhq_n_s16(d6, kUToG)), vqdmulhq_n_s16(e6, kVToG) );
+	int16x8_t b = vaddq_s16( vaddq_s16(yc, vshlq_n_s16(d, 5)), vqdmulhq_n_s16(d6, kUToB) );
+	// rounds by adding 16, shifts and clamps to 0 - 255
+	ar = vqrshrun_n_s16( r, 5 );
+	ag = vqrshrun_n_s16( g, 5 );
+	ab = vqrshrun_n_s16( b, 5 );
+}
+
+//--------------------------------------------------------------
+size_t yuvRowToRgbNeon( const std::uint8_t* ay, const std::uint8_t* au, const std::uint8_t* av, std::uint8_t* aDst, size_t aWidth ) {
+	size_t i = 0;
+	for( ; i + 16 <= aWidth; i += 16 ) {
+		uint8x16_t y = vld1q_u8( ay + i );
+		// one chroma sample for every two pixels
+		uint8x8x2_t u = vzip_u8( vld1_u8(au + i / 2), vld1_u8(au + i / 2) );
+		uint8x8x2_t v = vzip_u8( vld1_u8(av + i / 2), vld1_u8(av + i / 2) );
+		uint8x8_t rlo, glo, blo, rhi, ghi, bhi;
+		yuvToRgb8Neon( vget_low_u8(y), u.val[0], v.val[0], rlo, glo, blo );
+		yuvToRgb8Neon( vget_high_u8(y), u.val[1], v.val[1], rhi, ghi, bhi );
+		uint8x16x3_t out;
+		out.val[0] = vcombine_u8( rlo, rhi );
+		out.val[1] = vcombine_u8( glo, ghi );
+		out.val[2] = vcombine_u8( blo, bhi );
+		vst3q_u8( aDst + i * 3, out );
+	}
+	return i;
+}
+#endif
+
+//--------------------------------------------------------------
+bool useSsse3() {
+#if defined(OFX_MEDIAPIPE_X86)
+	static const bool bHasSsse3 = hasSsse3();
+	return bHasSsse3 && sBSimdEnabled.load();
+#else
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+bool useNeon() {
+#if defined(OFX_MEDIAPIPE_NEON)
+	return sBSimdEnabled.load();
+#else
+	return false;
+#endif
+}
+}
+
+//--------------------------------------------------------------
+std::string PixelConverter::sGetStringForFormat( ofPixelFormat aformat ) {
+	switch( aformat ) {
+		case OF_PIXELS_GRAY: return "GRAY";
+		case OF_PIXELS_GRAY_ALPHA: return "GRAY_ALPHA";
+		case OF_PIXELS_RGB: return "RGB";
+		case OF_PIXELS_BGR: return "BGR";
+		case OF_PIXELS_RGBA: return "RGBA";
+		case OF_PIXELS_BGRA: return "BGRA";
+		case OF_PIXELS_RGB565: return "RGB565";
+		case OF_PIXELS_NV12: return "NV12";
+		case OF_PIXELS_NV21: return "NV21";
+		case OF_PIXELS_YV12: return "YV12";
+		case OF_PIXELS_I420: return "I420";
+		case OF_PIXELS_YUY2: return "YUY2";
+		case OF_PIXELS_UYVY: return "UYVY";
+		default: break;
+	}
+	return "UNKNOWN";
+}
+
+//--------------------------------------------------------------
+bool PixelConverter::sIsSupported( ofPixelFormat aformat ) {
+	switch( aformat ) {
+		case OF_PIXELS_RGB:
+		case OF_PIXELS_RGBA:
+		case OF_PIXELS_BGR:
+		case OF_PIXELS_BGRA:
+		case OF_PIXELS_GRAY:
+		case OF_PIXELS_NV12:
+		case OF_PIXELS_NV21:
+		case OF_PIXELS_I420:
+		case OF_PIXELS_YV12:
+		case OF_PIXELS_YUY2:
+		case OF_PIXELS_UYVY:
+			return true;
+		default:
+			break;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+bool PixelConverter::sIsPassThrough( ofPixelFormat aformat ) {
+	return aformat == OF_PIXELS_RGB || aformat == OF_PIXELS_RGBA;
+}
+
+//--------------------------------------------------------------
+bool PixelConverter::sCanConvert( const ofPixels& apix ) {
+	if( !apix.isAllocated() || !sIsSupported(apix.getPixelFormat()) ) {
+		return false;
+	}
+	auto format = apix.getPixelFormat();
+	bool bEvenWidth = (apix.getWidth() % 2) == 0;
+	bool bEvenHeight = (apix.getHeight() % 2) == 0;
+	if( format == OF_PIXELS_YUY2 || format == OF_PIXELS_UYVY ) {
+		return bEvenWidth;
+	}
+	if( format == OF_PIXELS_NV12 || format == OF_PIXELS_NV21 || format == OF_PIXELS_I420 || format == OF_PIXELS_YV12 ) {
+		return bEvenWidth && bEvenHeight;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool PixelConverter::sConvertToRgb( const ofPixels& aSrc, ofPixels& aDst ) {
+	if( !sCanConvert(aSrc) ) {
+		return false;
+	}
+	if( aDst.getWidth() != aSrc.getWidth() || aDst.getHeight() != aSrc.getHeight() || aDst.getNumChannels() != 3 ) {
+		return false;
+	}
+
+	const size_t w = aSrc.getWidth();
+	const size_t h = aSrc.getHeight();
+	const std::uint8_t* src = aSrc.getData();
+	std::uint8_t* dst = aDst.getData();
+	auto format = aSrc.getPixelFormat();
+
+	switch( format ) {
+		case OF_PIXELS_RGB:
+			memcpy( dst, src, w * h * 3 );
+			return true;
+		case OF_PIXELS_RGBA:
+		case OF_PIXELS_BGR:
+		case OF_PIXELS_BGRA:
+		case OF_PIXELS_GRAY:
+			// no padding between the rows
+			_shuffleToRgb( src, dst, w * h, format );
+			return true;
+		default:
+			break;
+	}
+
+	const size_t cw = w / 2;
+	const size_t ch = h / 2;
+	const std::uint8_t* yPlane = src;
+
+	if( format == OF_PIXELS_I420 || format == OF_PIXELS_YV12 ) {
+		const std::uint8_t* uPlane = src + w * h;
+		const std::uint8_t* vPlane = uPlane + cw * ch;
+		if( format == OF_PIXELS_YV12 ) {
+			std::swap( uPlane, vPlane );
+		}
+		for( size_t y = 0; y < h; y++ ) {
+			_yuvRowToRgb( yPlane + y * w, uPlane + (y / 2) * cw, vPlane + (y / 2) * cw, dst + y * w * 3, w );
+		}
+		return true;
+	}
+
+	// the interleaved chroma is split into planes one row at a time
+	std::vector<std::uint8_t> rowBuffer( w + cw * 2 );
+	std::uint8_t* uRow = rowBuffer.data();
+	std::uint8_t* vRow = uRow + cw;
+	std::uint8_t* yRow = vRow + cw;
+
+	if( format == OF_PIXELS_NV12 || format == OF_PIXELS_NV21 ) {
+		const std::uint8_t* uvPlane = src + w * h;
+		int uOffset = (format == OF_PIXELS_NV12) ? 0 : 1;
+		int vOffset = 1 - uOffset;
+		for( size_t y = 0; y < h; y++ ) {
+			// rows share the chroma with their pair
+			if( (y % 2) == 0 ) {
+				const std::uint8_t* uv = uvPlane + (y / 2) * w;
+				for( size_t x = 0; x < cw; x++ ) {
+					uRow[x] = uv[x * 2 + uOffset];
+					vRow[x] = uv[x * 2 + vOffset];
+				}
+			}
+			_yuvRowToRgb( yPlane + y * w, uRow, vRow, dst + y * w * 3, w );
+		}
+		return true;
+	}
+
+	if( format == OF_PIXELS_YUY2 || format == OF_PIXELS_UYVY ) {
+		// YUY2 is Y0 U Y1 V, UYVY is U Y0 V Y1
+		int yOffset = (format == OF_PIXELS_YUY2) ? 0 : 1;
+		int cOffset = 1 - yOffset;
+		for( size_t y = 0; y < h; y++ ) {
+			const std::uint8_t* row = src + y * w * 2;
+			for( size_t x = 0; x < cw; x++ ) {
+				const std::uint8_t* p = row + x * 4;
+				yRow[x * 2] = p[yOffset];
+				yRow[x * 2 + 1] = p[yOffset + 2];
+				uRow[x] = p[cOffset];
+				vRow[x] = p[cOffset + 2];
+			}
+			_yuvRowToRgb( yRow, uRow, vRow, dst + y * w * 3, w );
+		}
+		return true;
+	}
+	return false;
+}
+
+//--------------------------------------------------------------
+void PixelConverter::sSetSimdEnabled( bool ab ) {
+	sBSimdEnabled = ab;
+}
+
+//--------------------------------------------------------------
+bool PixelConverter::sIsSimdEnabled() {
+	return sBSimdEnabled.load();
+}
+
+//--------------------------------------------------------------
+std::string PixelConverter::sGetSimdName() {
+	if( useSsse3() ) {
+		return "SSSE3";
+	}
+	if( useNeon() ) {
+		return "NEON";
+	}
+	return "none";
+}
+
+//--------------------------------------------------------------
+const ofPixels& PixelConverter::process( const ofPixels& apix ) {
+	if( sIsPassThrough(apix.getPixelFormat()) ) {
+		return apix;
+	}
+	if( !sCanConvert(apix) ) {
+		return mEmptyPixels;
+	}
+	// the previous buffer is returned to the pool when it is replaced
+	mPixels = mPool.acquire( apix.getWidth(), apix.getHeight(), 3 );
+	sConvertToRgb( apix, *mPixels );
+	return *mPixels;
+}
+
+//--------------------------------------------------------------
+void PixelConverter::_shuffleToRgb( const std::uint8_t* aSrc, std::uint8_t* aDst, size_t aNumPixels, ofPixelFormat aformat ) {
+	int bpp = 3;
+	int order[3];
+	getShuffleOrder( aformat, bpp, order );
+
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_X86)
+	if( useSsse3() ) {
+		static const int sGrayOrder[3] = { 0, 0, 0 };
+		static const int sBgrOrder[3] = { 2, 1, 0 };
+		static const int sRgbOrder[3] = { 0, 1, 2 };
+		static const ShuffleMasks sGrayMasks = makePixelMasks( 1, sGrayOrder );
+		static const ShuffleMasks sBgrMasks = makePixelMasks( 3, sBgrOrder );
+		static const ShuffleMasks sBgraMasks = makePixelMasks( 4, sBgrOrder );
+		static const ShuffleMasks sRgbaMasks = makePixelMasks( 4, sRgbOrder );
+		const ShuffleMasks* masks = nullptr;
+		if( aformat == OF_PIXELS_GRAY ) masks = &sGrayMasks;
+		else if( aformat == OF_PIXELS_BGR ) masks = &sBgrMasks;
+		else if( aformat == OF_PIXELS_BGRA ) masks = &sBgraMasks;
+		else if( aformat == OF_PIXELS_RGBA ) masks = &sRgbaMasks;
+		if( masks ) {
+			i = shuffleToRgbSsse3( aSrc, aDst, aNumPixels, bpp, *masks );
+		}
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	if( useNeon() ) {
+		i = shuffleToRgbNeon( aSrc, aDst, aNumPixels, bpp, order );
+	}
+#endif
+	for( ; i < aNumPixels; i++ ) {
+		const std::uint8_t* p = aSrc + i * bpp;
+		std::uint8_t* d = aDst + i * 3;
+		d[0] = p[order[0]];
+		d[1] = p[order[1]];
+		d[2] = p[order[2]];
+	}
+}
+
+//--------------------------------------------------------------
+void PixelConverter::_yuvRowToRgb( const std::uint8_t* ay, const std::uint8_t* au, const std::uint8_t* av, std::uint8_t* aDst, size_t aWidth ) {
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_X86)
+	if( useSsse3() ) {
+		static const ShuffleMasks sPlaneMasks = makePlaneMasks();
+		i = yuvRowToRgbSsse3( ay, au, av, aDst, aWidth, sPlaneMasks );
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	if( useNeon() ) {
+		i = yuvRowToRgbNeon( ay, au, av, aDst, aWidth );
+	}
+#endif
+	for( ; i < aWidth; i++ ) {
+		yuvToRgb( ay[i], au[i / 2], av[i / 2], aDst + i * 3 );
+	}
+}
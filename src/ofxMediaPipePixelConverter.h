@@ -0,0 +1,47 @@
+//
+//  ofxMediaPipePixelConverter.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofPixels.h"
+#include "ofxMediaPipePixelPool.h"
+#include <string>
+
+namespace ofx::MediaPipe {
+// Converts pixel formats that media pipe does not accept into RGB.
+// RGB and RGBA are passed through, since mp.Image supports SRGB and SRGBA.
+// BGR, BGRA and GRAY are swizzled, NV12, NV21, I420, YV12, YUY2 and UYVY are converted from BT.601 video range.
+// Uses SSSE3 (checked at runtime) or NEON when available, the scalar path gives the same results.
+class PixelConverter {
+public:
+	static std::string sGetStringForFormat( ofPixelFormat aformat );
+	static bool sIsSupported( ofPixelFormat aformat );
+	// formats that are handed to media pipe without a conversion
+	static bool sIsPassThrough( ofPixelFormat aformat );
+	// 4:2:0 and 4:2:2 formats need an even width and the 4:2:0 formats an even height
+	static bool sCanConvert( const ofPixels& apix );
+	// aDst must be allocated with the size of aSrc and 3 channels, returns false if the format is not supported
+	static bool sConvertToRgb( const ofPixels& aSrc, ofPixels& aDst );
+
+	// the vector paths can be turned off to compare them against the scalar path
+	static void sSetSimdEnabled( bool ab );
+	static bool sIsSimdEnabled();
+	// name of the instruction set in use, "none" for the scalar path
+	static std::string sGetSimdName();
+
+	// returns apix when it can be passed through, otherwise RGB pixels from the pool that are valid until the next call.
+	// The returned pixels are not allocated when the format can not be converted.
+	const ofPixels& process( const ofPixels& apix );
+
+protected:
+	static void _shuffleToRgb( const std::uint8_t* aSrc, std::uint8_t* aDst, size_t aNumPixels, ofPixelFormat aformat );
+	static void _yuvRowToRgb( const std::uint8_t* ay, const std::uint8_t* au, const std::uint8_t* av, std::uint8_t* aDst, size_t aWidth );
+
+	PixelPool mPool;
+	std::shared_ptr<ofPixels> mPixels;
+	ofPixels mEmptyPixels;
+};
+}
@@ -0,0 +1,112 @@
+//
+//  ofxMediaPipePixelPool.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipePixelPool.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+PixelPool::PixelPool() {
+	mState = std::make_shared<State>();
+}
+
+//--------------------------------------------------------------
+PixelPool::~PixelPool() {
+	// buffers that are still in use are deleted by their deleter once the pool is gone
+	clear();
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<ofPixels> PixelPool::acquire( size_t aw, size_t ah, size_t aNumChannels ) {
+	std::unique_ptr<ofPixels> tpix;
+	{
+		std::lock_guard<std::mutex> lck(mState->mutex);
+		auto& freePix = mState->freePixels;
+		// prefer a buffer that is already the correct size
+		for( auto it = freePix.begin(); it != freePix.end(); it++ ) {
+			auto& fp = *it;
+			if( fp->getWidth() == aw && fp->getHeight() == ah && fp->getNumChannels() == aNumChannels ) {
+				tpix = std::move(fp);
+				freePix.erase(it);
+				break;
+			}
+		}
+		if( !tpix && freePix.size() > 0 ) {
+			tpix = std::move(freePix.back());
+			freePix.pop_back();
+		}
+		if( !tpix ) {
+			mState->numAllocated++;
+		}
+	}
+
+	if( !tpix ) {
+		tpix = std::make_unique<ofPixels>();
+	}
+
+	if( tpix->getWidth() != aw || tpix->getHeight() != ah || tpix->getNumChannels() != aNumChannels ) {
+		tpix->allocate(aw, ah, aNumChannels);
+	}
+
+	std::weak_ptr<State> wstate = mState;
+	return std::shared_ptr<ofPixels>( tpix.release(), [wstate](ofPixels* apix) {
+		PixelPool::_release(wstate, apix);
+	});
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<ofPixels> PixelPool::acquireCopy( const ofPixels& apix ) {
+	auto rpix = acquire( apix.getWidth(), apix.getHeight(), apix.getNumChannels() );
+	if( apix.isAllocated() ) {
+		memcpy( rpix->getData(), apix.getData(), apix.getTotalBytes() );
+	}
+	return rpix;
+}
+
+//--------------------------------------------------------------
+void PixelPool::setMaxNumFree( size_t anum ) {
+	std::lock_guard<std::mutex> lck(mState->mutex);
+	mState->maxNumFree = anum;
+	while( mState->freePixels.size() > anum ) {
+		mState->freePixels.pop_back();
+		mState->numAllocated--;
+	}
+}
+
+//--------------------------------------------------------------
+size_t PixelPool::getNumFree() {
+	std::lock_guard<std::mutex> lck(mState->mutex);
+	return mState->freePixels.size();
+}
+
+//--------------------------------------------------------------
+size_t PixelPool::getNumAllocated() {
+	std::lock_guard<std::mutex> lck(mState->mutex);
+	return mState->numAllocated;
+}
+
+//--------------------------------------------------------------
+void PixelPool::clear() {
+	std::lock_guard<std::mutex> lck(mState->mutex);
+	mState->numAllocated -= std::min(mState->numAllocated, mState->freePixels.size());
+	mState->freePixels.clear();
+}
+
+//--------------------------------------------------------------
+void PixelPool::_release( const std::weak_ptr<State>& aState, ofPixels* apix ) {
+	if( auto state = aState.lock() ) {
+		std::lock_guard<std::mutex> lck(state->mutex);
+		if( state->freePixels.size() < state->maxNumFree ) {
+			state->freePixels.emplace_back(apix);
+			return;
+		}
+		if( state->numAllocated > 0 ) {
+			state->numAllocated--;
+		}
+	}
+	delete apix;
+}
@@ -0,0 +1,46 @@
+//
+//  ofxMediaPipePixelPool.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofPixels.h"
+#include <mutex>
+#include <memory>
+#include <vector>
+
+namespace ofx::MediaPipe {
+// Hands out reference counted pixel buffers that are returned to the pool
+// when the last reference is released, instead of being freed.
+// Buffers keep their allocation, so a steady stream of same sized frames does
+// not allocate after the first few frames.
+class PixelPool {
+public:
+	PixelPool();
+	~PixelPool();
+
+	// returns a buffer allocated to the requested size, contents are undefined
+	std::shared_ptr<ofPixels> acquire( size_t aw, size_t ah, size_t aNumChannels );
+	// returns a buffer holding a copy of apix
+	std::shared_ptr<ofPixels> acquireCopy( const ofPixels& apix );
+
+	void setMaxNumFree( size_t anum );
+	size_t getNumFree();
+	size_t getNumAllocated();
+	void clear();
+
+protected:
+	struct State {
+		std::mutex mutex;
+		std::vector< std::unique_ptr<ofPixels> > freePixels;
+		size_t maxNumFree = 8;
+		size_t numAllocated = 0;
+	};
+
+	static void _release( const std::weak_ptr<State>& aState, ofPixels* apix );
+
+	std::shared_ptr<State> mState;
+};
+}
@@ -6,6 +6,7 @@
 //
 
 #include "ofxMediaPipePlayback.h"
+#include <algorithm>
 
 using std::shared_ptr;
 using std::make_shared;
@@ -16,10 +17,13 @@ using namespace ofx::MediaPipe;
 
 //--------------------------------------------------------------
 bool Playback::load(const of::filesystem::path& afile) {
-	mFrames.clear();
+	mReader.close();
 	mCurrentFrameIndex = 0;
 	mPlayheadTime = 0;
-	mPlayFrames.clear();
+	mPlayFrames.fill( PlayFrame() );
+	mFaces.clear();
+	mHands.clear();
+	mPoses.clear();
 	mDuration = 0;
 	mOutRect.set(0,0,0,0);
 	mBDone = false;
@@ -33,42 +37,18 @@ bool Playback::load(const of::filesystem::path& afile) {
 	
 //	ofFile jsonFile(afile);
 	
-	ofJson tjson = ofLoadJson(afile);
-	if( !tjson.is_null() ) {
+	// only the positions of the frames are read here, the frames are parsed as they are played
+	if( mReader.open(afile) ) {
 		
-		if( tjson.count("frames") < 1 ) {
-			ofLogError("Playback::load") << "could not load file from: " << afile;
-			return false;
-		}
-		
-		mWidth = tjson["width"];
-		mHeight = tjson["height"];
+		mWidth = mReader.getWidth();
+		mHeight = mReader.getHeight();
 		
 		ofLogNotice("Playback::load") << "loaded from " << afile << " " << mWidth << " x " << mHeight;
 		
-		auto jframes = tjson["frames"];
-		for( auto& jframe : jframes ) {
-			if( !jframe.empty() ) {
-				// we have a frame here
-				auto frame = make_shared<Frame>();
-				if(frame->setup(jframe)) {
-					mFrames.push_back(frame);
-				}
-			}
-		}
-		
-		_checkPlayFrames();
-		
-		mDuration = 0;
+		mDuration = mReader.getDurationNanos();
 		// count up the total frames //
-		int ii = 0;
-		for( auto& frame : mFrames ) {
-			mPlayFrames[frame->getType()].totalFrames++;
-//			ofLogNotice("Frame: ")<< ii << " - " << frame->getTimestamp();
-			if( frame->getTimestamp() > mDuration ) {
-				mDuration = frame->getTimestamp();
-			}
-			ii++;
+		for( size_t i = 0; i < mPlayFrames.size(); i++ ) {
+			mPlayFrames[i].totalFrames = (unsigned int)mReader.getFrameIndices((TrackedObject::TrackedObjectType)i).size();
 		}
 		
 		mOutRect.set( 0,0,0,0);
@@ -90,13 +70,11 @@ bool Playback::load(const of::filesystem::path& afile) {
 //--------------------------------------------------------------
 void Playback::update() {
 	
-	_checkPlayFrames();
-	
-	for( auto& iter : mPlayFrames ) {
-		iter.second.bNewFrame = false;
+	for( auto& playFrame : mPlayFrames ) {
+		playFrame.bNewFrame = false;
 	}
 	
-	if( mFrames.size() < 1 ) {
+	if( mReader.getNumFrames() < 1 ) {
 		mBDone = true;
 		return;
 	}
@@ -107,138 +85,99 @@ void Playback::update() {
 	auto deltaD = now - mLastUpdateTime;
 	mLastUpdateTime = now;
 	
-	if( !mBPlaying || mBPaused ) {
-		return;
-	}
-	
-	std::int64_t deltaNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(deltaD).count();
-	mPlayheadTime += ((double)deltaNanos * (double)mSpeed);
+	const auto& frameInfos = mReader.getFrameInfos();
+	size_t numFrames = frameInfos.size();
 	
-	
-	auto playheadSecs = getPositionSeconds();
-	
-//	ofLogNotice("Playback::update : playhead: ") << mPlayheadTime << " / " << mFrames[mCurrentFrameIndex]->getTimestamp() << " frame: " << mCurrentFrameIndex << " / " << mFrames.size();
-	
-	size_t numFrames = mFrames.size();
-	if( mCurrentFrameIndex < numFrames ) {
-		for( auto& iter : mPlayFrames ) {
-			iter.second.prevFrameIndex = iter.second.currentFrameIndex;
+	if( mBSeeked ) {
+		// the indices were set by a seek, update the objects even when paused
+		mBSeeked = false;
+		for( auto& playFrame : mPlayFrames ) {
+			playFrame.bNewFrame = playFrame.totalFrames > 0;
+		}
+	} else {
+		if( !mBPlaying || mBPaused ) {
+			return;
 		}
 		
-		// loop through the different types to get updated frames 
-		while( mCurrentFrameIndex < numFrames ) {
-			mPlayFrames[mFrames[mCurrentFrameIndex]->getType()].currentFrameIndex = mCurrentFrameIndex;
-			
-//			ofLogNotice("Checking frame index ") << mCurrentFrameIndex << " num frames: " << numFrames << " fts: " <<  mFrames[mCurrentFrameIndex]->getTimestamp() << " / " << mPlayheadTime;
-//			auto tsSeconds = std::chrono::duration_cast<std::chrono::seconds>( std::chrono::nanoseconds(mFrames[mCurrentFrameIndex]->getTimestamp()) ).count();
-//			ofLogNotice("Checking frame index ") << mCurrentFrameIndex << " num frames: " << numFrames << " fts: " <<  tsSeconds << " / " << playheadSecs;
-			
-			if( mFrames[mCurrentFrameIndex]->getTimestamp() > mPlayheadTime ) {
-				break;
+		std::int64_t deltaNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(deltaD).count();
+		mPlayheadTime += ((double)deltaNanos * (double)mSpeed);
+		
+//		ofLogNotice("Playback::update : playhead: ") << mPlayheadTime << " / " << mFrames[mCurrentFrameIndex]->getTimestamp() << " frame: " << mCurrentFrameIndex << " / " << mFrames.size();
+		
+		for( auto& playFrame : mPlayFrames ) {
+			playFrame.prevFrameIndex = playFrame.currentFrameIndex;
+		}
+		
+		if( mSpeed < 0.f ) {
+			// playing backwards, the indices are searched for instead of stepping through the frames
+			if( mPlayheadTime < 0 ) {
+				mBDone = true;
+				mPlayheadTime = 0;
+				if( mLoopType == OF_LOOP_NORMAL ) {
+					mPlayheadTime = mDuration;
+				}
+			}
+			_seek( mPlayheadTime );
+		} else if( mCurrentFrameIndex < numFrames ) {
+			// loop through the different types to get updated frames
+			while( mCurrentFrameIndex < numFrames ) {
+				mPlayFrames[frameInfos[mCurrentFrameIndex].type].currentFrameIndex = mCurrentFrameIndex;
+				
+				if( frameInfos[mCurrentFrameIndex].timestamp > mPlayheadTime ) {
+					break;
+				}
+				mCurrentFrameIndex++;
+			}
+			if( mBInterpolationEnabled ) {
+				_setInterpolationFrames();
 			}
-			mCurrentFrameIndex++;
 		}
 		
-		for( auto& iter : mPlayFrames ) {
-			if(iter.second.prevFrameIndex != iter.second.currentFrameIndex) {
-				iter.second.bNewFrame = true;
+		for( auto& playFrame : mPlayFrames ) {
+			if(playFrame.prevFrameIndex != playFrame.currentFrameIndex) {
+				playFrame.bNewFrame = true;
 			}
 		}
-	}
-	
-	if( mCurrentFrameIndex >= numFrames ) {
-		mBDone = true;
-		mPlayheadTime = mDuration;
 		
-		if( mLoopType == OF_LOOP_NORMAL ) {
-			mCurrentFrameIndex = 0;
-			for( auto& iter : mPlayFrames ) {
-				iter.second.bNewFrame = true;
+		if( mSpeed >= 0.f && mCurrentFrameIndex >= numFrames ) {
+			mBDone = true;
+			mPlayheadTime = mDuration;
+			
+			if( mLoopType == OF_LOOP_NORMAL ) {
+				mCurrentFrameIndex = 0;
+				for( auto& playFrame : mPlayFrames ) {
+					playFrame.bNewFrame = true;
+				}
+				mPlayheadTime = 0;
+				if( mBInterpolationEnabled ) {
+					_setInterpolationFrames();
+				}
 			}
-			mPlayheadTime = 0;
 		}
 	}
 	
-	if( isFrameNew(TrackedObject::FACE) && hasValidFrame(TrackedObject::FACE) ) {
+	// only the latest frame of each type is decoded, no matter how many frames were stepped over
+	// when interpolating the objects change on every update between the frames
+	auto nextFace = _getNextFrame(TrackedObject::FACE);
+	if( (isFrameNew(TrackedObject::FACE) || nextFace) && hasValidFrame(TrackedObject::FACE) ) {
 		if( auto frame = getFrame(TrackedObject::FACE) ) {
-			for( auto& obj : mFaces ) {
-				obj->bRemove = true;
-			}
-			for( auto& fobj : frame->getFaces() ) {
-				bool bHasIt = false;
-				for( auto& obj : mFaces ) {
-					if( obj->ID == fobj->ID ) {
-						obj->updateFrom(fobj);
-						obj->bRemove = false;
-						bHasIt = true;
-						break;
-					}
-				}
-				if( !bHasIt ) {
-					auto nface = std::make_shared<Face>( *(fobj.get()) );
-					mFaces.push_back(nface);
-				}
-			}
+			_updateObjects( mFaces, frame->getFaces(), mPlayFrames[TrackedObject::FACE].idSlots, nextFace ? &nextFace->getFaces() : nullptr, mPlayFrames[TrackedObject::FACE].interpolation );
 		}
 	}
 	
-	if( isFrameNew(TrackedObject::HAND) && hasValidFrame(TrackedObject::HAND) ) {
+	auto nextHand = _getNextFrame(TrackedObject::HAND);
+	if( (isFrameNew(TrackedObject::HAND) || nextHand) && hasValidFrame(TrackedObject::HAND) ) {
 		if( auto frame = getFrame(TrackedObject::HAND) ) {
-			for( auto& obj : mHands ) {
-				obj->bRemove = true;
-			}
-			for( auto& fobj : frame->getHands() ) {
-				bool bHasIt = false;
-				for( auto& obj : mHands ) {
-					if( obj->ID == fobj->ID ) {
-						obj->updateFrom(fobj);
-						obj->bRemove = false;
-						bHasIt = true;
-						break;
-					}
-				}
-				if( !bHasIt ) {
-					auto nhand = std::make_shared<Hand>( *(fobj.get()) );
-					mHands.push_back(nhand);
-				}
-			}
+			_updateObjects( mHands, frame->getHands(), mPlayFrames[TrackedObject::HAND].idSlots, nextHand ? &nextHand->getHands() : nullptr, mPlayFrames[TrackedObject::HAND].interpolation );
 		}
 	}
 	
-	if( isFrameNew(TrackedObject::POSE) && hasValidFrame(TrackedObject::POSE) ) {
+	auto nextPose = _getNextFrame(TrackedObject::POSE);
+	if( (isFrameNew(TrackedObject::POSE) || nextPose) && hasValidFrame(TrackedObject::POSE) ) {
 		if( auto frame = getFrame(TrackedObject::POSE) ) {
-			for( auto& obj : mPoses ) {
-				obj->bRemove = true;
-			}
-//			mPoses = frame->getPoses();
-			
-			for( auto& fobj : frame->getPoses() ) {
-				bool bHasIt = false;
-				for( auto& obj : mPoses ) {
-					if( obj->ID == fobj->ID ) {
-						if(mBSmootingEnabled) {
-							obj->updateFromPoseWithSmoothing(fobj, mSmoothing );
-						} else {
-							obj->updateFrom(fobj);
-						}
-						obj->bRemove = false;
-						bHasIt = true;
-						break;
-					}
-				}
-				if( !bHasIt ) {
-					auto npose = std::make_shared<Pose>( *(fobj.get()) );
-//					std::cout << " adding poses frame " << std::endl;
-					mPoses.push_back(npose);
-				}
-			}
+			_updateObjects( mPoses, frame->getPoses(), mPlayFrames[TrackedObject::POSE].idSlots, nextPose ? &nextPose->getPoses() : nullptr, mPlayFrames[TrackedObject::POSE].interpolation );
 		}
 	}
-	
-	ofRemove( mFaces, TrackedObject::shouldRemove );
-	ofRemove( mHands, TrackedObject::shouldRemove );
-	ofRemove( mPoses, TrackedObject::shouldRemove );
-	
 }
 
 //--------------------------------------------------------------
@@ -289,6 +228,39 @@ double Playback::getPositionSeconds() {
 	return seconds_duration.count();
 }
 
+//--------------------------------------------------------------
+void Playback::seekToNanos( std::int64_t anano ) {
+	if( mReader.getNumFrames() < 1 ) {
+		return;
+	}
+	mPlayheadTime = std::clamp( anano, (std::int64_t)0, mDuration );
+	_seek( mPlayheadTime );
+	mBDone = false;
+	mBSeeked = true;
+	mLastUpdateTime = std::chrono::high_resolution_clock::now();
+}
+
+//--------------------------------------------------------------
+void Playback::seekToSeconds( double aseconds ) {
+	seekToNanos( (std::int64_t)(aseconds * 1000000000.0) );
+}
+
+//--------------------------------------------------------------
+void Playback::seekToFrame( unsigned int aindex ) {
+	const auto& frameInfos = mReader.getFrameInfos();
+	if( aindex < frameInfos.size() ) {
+		seekToNanos( frameInfos[aindex].timestamp );
+	}
+}
+
+//--------------------------------------------------------------
+void Playback::seekToFrame( const TrackedObject::TrackedObjectType& atype, unsigned int aindex ) {
+	const auto& indices = mReader.getFrameIndices( atype );
+	if( aindex < indices.size() ) {
+		seekToFrame( indices[aindex] );
+	}
+}
+
 //--------------------------------------------------------------
 const std::int64_t& Playback::getDurationNanos() {
 	return mDuration;
@@ -297,19 +269,18 @@ const std::int64_t& Playback::getDurationNanos() {
 //--------------------------------------------------------------
 double Playback::getDurationSeconds() {
 //	return std::chrono::duration_cast<std::chrono::seconds>( std::chrono::nanoseconds(mDuration) ).count();
-	std::chrono::nanoseconds ns_duration(mPlayheadTime);
+	std::chrono::nanoseconds ns_duration(mDuration);
 	std::chrono::duration<double> seconds_duration = ns_duration;
 	return seconds_duration.count();
 }
 
 //--------------------------------------------------------------
 unsigned int Playback::getNumFrames() {
-	return mFrames.size();
+	return mReader.getNumFrames();
 }
 
 //--------------------------------------------------------------
 unsigned int Playback::getNumFrames(const TrackedObject::TrackedObjectType& atype) {
-	_checkPlayFrames();
 	return mPlayFrames[atype].totalFrames;
 }
 
@@ -320,14 +291,13 @@ unsigned int Playback::getCurrentFrameIndex() {
 
 //--------------------------------------------------------------
 unsigned int Playback::getCurrentFrameIndex(const TrackedObject::TrackedObjectType& atype) {
-	_checkPlayFrames();
 	return mPlayFrames[atype].currentFrameIndex;
 }
 
 //--------------------------------------------------------------
 bool Playback::isFrameNew() {
-	for( auto& iter : mPlayFrames ) {
-		if(iter.second.bNewFrame ) {return true;}
+	for( auto& playFrame : mPlayFrames ) {
+		if(playFrame.bNewFrame ) {return true;}
 	}
 	return false;
 }
@@ -340,13 +310,9 @@ bool Playback::isFrameNew( const TrackedObject::TrackedObjectType& atype ) {
 
 //--------------------------------------------------------------
 bool Playback::hasValidFrame(const TrackedObject::TrackedObjectType& atype) {
-	if( mFrames.size() < 1 ) return false;
-	_checkPlayFrames();
+	if( mReader.getNumFrames() < 1 ) return false;
 	if( mPlayFrames[atype].totalFrames < 1 ) return false;
-	if( mPlayFrames[atype].currentFrameIndex < mFrames.size() ) {
-		return mFrames[mPlayFrames[atype].currentFrameIndex ] ? true : false;
-	}
-	return false;
+	return mPlayFrames[atype].currentFrameIndex < mReader.getNumFrames();
 //	if( mCurrentFrameIndex >= mFrames.size() ) return false;
 //	return (mFrames[mCurrentFrameIndex]) ? true : false;
 }
@@ -356,8 +322,17 @@ std::shared_ptr<Frame>& Playback::getFrame(const TrackedObject::TrackedObjectTyp
 	if( !hasValidFrame(atype) ) {
 		return dummyFrame;
 	}
-	if(mFrames.size() == 1) return mFrames[0];
-	return mFrames[mPlayFrames[atype].currentFrameIndex];
+	auto& playFrame = mPlayFrames[atype];
+	unsigned int findex = mReader.getNumFrames() == 1 ? 0 : playFrame.currentFrameIndex;
+	if( !playFrame.frame || playFrame.frameIndex != findex ) {
+		// parsed from the file or taken from the cache of the reader
+		playFrame.frame = mReader.getFrame( findex );
+		playFrame.frameIndex = findex;
+	}
+	if( !playFrame.frame ) {
+		return dummyFrame;
+	}
+	return playFrame.frame;
 }
 
 //--------------------------------------------------------------
@@ -393,16 +368,13 @@ std::vector< std::shared_ptr<Pose> >& Playback::getPoses() {
 //--------------------------------------------------------------
 void Playback::setOutRect(const ofRectangle &arect) {
 	if( mOutRect != arect ) {
-		for( auto& frame : mFrames ) {
-			
-			for( auto& face : frame->getFaces() ) {
-				_convertKeypointsToOutRect(face->keypoints,arect);
-			}
-			for( auto& hand : frame->getHands() ) {
-				_convertKeypointsToOutRect(hand->keypoints,arect);
-			}
-			for( auto& pose : frame->getPoses() ) {
-				_convertKeypointsToOutRect(pose->keypoints,arect);
+		// frames that are decoded later are converted by the reader
+		mReader.setOutRect(arect);
+		for( auto& playFrame : mPlayFrames ) {
+			RecordingReader::sApplyOutRect( playFrame.frame, arect );
+			RecordingReader::sApplyOutRect( playFrame.nextFrame, arect );
+			for( auto& frame : playFrame.allFrames ) {
+				RecordingReader::sApplyOutRect( frame, arect );
 			}
 		}
 	}
@@ -435,36 +407,107 @@ int Playback::getHeight() {
 }
 
 //--------------------------------------------------------------
-std::vector< std::shared_ptr<Frame> > Playback::getAllFrames( const TrackedObject::TrackedObjectType& atype ) {
-	std::vector< std::shared_ptr<Frame> > rframes;
-	for( auto& frame : mFrames ) {
-		if(frame->getType() == atype) {
-			rframes.push_back(frame);
+const std::vector< std::shared_ptr<Frame> >& Playback::getAllFrames( const TrackedObject::TrackedObjectType& atype ) {
+	auto& playFrame = mPlayFrames[atype];
+	const auto& indices = mReader.getFrameIndices( atype );
+	// decoded once and kept until the next load
+	if( !playFrame.bAllFramesValid ) {
+		playFrame.allFrames.clear();
+		playFrame.allFrames.reserve( indices.size() );
+		for( auto index : indices ) {
+			if( auto frame = mReader.getFrame(index) ) {
+				playFrame.allFrames.push_back(frame);
+			}
 		}
+		playFrame.bAllFramesValid = true;
 	}
-	return rframes;
+	return playFrame.allFrames;
 }
 
 //--------------------------------------------------------------
-void Playback::_checkPlayFrames() {
-	if(mPlayFrames.size() < 1 ) {
-		mPlayFrames[TrackedObject::FACE] = PlayFrame();
-		mPlayFrames[TrackedObject::HAND] = PlayFrame();
-		mPlayFrames[TrackedObject::POSE] = PlayFrame();
+std::shared_ptr<Frame> Playback::getFrameAt( const TrackedObject::TrackedObjectType& atype, unsigned int aindex ) {
+	const auto& indices = mReader.getFrameIndices( atype );
+	if( aindex >= indices.size() ) {
+		return nullptr;
 	}
+	return mReader.getFrame( indices[aindex] );
 }
 
 //--------------------------------------------------------------
-void Playback::_convertKeypointsToOutRect( std::vector<TrackedObject::Keypoint>& apts, const ofRectangle& arect ) {
-	for( auto& kp : apts ) {
-		kp.pos = kp.posN;
-		kp.pos.x *= arect.width;
-		kp.pos.y *= arect.height;
-		kp.pos.x += arect.x;
-		kp.pos.y += arect.y;
-		
-		kp.pos.z *= arect.width;
+void Playback::_updateObject( std::shared_ptr<Pose>& aobj, std::shared_ptr<Pose>& aFrameObj ) {
+	if(mBSmootingEnabled) {
+		aobj->updateFromPoseWithSmoothing(aFrameObj, mSmoothing );
+	} else {
+		aobj->updateFrom(aFrameObj);
+	}
+}
+
+//--------------------------------------------------------------
+void Playback::_seek( std::int64_t anano ) {
+	size_t numFrames = mReader.getNumFrames();
+	mCurrentFrameIndex = (unsigned int)mReader.getFrameIndexAfterNanos( anano );
+	// the same frames that stepping forward to the playhead would have set
+	size_t maxIndex = std::min( (size_t)mCurrentFrameIndex, numFrames - 1 );
+	for( size_t i = 0; i < mPlayFrames.size(); i++ ) {
+		auto type = (TrackedObject::TrackedObjectType)i;
+		auto& playFrame = mPlayFrames[i];
+		size_t findex = 0;
+		if( mReader.getLastFrameIndex(type, maxIndex, findex) ) {
+			playFrame.currentFrameIndex = (unsigned int)findex;
+		} else if( playFrame.totalFrames > 0 ) {
+			// the type starts after the playhead
+			playFrame.currentFrameIndex = mReader.getFrameIndices(type).front();
+		}
+	}
+	if( mBInterpolationEnabled ) {
+		_setInterpolationFrames();
+	}
+}
+
+//--------------------------------------------------------------
+void Playback::_setInterpolationFrames() {
+	const auto& frameInfos = mReader.getFrameInfos();
+	// frames before this index are at or before the playhead
+	auto afterIndex = (std::uint32_t)mReader.getFrameIndexAfterNanos( mPlayheadTime );
+	for( size_t i = 0; i < mPlayFrames.size(); i++ ) {
+		auto& playFrame = mPlayFrames[i];
+		playFrame.bHasNextFrame = false;
+		playFrame.interpolation = 0.f;
+		const auto& indices = mReader.getFrameIndices( (TrackedObject::TrackedObjectType)i );
+		if( indices.empty() ) {
+			continue;
+		}
+		auto it = std::lower_bound( indices.begin(), indices.end(), afterIndex );
+		if( it == indices.begin() ) {
+			// the type starts after the playhead
+			playFrame.currentFrameIndex = indices.front();
+			continue;
+		}
+		playFrame.currentFrameIndex = *(it - 1);
+		if( it == indices.end() ) {
+			continue;
+		}
+		std::int64_t startNanos = frameInfos[playFrame.currentFrameIndex].timestamp;
+		std::int64_t gapNanos = frameInfos[*it].timestamp - startNanos;
+		if( gapNanos > 0 && gapNanos <= mInterpolationMaxGapNanos ) {
+			playFrame.nextFrameIndex = *it;
+			playFrame.bHasNextFrame = true;
+			playFrame.interpolation = ofClamp( (float)((double)(mPlayheadTime - startNanos) / (double)gapNanos), 0.f, 1.f );
+		}
+	}
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<Frame> Playback::_getNextFrame( const TrackedObject::TrackedObjectType& atype ) {
+	auto& playFrame = mPlayFrames[atype];
+	if( !mBInterpolationEnabled || !playFrame.bHasNextFrame ) {
+		return nullptr;
+	}
+	if( !playFrame.nextFrame || playFrame.decodedNextFrameIndex != playFrame.nextFrameIndex ) {
+		playFrame.nextFrame = mReader.getFrame( playFrame.nextFrameIndex );
+		playFrame.decodedNextFrameIndex = playFrame.nextFrameIndex;
 	}
+	return playFrame.nextFrame;
 }
 
 ////--------------------------------------------------------------
@@ -7,7 +7,9 @@
 
 #pragma once
 #include "ofxMediaPipeFrame.h"
+#include "ofxMediaPipeRecordingReader.h"
 #include "ofVideoBaseTypes.h"
+#include <array>
 #include <map>
 
 namespace ofx::MediaPipe {
@@ -19,6 +21,20 @@ public:
 		unsigned int currentFrameIndex = 0;
 		unsigned int prevFrameIndex = 989823978;
 		unsigned int totalFrames = 0;
+		// decoded from the recording when it is requested
+		std::shared_ptr<Frame> frame;
+		unsigned int frameIndex = 0;
+		// the following frame of the type when interpolating, the objects are blended by interpolation (0 - 1)
+		unsigned int nextFrameIndex = 0;
+		std::shared_ptr<Frame> nextFrame;
+		unsigned int decodedNextFrameIndex = 0;
+		bool bHasNextFrame = false;
+		float interpolation = 0.f;
+		// index of the playback object for an ID, -1 if there is none
+		std::vector<int> idSlots;
+		// filled by getAllFrames
+		std::vector< std::shared_ptr<Frame> > allFrames;
+		bool bAllFramesValid = false;
 	};
 	
 	// Based on ofxFFmpegRecorder
@@ -39,6 +55,15 @@ public:
 	const std::int64_t& getPositionNanos();
 	double getPositionSeconds();
 	
+	// Moves the playhead with a binary search of the frame timestamps, forwards or backwards, while playing or paused.
+	// The objects are updated on the next call to update().
+	void seekToNanos( std::int64_t anano );
+	void seekToSeconds( double aseconds );
+	// index into all of the frames, see getNumFrames()
+	void seekToFrame( unsigned int aindex );
+	// index into the frames of the type, see getNumFrames(atype)
+	void seekToFrame( const TrackedObject::TrackedObjectType& atype, unsigned int aindex );
+	
 	const std::int64_t& getDurationNanos();
 	double getDurationSeconds();
 	
@@ -69,6 +94,7 @@ public:
 	void setLoopState(ofLoopType state);
 	ofLoopType getLoopState();
 	
+	// negative speeds play backwards
 	void setSpeed( float as ) {mSpeed=as;}
 	float getSpeed() {return mSpeed;}
 	
@@ -78,15 +104,85 @@ public:
 	void setSmoothingEnabled( bool ab ) { mBSmootingEnabled = ab;};
 	void setSmoothing( float asmooth ) { mSmoothing = ofClamp( asmooth, 0.0f, 1.f); }
 	
+	// blends the keypoints and blend shape scores of each object between the recorded frames around the playhead,
+	// so playback is smooth when updating faster than the recording or with a speed below 1.
+	// Objects that are blended skip the pose smoothing.
+	void setInterpolationEnabled( bool ab ) { mBInterpolationEnabled = ab; }
+	bool isInterpolationEnabled() { return mBInterpolationEnabled; }
+	// frames of a type further apart than this are not blended, the object was likely lost in between
+	void setInterpolationMaxGapSeconds( float aseconds ) { mInterpolationMaxGapNanos = (std::int64_t)(aseconds * 1000000000.0); }
+	float getInterpolationMaxGapSeconds() { return (float)((double)mInterpolationMaxGapNanos / 1000000000.0); }
+	// how far the playhead is between the current and the next frame of a type, 0 when not interpolating
+	float getInterpolation( const TrackedObject::TrackedObjectType& atype ) { return mPlayFrames[atype].interpolation; }
+	
 	// get all the frames for a type
 	// helpful for iterating regardless of time
-	std::vector< std::shared_ptr<Frame> > getAllFrames( const TrackedObject::TrackedObjectType& atype );
+	// parses every frame of the type from the file on the first call, so the whole recording of the type is in memory
+	const std::vector< std::shared_ptr<Frame> >& getAllFrames( const TrackedObject::TrackedObjectType& atype );
+	// random access to the frames of a type without decoding all of them, aindex < getNumFrames(atype)
+	std::shared_ptr<Frame> getFrameAt( const TrackedObject::TrackedObjectType& atype, unsigned int aindex );
 	
-protected:
-	void _checkPlayFrames();
-	void _convertKeypointsToOutRect( std::vector< TrackedObject::Keypoint>& apts, const ofRectangle& arect );
+	// the frames are read from the file as they are played, see RecordingReader::setCacheSize
+	RecordingReader& getReader() { return mReader; }
 	
-	std::vector< std::shared_ptr<Frame> > mFrames;
+protected:
+	// Matches the objects of a frame to the playback objects through the ID slots,
+	// so an update is linear in the number of objects and only allocates for new IDs.
+	template<typename T>
+	void _updateObjects( std::vector<std::shared_ptr<T>>& aobjs, std::vector<std::shared_ptr<T>>& aFrameObjs, std::vector<int>& aIdSlots, std::vector<std::shared_ptr<T>>* aNextFrameObjs = nullptr, float apct = 0.f ) {
+		for( auto& obj : aobjs ) {
+			obj->bRemove = true;
+		}
+		for( auto& fobj : aFrameObjs ) {
+			if( fobj->ID >= aIdSlots.size() ) {
+				aIdSlots.resize( fobj->ID + 1, -1 );
+			}
+			// the same object in the next frame, there are only a few objects per frame
+			std::shared_ptr<T>* nextObj = nullptr;
+			if( aNextFrameObjs ) {
+				for( auto& nobj : *aNextFrameObjs ) {
+					if( nobj->ID == fobj->ID ) {
+						nextObj = &nobj;
+						break;
+					}
+				}
+			}
+			int slot = aIdSlots[fobj->ID];
+			if( slot >= 0 && slot < (int)aobjs.size() && aobjs[slot]->ID == fobj->ID ) {
+				if( nextObj ) {
+					aobjs[slot]->updateFromInterpolated( fobj, *nextObj, apct );
+				} else {
+					_updateObject( aobjs[slot], fobj );
+				}
+				aobjs[slot]->bRemove = false;
+			} else {
+				aobjs.push_back( std::make_shared<T>( *(fobj.get()) ) );
+				if( nextObj ) {
+					aobjs.back()->updateFromInterpolated( fobj, *nextObj, apct );
+				}
+				aIdSlots[fobj->ID] = (int)aobjs.size() - 1;
+			}
+		}
+		ofRemove( aobjs, TrackedObject::shouldRemove );
+		// removing shifts the objects
+		for( size_t i = 0; i < aobjs.size(); i++ ) {
+			aIdSlots[aobjs[i]->ID] = (int)i;
+		}
+	}
+	template<typename T>
+	void _updateObject( std::shared_ptr<T>& aobj, std::shared_ptr<T>& aFrameObj ) {
+		aobj->updateFrom(aFrameObj);
+	}
+	void _updateObject( std::shared_ptr<Pose>& aobj, std::shared_ptr<Pose>& aFrameObj );
+	
+	// sets the frame indices for the playhead time
+	void _seek( std::int64_t anano );
+	// sets the current frame of each type to the last one at the playhead and finds the next one to blend towards
+	void _setInterpolationFrames();
+	// nullptr when the type is not interpolated
+	std::shared_ptr<Frame> _getNextFrame( const TrackedObject::TrackedObjectType& atype );
+	
+	RecordingReader mReader;
 	std::int64_t mPlayheadTime = 0;
 	std::int64_t mDuration;
 	HighResClock mLastUpdateTime;
@@ -100,12 +196,14 @@ protected:
 	bool mBPlaying = false;
 	bool mBDone = false;
 	bool mBLoaded = false;
+	bool mBSeeked = false;
 	
 	ofRectangle mOutRect;
 	
 	ofLoopType mLoopType = OF_LOOP_NORMAL;
 	
-	std::map< TrackedObject::TrackedObjectType, PlayFrame > mPlayFrames;
+	// indexed by TrackedObjectType
+	std::array< PlayFrame, 3 > mPlayFrames;
 	
 	of::filesystem::path mFilepath;
 	
@@ -117,6 +215,9 @@ protected:
 	float mSmoothing = 0.6f;
 	bool mBSmootingEnabled = false;
 	
+	bool mBInterpolationEnabled = false;
+	std::int64_t mInterpolationMaxGapNanos = 500000000;
+	
 	float mSpeed = 1.f;
 	
 //	std::map< TrackedObject::TrackedObjectType, bool > mBNewFrames;
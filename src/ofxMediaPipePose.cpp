@@ -41,6 +41,11 @@ void Pose::updateFromPoseWithSmoothing( std::shared_ptr<Pose> aother, float pct
 //	updateFromKeypoints();
 }
 
+//-------------------------------------------
+void Pose::updateFromInterpolated( std::shared_ptr<Pose>& aA, std::shared_ptr<Pose>& aB, float apct ) {
+	updateKeypointsFromInterpolation( aA, aB, apct );
+}
+
 //-------------------------------------------
 void Pose::updateFromKeypoints() {
 	
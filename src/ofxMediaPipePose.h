@@ -56,6 +56,8 @@ public:
 	
 	void updateFrom( std::shared_ptr<Pose>& aother );
 	void updateFromPoseWithSmoothing( std::shared_ptr<Pose> aother, float pct );
+	// keypoints between two recorded frames
+	void updateFromInterpolated( std::shared_ptr<Pose>& aA, std::shared_ptr<Pose>& aB, float apct );
 	
 	void updateFromKeypoints() override;
 	
@@ -55,7 +55,8 @@ bool PoseTracker::setup(const Tracker::Settings& asettings) {
 
 //--------------------------------------------------------------
 bool PoseTracker::setup(const PoseSettings& asettings) {
-	if (!Py_IsInitialized()) {
+	// a worker process has its own interpreter
+	if (!Py_IsInitialized() && asettings.backend != Tracker::BACKEND_WORKER_PROCESS) {
 		ofLogNotice("PoseTracker") << "initing PYTHON";
 		py::initialize_interpreter();
 	}
@@ -65,6 +66,7 @@ bool PoseTracker::setup(const PoseSettings& asettings) {
 	}
 	
 	mSettings = asettings;
+	_applyBaseSettings( mSettings );
 	mHasNewThreadValues = false;
 	mBSetup = false;
 	
@@ -85,9 +87,21 @@ bool PoseTracker::setup(const PoseSettings& asettings) {
 	Tracker::release();
 	mMaskPix.clear();
 	mBExiting = false;
+	
+	if( mSettings.backend == Tracker::BACKEND_WORKER_PROCESS ) {
+		// results arrive on the reader thread of the worker and are applied in update, like the video thread
+		mSettings.runningMode = Tracker::MODE_OF_VIDEO_THREAD;
+		if( mSettings.outputSegmentationMasks ) {
+			ofLogWarning("PoseTracker :: setup") << "segmentation masks are not available from a worker process.";
+		}
+		ofJson jconfig;
+		return _setupWorker( mSettings, jconfig );
+	}
  	
 	
-	py::gil_scoped_acquire acquire;
+	_setupInterpreter( mSettings );
+	// acquires the GIL of the tracker's interpreter
+	ScopedGilAcquire acquire( nullptr, nullptr, &mInterpreter );
 	py_mediapipe = py::module::import("mediapipe");
 	
 	py::object BaseOptions = py_mediapipe.attr("tasks").attr("BaseOptions");
@@ -100,15 +114,9 @@ bool PoseTracker::setup(const PoseSettings& asettings) {
 	
 	
 	//(py::object& aresults, py::object& aMpImage, int aTimestamp);
-	process_results_lambda = [this](py::object& aresults, py::object& aMpImage, int aTimestamp) {
+	process_results_lambda = [this](py::object& aresults, py::object& aMpImage, std::int64_t aTimestamp) {
 		//		std::cout << "Class Lambda Result callback called. " << aTimestamp << std::endl;
-		if( mBExiting.load() ) {
-			mThreadCallCount--;
-			if( mThreadCallCount < 0 ) {
-				mThreadCallCount = 0;
-			}
-			return;
-		}
+		// _process_results_callback clears the in flight frames when exiting
 		try {
 			_process_results_callback( aresults, aMpImage, aTimestamp );
 		} catch(...) {
@@ -177,7 +185,9 @@ void PoseTracker::_update() {
 				mRawPoses.push_back(np);
 			}
 			
+			mTimestampMicros = mThreadedTimestampMicros;
 			_matchPoses(mThreadedPoses, mPoses);
+			_trace( Trace::STAGE_MATCH_DONE, mTimestampMicros );
 			// we need to match the poses here //
 //			mThreadedPoses.clear();
 			mBTexDirty = true;
@@ -266,7 +276,7 @@ ofTexture& PoseTracker::getMaskTexture() {
 //segmentation_masks : [<mediapipe.python._framework_bindings.image.Image object at 0x2848aa6f0>]
 
 //--------------------------------------------------------------
-void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp) {
+void PoseTracker::_process_landmark_results(py::object& aresults, std::int64_t aTimestampMicros) {
 	
 //	ofLogNotice("_process_landmark_results") << getTrackerTypeAsString() << " | " << ofGetFrameNum();
 
@@ -277,7 +287,7 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 	//	py::scoped_interpreter guard{};
 	if (aresults.is_none()) {
-		ofLogNotice("PoseTracker::_process_landmark_results") << "Results are bad, returning. " << aTimestamp;
+		ofLogNotice("PoseTracker::_process_landmark_results") << "Results are bad, returning. " << aTimestampMicros;
 		return;
 	}
 	
@@ -286,12 +296,10 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 	bool bValid = true;
 
-	std::vector< std::shared_ptr<Pose> > tposes;
-
 	try {
 //		py::gil_scoped_acquire acquire;
 		if (!Utils::has_all_attributes(aresults, { "pose_landmarks", "pose_world_landmarks" })) {
-			ofLogError("PoseTracker::_process_landmark_results") << "Does not contain either pose_landmarks or pose_world_landmarks." << aTimestamp;
+			ofLogError("PoseTracker::_process_landmark_results") << "Does not contain either pose_landmarks or pose_world_landmarks." << aTimestampMicros;
 			//py::gil_scoped_release release;
 			return;
 		}
@@ -300,7 +308,7 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 		py::list pose_world_landmarks_list = aresults.attr("pose_world_landmarks").cast<py::list>();;
 		//	Check if results is iterable
 		if (!py::isinstance<py::iterable>(pose_landmarks_list)) {
-			ofLogError("PoseTracker::_process_landmark_results") << "'results' pose_landmarks is not iterable. " << aTimestamp;
+			ofLogError("PoseTracker::_process_landmark_results") << "'results' pose_landmarks is not iterable. " << aTimestampMicros;
 			//py::gil_scoped_release release;
 			return;
 		}
@@ -314,57 +322,13 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 		//py::gil_scoped_acquire acquire;
 
 		// std::vector< std::shared_ptr<Pose> > tposes;
-		int numMarks = py::len(pose_landmarks_list);
-		
-//		ofLogNotice("_process_landmark_results") << " going to process number of marks: " << numMarks << " | " << ofGetFrameNum();
-		
-		for (int i = 0; i < numMarks; i++) {
-
-			//		Pose tpose;
-			auto tpose = std::make_shared<Pose>();
-
-			py::list pose_landmarks = pose_landmarks_list[i];
-			py::list pose_world_landmarks = pose_world_landmarks_list[i];
-
-			int num = py::len(pose_landmarks);
-
-			//		ofLogNotice("PoseTracker::_process_landmark_results") << " num keypoints " << num;
-
-			tpose->keypoints.assign(num, TrackedObject::Keypoint());
-
-			int j = 0;
-			for (py::handle hl : pose_landmarks) {
-
-				auto& kp = tpose->keypoints[j];
-				kp.pos.x = py::float_(py::getattr(hl, "x"));
-				kp.pos.y = py::float_(py::getattr(hl, "y"));
-				kp.pos.z = py::float_(py::getattr(hl, "z"));
-
-				kp.posN = kp.pos;
-				kp.pos.x *= mOutRect.width;
-				kp.pos.y *= mOutRect.height;
-				kp.pos.x += mOutRect.x;
-				kp.pos.y += mOutRect.y;
-
-				kp.pos.z *= mOutRect.width;
-
-				//			ofLogNotice("PoseTracker::_process_landmark_results") << j << " keypoint pos " << kp.pos;
-
-				j++;
-			}
-
-			j = 0;
-			for (py::handle hwl : pose_world_landmarks) {
-				auto& kp = tpose->keypoints[j];
-				kp.posWorld.x = py::float_(py::getattr(hwl, "x"));
-				kp.posWorld.y = py::float_(py::getattr(hwl, "y"));
-				kp.posWorld.z = py::float_(py::getattr(hwl, "z"));
-				j++;
-			}
-
-			tposes.push_back(tpose);
+		// pack the landmarks into contiguous buffers instead of looking up every coordinate
+		if( !mLandmarkPacker.packLandmarks(pose_landmarks_list, mPackedLandmarks) ||
+		   !mLandmarkPacker.packLandmarks(pose_world_landmarks_list, mPackedWorldLandmarks) ) {
+			ofLogError("PoseTracker::_process_landmark_results") << "unable to pack the results. " << aTimestampMicros;
+			return;
 		}
-
+		
 		if (mSettings.outputSegmentationMasks) {
 			// update the mask
 			// if (!py::isinstance<py::iterable>(pose_landmarks_list)) {
@@ -403,7 +367,7 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 				}
 			} else {
-				ofLogError("PoseTracker::_process_landmark_results") << "Does not contain segmentation_masks." << aTimestamp;
+				ofLogError("PoseTracker::_process_landmark_results") << "Does not contain segmentation_masks." << aTimestampMicros;
 			}
 		}
 
@@ -415,14 +379,78 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 
 	// Release GIL while performing intensive C++ operations
 	//py::gil_scoped_release release;
+	_apply_packed_results(aTimestampMicros);
+}
+
+//--------------------------------------------------------------
+void PoseTracker::_process_packed_results(std::int64_t aTimestampMicros) {
+	std::vector< std::shared_ptr<Pose> > tposes;
+	
+	int numMarks = (int)mPackedLandmarks.getNumLists();
+	
+//		ofLogNotice("_process_landmark_results") << " going to process number of marks: " << numMarks << " | " << ofGetFrameNum();
+	
+	size_t landmarkOffset = 0;
+	size_t worldOffset = 0;
+	for (int i = 0; i < numMarks; i++) {
+
+		//		Pose tpose;
+		auto tpose = std::make_shared<Pose>();
+
+		int num = mPackedLandmarks.counts[i];
+		int numWorld = 0;
+		if( i < (int)mPackedWorldLandmarks.getNumLists() ) {
+			numWorld = std::min( num, mPackedWorldLandmarks.counts[i] );
+		}
+
+		//		ofLogNotice("PoseTracker::_process_landmark_results") << " num keypoints " << num;
+
+		tpose->keypoints.assign(num, TrackedObject::Keypoint());
+
+		const float* xyz = mPackedLandmarks.xyz.data() + landmarkOffset * 3;
+		for (int j = 0; j < num; j++) {
+			auto& kp = tpose->keypoints[j];
+			kp.pos.x = xyz[j*3+0];
+			kp.pos.y = xyz[j*3+1];
+			kp.pos.z = xyz[j*3+2];
+
+			kp.posN = kp.pos;
+			kp.pos.x *= mOutRect.width;
+			kp.pos.y *= mOutRect.height;
+			kp.pos.x += mOutRect.x;
+			kp.pos.y += mOutRect.y;
+
+			kp.pos.z *= mOutRect.width;
+
+			//			ofLogNotice("PoseTracker::_process_landmark_results") << j << " keypoint pos " << kp.pos;
+		}
+
+		const float* wxyz = mPackedWorldLandmarks.xyz.data() + worldOffset * 3;
+		for (int j = 0; j < numWorld; j++) {
+			auto& kp = tpose->keypoints[j];
+			kp.posWorld.x = wxyz[j*3+0];
+			kp.posWorld.y = wxyz[j*3+1];
+			kp.posWorld.z = wxyz[j*3+2];
+		}
+
+		landmarkOffset += num;
+		if( i < (int)mPackedWorldLandmarks.getNumLists() ) {
+			worldOffset += mPackedWorldLandmarks.counts[i];
+		}
+
+		tposes.push_back(tpose);
+	}
 
 	if( mSettings.runningMode == Tracker::MODE_LIVE_STREAM) {
 		std::lock_guard<std::mutex> lck(mMutex);
 		mThreadedPoses = tposes;
+		mThreadedTimestampMicros = aTimestampMicros;
 		mHasNewThreadValues = true;
 	} else if( mSettings.runningMode == Tracker::MODE_OF_VIDEO_THREAD ) {
-		//std::unique_lock<std::mutex> lck(mMutex);
+		// also called from the reader thread of a worker process
+		std::lock_guard<std::mutex> lck(mMutex);
 		mThreadedPoses = tposes;
+		mThreadedTimestampMicros = aTimestampMicros;
 		mHasNewThreadValues = true;
 	} else {
 		if( mSettings.outputSegmentationMasks && mPixWidth > 0 && mPixHeight > 0 ) {
@@ -430,16 +458,18 @@ void PoseTracker::_process_landmark_results(py::object& aresults, int aTimestamp
 		}
 		mBTexDirty = true;
 		mRawPoses = tposes;
+		mTimestampMicros = aTimestampMicros;
 		_matchPoses( tposes, mPoses );
+		_trace( Trace::STAGE_MATCH_DONE, aTimestampMicros );
 	}
 }
 
 //--------------------------------------------------------------
 //void PoseTracker::_matchPoses( std::vector<Pose>& aIncomingPoses, std::vector< std::shared_ptr<Pose>>& aPoses ) {
 void PoseTracker::_matchPoses( std::vector< std::shared_ptr<Pose>>& aIncomingPoses, std::vector< std::shared_ptr<Pose>>& aPoses ) {
+	Histogram::ScopedTimer matchingTimer( mStats.matching );
 	
-	float frameRate = ofClamp(Tracker::mFpsCounter.getFps(), 1, 200);
-	int mNumFramesToDie = Tracker::mMaxTimeToMatch * frameRate;
+	int mNumFramesToDie = _getNumFramesToDie( mTimestampMicros );
 
 	for( auto& pose : aPoses ) {
 		pose->trackingData.bFoundThisFrame = false;
@@ -24,13 +24,7 @@ public:
 	public:
 		PoseSettings() {};
 		~PoseSettings() {};
-		PoseSettings( const Tracker::Settings& asettings, bool bOutSegmentationMasks=false ) {
-			runningMode = asettings.runningMode;
-			maxNum = asettings.maxNum;
-			minDetectionConfidence = asettings.minDetectionConfidence;
-			minPresenceConfidence = asettings.minPresenceConfidence;
-			minTrackingConfidence = asettings.minTrackingConfidence;
-			filePath = asettings.filePath;
+		PoseSettings( const Tracker::Settings& asettings, bool bOutSegmentationMasks=false ) : Tracker::Settings(asettings) {
 			outputSegmentationMasks = bOutSegmentationMasks;
 		}
 		bool outputSegmentationMasks = false;
@@ -54,7 +48,8 @@ public:
 	
 protected:
 	void _update() override;
-	void _process_landmark_results( py::object& aresults, int aTimestamp) override;
+	void _process_landmark_results( py::object& aresults, std::int64_t aTimestampMicros) override;
+	void _process_packed_results( std::int64_t aTimestampMicros ) override;
 	void _matchPoses( std::vector< std::shared_ptr<Pose>>& aIncomingPoses, std::vector< std::shared_ptr<Pose>>& aPoses );
 	
 	bool _areFeetAboveHips( std::shared_ptr<Pose>& apose );
@@ -0,0 +1,374 @@
+//
+//  ofxMediaPipeQuantizer.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeQuantizer.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OFX_MEDIAPIPE_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define OFX_MEDIAPIPE_TARGET_F16C
+#else
+#include <cpuid.h>
+// compiled for f16c on its own, so the rest of the addon does not need -mf16c
+#define OFX_MEDIAPIPE_TARGET_F16C __attribute__((target("f16c")))
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+// vcvtnq_u32_f32, vmaxnmq_f32 and the half conversions are part of arm64
+#define OFX_MEDIAPIPE_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace ofx::MediaPipe;
+
+namespace {
+std::atomic<bool> sBSimdEnabled = true;
+
+#if defined(OFX_MEDIAPIPE_X86)
+//--------------------------------------------------------------
+bool hasF16c() {
+	// F16C is VEX encoded, the os has to save the AVX registers as well
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid( info, 1 );
+	bool bF16c = (info[2] & (1 << 29)) != 0;
+	bool bOsXSave = (info[2] & (1 << 27)) != 0;
+	return bF16c && bOsXSave && (_xgetbv(0) & 0x6) == 0x6;
+#else
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if( !__get_cpuid(1, &eax, &ebx, &ecx, &edx) ) {
+		return false;
+	}
+	bool bF16c = (ecx & (1u << 29)) != 0;
+	bool bOsXSave = (ecx & (1u << 27)) != 0;
+	if( !bF16c || !bOsXSave ) {
+		return false;
+	}
+	unsigned int xcr0 = 0, xcr0High = 0;
+	__asm__ volatile( "xgetbv" : "=a"(xcr0), "=d"(xcr0High) : "c"(0) );
+	return (xcr0 & 0x6) == 0x6;
+#endif
+}
+
+//--------------------------------------------------------------
+// sse2 is part of x86_64, the results are rounded to nearest even like the scalar path
+size_t encodeUnorm16Sse2( const float* aIn, std::uint16_t* aOut, size_t aNum, float aMin, float aScale ) {
+	const __m128 vmin = _mm_set1_ps( aMin );
+	const __m128 vscale = _mm_set1_ps( aScale );
+	const __m128 vzero = _mm_setzero_ps();
+	const __m128 vmax = _mm_set1_ps( 65535.f );
+	const __m128i vbias = _mm_set1_epi32( 32768 );
+	const __m128i vflip = _mm_set1_epi16( (short)0x8000 );
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		// max returns the second operand for nan, so nan becomes 0
+		__m128 lo = _mm_min_ps( _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(aIn + i), vmin), vscale), vzero), vmax );
+		__m128 hi = _mm_min_ps( _mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(aIn + i + 4), vmin), vscale), vzero), vmax );
+		// there is no unsigned pack in sse2, pack around 0 and flip the sign bit back
+		__m128i qlo = _mm_sub_epi32( _mm_cvtps_epi32(lo), vbias );
+		__m128i qhi = _mm_sub_epi32( _mm_cvtps_epi32(hi), vbias );
+		_mm_storeu_si128( (__m128i*)(aOut + i), _mm_xor_si128(_mm_packs_epi32(qlo, qhi), vflip) );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+size_t decodeUnorm16Sse2( const std::uint16_t* aIn, float* aOut, size_t aNum, float aMin, float aStep ) {
+	const __m128 vmin = _mm_set1_ps( aMin );
+	const __m128 vstep = _mm_set1_ps( aStep );
+	const __m128i vzero = _mm_setzero_si128();
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		__m128i q = _mm_loadu_si128( (const __m128i*)(aIn + i) );
+		__m128 lo = _mm_cvtepi32_ps( _mm_unpacklo_epi16(q, vzero) );
+		__m128 hi = _mm_cvtepi32_ps( _mm_unpackhi_epi16(q, vzero) );
+		// multiply and add separately, so the results match the scalar path
+		_mm_storeu_ps( aOut + i, _mm_add_ps(_mm_mul_ps(lo, vstep), vmin) );
+		_mm_storeu_ps( aOut + i + 4, _mm_add_ps(_mm_mul_ps(hi, vstep), vmin) );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+OFX_MEDIAPIPE_TARGET_F16C size_t encodeHalfF16c( const float* aIn, std::uint16_t* aOut, size_t aNum ) {
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		__m128i lo = _mm_cvtps_ph( _mm_loadu_ps(aIn + i), _MM_FROUND_TO_NEAREST_INT );
+		__m128i hi = _mm_cvtps_ph( _mm_loadu_ps(aIn + i + 4), _MM_FROUND_TO_NEAREST_INT );
+		_mm_storeu_si128( (__m128i*)(aOut + i), _mm_unpacklo_epi64(lo, hi) );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+OFX_MEDIAPIPE_TARGET_F16C size_t decodeHalfF16c( const std::uint16_t* aIn, float* aOut, size_t aNum ) {
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		__m128i h = _mm_loadu_si128( (const __m128i*)(aIn + i) );
+		_mm_storeu_ps( aOut + i, _mm_cvtph_ps(h) );
+		_mm_storeu_ps( aOut + i + 4, _mm_cvtph_ps(_mm_unpackhi_epi64(h, h)) );
+	}
+	return i;
+}
+#endif
+
+#if defined(OFX_MEDIAPIPE_NEON)
+//--------------------------------------------------------------
+size_t encodeUnorm16Neon( const float* aIn, std::uint16_t* aOut, size_t aNum, float aMin, float aScale ) {
+	const float32x4_t vmin = vdupq_n_f32( aMin );
+	const float32x4_t vscale = vdupq_n_f32( aScale );
+	const float32x4_t vzero = vdupq_n_f32( 0.f );
+	const float32x4_t vmax = vdupq_n_f32( 65535.f );
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		// maxnm returns the number for nan, so nan becomes 0
+		float32x4_t lo = vminq_f32( vmaxnmq_f32(vmulq_f32(vsubq_f32(vld1q_f32(aIn + i), vmin), vscale), vzero), vmax );
+		float32x4_t hi = vminq_f32( vmaxnmq_f32(vmulq_f32(vsubq_f32(vld1q_f32(aIn + i + 4), vmin), vscale), vzero), vmax );
+		vst1q_u16( aOut + i, vcombine_u16(vmovn_u32(vcvtnq_u32_f32(lo)), vmovn_u32(vcvtnq_u32_f32(hi))) );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+size_t decodeUnorm16Neon( const std::uint16_t* aIn, float* aOut, size_t aNum, float aMin, float aStep ) {
+	const float32x4_t vmin = vdupq_n_f32( aMin );
+	const float32x4_t vstep = vdupq_n_f32( aStep );
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		uint16x8_t q = vld1q_u16( aIn + i );
+		float32x4_t lo = vcvtq_f32_u32( vmovl_u16(vget_low_u16(q)) );
+		float32x4_t hi = vcvtq_f32_u32( vmovl_u16(vget_high_u16(q)) );
+		// multiply and add separately, so the results match the scalar path
+		vst1q_f32( aOut + i, vaddq_f32(vmulq_f32(lo, vstep), vmin) );
+		vst1q_f32( aOut + i + 4, vaddq_f32(vmulq_f32(hi, vstep), vmin) );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+size_t encodeHalfNeon( const float* aIn, std::uint16_t* aOut, size_t aNum ) {
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		float16x4_t lo = vcvt_f16_f32( vld1q_f32(aIn + i) );
+		float16x4_t hi = vcvt_f16_f32( vld1q_f32(aIn + i + 4) );
+		vst1q_u16( aOut + i, vreinterpretq_u16_f16(vcombine_f16(lo, hi)) );
+	}
+	return i;
+}
+
+//--------------------------------------------------------------
+size_t decodeHalfNeon( const std::uint16_t* aIn, float* aOut, size_t aNum ) {
+	size_t i = 0;
+	for( ; i + 8 <= aNum; i += 8 ) {
+		float16x8_t h = vreinterpretq_f16_u16( vld1q_u16(aIn + i) );
+		vst1q_f32( aOut + i, vcvt_f32_f16(vget_low_f16(h)) );
+		vst1q_f32( aOut + i + 4, vcvt_f32_f16(vget_high_f16(h)) );
+	}
+	return i;
+}
+#endif
+
+//--------------------------------------------------------------
+bool useSse2() {
+#if defined(OFX_MEDIAPIPE_X86)
+	return sBSimdEnabled.load();
+#else
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+bool useF16c() {
+#if defined(OFX_MEDIAPIPE_X86)
+	static const bool bHasF16c = hasF16c();
+	return bHasF16c && sBSimdEnabled.load();
+#else
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+bool useNeon() {
+#if defined(OFX_MEDIAPIPE_NEON)
+	return sBSimdEnabled.load();
+#else
+	return false;
+#endif
+}
+
+//--------------------------------------------------------------
+inline std::uint16_t encodeUnorm16( float av, float aMin, float aScale ) {
+	float t = (av - aMin) * aScale;
+	// written so that nan becomes 0 like the vector paths
+	t = t > 0.f ? t : 0.f;
+	t = t < 65535.f ? t : 65535.f;
+	return (std::uint16_t)std::nearbyint( t );
+}
+}
+
+//--------------------------------------------------------------
+void Quantizer::sEncodeUnorm16( const float* aIn, std::uint16_t* aOut, size_t aNum, float aMin, float aMax ) {
+	float scale = (aMax > aMin) ? 65535.f / (aMax - aMin) : 0.f;
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_X86)
+	if( useSse2() ) {
+		i = encodeUnorm16Sse2( aIn, aOut, aNum, aMin, scale );
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	if( useNeon() ) {
+		i = encodeUnorm16Neon( aIn, aOut, aNum, aMin, scale );
+	}
+#endif
+	for( ; i < aNum; i++ ) {
+		aOut[i] = encodeUnorm16( aIn[i], aMin, scale );
+	}
+}
+
+//--------------------------------------------------------------
+void Quantizer::sDecodeUnorm16( const std::uint16_t* aIn, float* aOut, size_t aNum, float aMin, float aMax ) {
+	float step = (aMax - aMin) / 65535.f;
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_X86)
+	if( useSse2() ) {
+		i = decodeUnorm16Sse2( aIn, aOut, aNum, aMin, step );
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	if( useNeon() ) {
+		i = decodeUnorm16Neon( aIn, aOut, aNum, aMin, step );
+	}
+#endif
+	for( ; i < aNum; i++ ) {
+		float scaled = (float)aIn[i] * step;
+		aOut[i] = scaled + aMin;
+	}
+}
+
+//--------------------------------------------------------------
+void Quantizer::sEncodeHalf( const float* aIn, std::uint16_t* aOut, size_t aNum ) {
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_X86)
+	if( useF16c() ) {
+		i = encodeHalfF16c( aIn, aOut, aNum );
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	if( useNeon() ) {
+		i = encodeHalfNeon( aIn, aOut, aNum );
+	}
+#endif
+	for( ; i < aNum; i++ ) {
+		aOut[i] = sFloatToHalf( aIn[i] );
+	}
+}
+
+//--------------------------------------------------------------
+void Quantizer::sDecodeHalf( const std::uint16_t* aIn, float* aOut, size_t aNum ) {
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_X86)
+	if( useF16c() ) {
+		i = decodeHalfF16c( aIn, aOut, aNum );
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	if( useNeon() ) {
+		i = decodeHalfNeon( aIn, aOut, aNum );
+	}
+#endif
+	for( ; i < aNum; i++ ) {
+		aOut[i] = sHalfToFloat( aIn[i] );
+	}
+}
+
+//--------------------------------------------------------------
+std::uint16_t Quantizer::sFloatToHalf( float af ) {
+	std::uint32_t x = 0;
+	memcpy( &x, &af, sizeof(x) );
+	std::uint32_t sign = (x >> 16) & 0x8000;
+	std::uint32_t fexp = (x >> 23) & 0xff;
+	std::uint32_t mant = x & 0x7fffff;
+	if( fexp == 0xff ) {
+		// inf, or a quiet nan that keeps the top of the payload like the hardware conversions
+		return (std::uint16_t)(sign | 0x7c00 | (mant ? (0x200 | (mant >> 13)) : 0));
+	}
+	std::int32_t exp = (std::int32_t)fexp - 127 + 15;
+	if( exp >= 31 ) {
+		return (std::uint16_t)(sign | 0x7c00);
+	}
+	if( exp <= 0 ) {
+		if( exp < -10 ) {
+			return (std::uint16_t)sign;
+		}
+		// subnormal
+		mant |= 0x800000;
+		std::uint32_t shift = (std::uint32_t)(14 - exp);
+		std::uint32_t half = mant >> shift;
+		std::uint32_t rest = mant & ((1u << shift) - 1);
+		std::uint32_t halfway = 1u << (shift - 1);
+		if( rest > halfway || (rest == halfway && (half & 1)) ) {
+			half++;
+		}
+		return (std::uint16_t)(sign | half);
+	}
+	std::uint32_t half = sign | ((std::uint32_t)exp << 10) | (mant >> 13);
+	std::uint32_t rest = mant & 0x1fff;
+	// a carry into the exponent is still the correctly rounded value
+	if( rest > 0x1000 || (rest == 0x1000 && (half & 1)) ) {
+		half++;
+	}
+	return (std::uint16_t)half;
+}
+
+//--------------------------------------------------------------
+float Quantizer::sHalfToFloat( std::uint16_t ah ) {
+	std::uint32_t sign = (std::uint32_t)(ah & 0x8000) << 16;
+	std::uint32_t exp = (ah >> 10) & 0x1f;
+	std::uint32_t mant = ah & 0x3ff;
+	std::uint32_t x = sign;
+	if( exp == 0x1f ) {
+		// nan is quieted like the hardware conversions
+		x |= 0x7f800000 | (mant << 13) | (mant ? 0x400000 : 0);
+	} else if( exp > 0 ) {
+		x |= ((exp + 127 - 15) << 23) | (mant << 13);
+	} else if( mant > 0 ) {
+		// subnormal, normalize the mantissa
+		exp = 127 - 15 + 1;
+		while( !(mant & 0x400) ) {
+			mant <<= 1;
+			exp--;
+		}
+		x |= (exp << 23) | ((mant & 0x3ff) << 13);
+	}
+	float f = 0.f;
+	memcpy( &f, &x, sizeof(f) );
+	return f;
+}
+
+//--------------------------------------------------------------
+void Quantizer::sSetSimdEnabled( bool ab ) {
+	sBSimdEnabled = ab;
+}
+
+//--------------------------------------------------------------
+bool Quantizer::sIsSimdEnabled() {
+	return sBSimdEnabled.load();
+}
+
+//--------------------------------------------------------------
+std::string Quantizer::sGetSimdName() {
+	if( useF16c() ) {
+		return "SSE2 F16C";
+	}
+	if( useSse2() ) {
+		return "SSE2";
+	}
+	if( useNeon() ) {
+		return "NEON";
+	}
+	return "none";
+}
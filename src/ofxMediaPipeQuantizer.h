@@ -0,0 +1,36 @@
+//
+//  ofxMediaPipeQuantizer.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ofx::MediaPipe {
+// Converts arrays of floats to 16 bit values and back, used for the keypoints of the OSC packed encodings and .mpbin recordings.
+// unorm16: q = round((v - aMin) / (aMax - aMin) * 65535), values outside of aMin - aMax are clamped.
+//          Inside the range the error is at most (aMax - aMin) / 131070, plus float rounding.
+// half: IEEE 754 binary16, rounded to nearest even. The relative error is at most 2^-11,
+//       values above 65504 become infinity and values below 2^-24 become 0.
+// Uses SSE2 and F16C (checked at runtime) or NEON on arm64, the scalar path gives the same results.
+class Quantizer {
+public:
+	static void sEncodeUnorm16( const float* aIn, std::uint16_t* aOut, size_t aNum, float aMin, float aMax );
+	static void sDecodeUnorm16( const std::uint16_t* aIn, float* aOut, size_t aNum, float aMin, float aMax );
+	static void sEncodeHalf( const float* aIn, std::uint16_t* aOut, size_t aNum );
+	static void sDecodeHalf( const std::uint16_t* aIn, float* aOut, size_t aNum );
+
+	static std::uint16_t sFloatToHalf( float af );
+	static float sHalfToFloat( std::uint16_t ah );
+
+	// the vector paths can be turned off to compare them against the scalar path
+	static void sSetSimdEnabled( bool ab );
+	static bool sIsSimdEnabled();
+	// name of the instruction sets in use, "none" for the scalar path
+	static std::string sGetSimdName();
+};
+}
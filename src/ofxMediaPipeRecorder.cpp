@@ -6,13 +6,20 @@
 //
 
 #include "ofxMediaPipeRecorder.h"
+#include <sstream>
 
 using namespace ofx::MediaPipe;
 using namespace std;
 
+//---------------------------------
+Recorder::~Recorder() {
+	// finishes the file, so that it can be read without scanning for frames
+	stopRecording();
+}
+
 //---------------------------------
 bool Recorder::startRecording(int awidth, int aheight, const of::filesystem::path& adirectory) {
-	std::string filename = ofGetTimestampString()+".json";
+	std::string filename = ofGetTimestampString()+(mBBinaryDefault ? RecordingReader::sBinaryExtension : ".json");
 	return startRecording(awidth, aheight, adirectory, filename);
 }
 
@@ -29,40 +36,46 @@ bool Recorder::startRecording(int awidth, int aheight, const of::filesystem::pat
 	}
 	
 	mPath = ofFilePath::addTrailingSlash(adirectory)+aFilename;
-	if( mPath.extension() != ".json") {
-		ofLogWarning("Recorder::startRecording") << "extenstion must be json, not" << mPath.extension();
+	bool bBinary = (mPath.extension() == RecordingReader::sBinaryExtension);
+	if( mPath.extension() != ".json" && !bBinary ) {
+		ofLogWarning("Recorder::startRecording") << "extenstion must be json or mpbin, not" << mPath.extension();
 		return false;
 	}
 	
-	mLastPath = mPath;
+	// the frames are appended as they are added
+	if( !mWriter.open(mPath, mWriterSettings) ) {
+		ofLogWarning("Recorder::startRecording") << "error opening file to save to " << mPath;
+		return false;
+	}
+	mBBinary = bBinary;
+	mBinaryInfos.clear();
+	mBlendShapeNames.clear();
+	mTypes = 0;
+	for( auto& codec : mDeltaCodecs ) {
+		codec.reset();
+	}
 	
-//	mJsonFile.clear();
-//	mJsonFile.close();
-////	bool open(const of::filesystem::path & path, Mode mode = ReadOnly, bool binary = true);
-//	if(!mJsonFile.open(mPath, ofFile::WriteOnly, true)) {
-//		ofLogWarning("Recorder::startRecording") << "error opening file to save to " << mPath;
-//		return false;
-//	}
+	mLastPath = mPath;
 	
 	mWidth = awidth;
 	mHeight = aheight;
 	
-//	ofJson jvideo;
-//	jvideo["width"] = awidth;
-//	jvideo["height"] = awidth;
-//	
-//	ofJson jheader;
-//	jheader["video"] = jvideo;
-//	mJsonFile << jheader;
-	
-	mJson.clear();
-	
-	mJson["width"] = mWidth;
-	mJson["height"] = mHeight;
-	
-	mFramesJson.clear();
+	// the header of the binary format is written again in stopRecording, with the location of the index.
+	// The frames array of the json is closed in stopRecording, the RecordingReader reads the frames of an unclosed file.
+	std::string header;
+	if( mBBinary ) {
+		std::ostringstream hstream;
+		RecordingReader::sWriteBinaryHeader( hstream, mWidth, mHeight, 0, 0, 0 );
+		header = hstream.str();
+	} else {
+		header = "{\"width\":"+ofToString(mWidth)+",\"height\":"+ofToString(mHeight)+",\"frames\":[\n";
+	}
+	mWriteOffset = header.size();
+	mWriter.push( std::move(header) );
 	
 	mNumAddedFrames = 0;
+	mBHasCaptureOrigin = false;
+	mNumWrittenFrames = 0;
 	mDuration = 0;
 	
 	mBRecording=true;
@@ -72,17 +85,39 @@ bool Recorder::startRecording(int awidth, int aheight, const of::filesystem::pat
 //---------------------------------
 void Recorder::stopRecording() {
 	if(mBRecording) {
-		if(mNumAddedFrames > 0 && !mPath.empty()) {
-			mJson["frames"] = mFramesJson;
-			ofSaveJson(mPath, mJson);
+		std::string tail, header;
+		if( mBBinary ) {
+			std::ostringstream tstream, hstream;
+			RecordingReader::sWriteBinaryIndex( tstream, mBinaryInfos, mBlendShapeNames );
+			RecordingReader::sWriteBinaryHeader( hstream, mWidth, mHeight, mTypes, mBinaryInfos.size(), mWriteOffset );
+			tail = tstream.str();
+			header = hstream.str();
+		} else {
+			tail = "\n]}\n";
+		}
+		mWriter.close( tail, header );
+		mBinaryInfos.clear();
+		
+		// nothing is saved without frames
+		if( mNumWrittenFrames < 1 && !mPath.empty() ) {
+			std::error_code ec;
+			of::filesystem::remove( mPath, ec );
 		}
-//		if(mJsonFile.is_open() ) {
-//			mJsonFile.close();
-//		}
 	}
 	mBRecording = false;
 }
 
+//---------------------------------
+void Recorder::setKeypointEncoding( Frame::KeypointEncoding aencoding ) {
+	if( aencoding == Frame::KEYPOINTS_DELTA && mKeypointEncoding != aencoding ) {
+		// the records before were not written with the codecs
+		for( auto& codec : mDeltaCodecs ) {
+			codec.requestKeyframe();
+		}
+	}
+	mKeypointEncoding = aencoding;
+}
+
 //---------------------------------
 const std::int64_t& Recorder::getDurationNanos() {
 	return mDuration;
@@ -99,3 +134,55 @@ std::size_t& Recorder::getNumFrames() {
 }
 
 
+
+
+//---------------------------------
+size_t Recorder::addFrame( const std::shared_ptr<Frame>& aframe ) {
+	if( !aframe ) {
+		return mNumAddedFrames;
+	}
+	if( aframe->getType() == TrackedObject::FACE ) {
+		return addFrame( aframe->getTimestamp(), aframe->getFaces() );
+	} else if( aframe->getType() == TrackedObject::HAND ) {
+		return addFrame( aframe->getTimestamp(), aframe->getHands() );
+	} else if( aframe->getType() == TrackedObject::POSE ) {
+		return addFrame( aframe->getTimestamp(), aframe->getPoses() );
+	}
+	return mNumAddedFrames;
+}
+
+//---------------------------------
+void Recorder::_addBlendShapeNames( const std::vector<std::shared_ptr<Face>>& afaces ) {
+	for( auto& face : afaces ) {
+		for( auto& bshape : face->getBlendShapes() ) {
+			if( bshape.index >= 0 && mBlendShapeNames.count(bshape.index) < 1 ) {
+				mBlendShapeNames[bshape.index] = bshape.category_name;
+			}
+		}
+	}
+}
+
+//---------------------------------
+bool Recorder::_pushRecord( std::string&& abuffer ) {
+	RecordingReader::FrameInfo info;
+	info.offset = mWriteOffset;
+	if( mBBinary && !Frame::sReadBinaryHeader(abuffer.data(), abuffer.size(), info.numBytes, info.timestamp, info.type) ) {
+		return false;
+	}
+	auto numBytes = abuffer.size();
+	if( !mWriter.push(std::move(abuffer)) ) {
+		// the writer can not keep up, the frame is dropped instead of blocking.
+		// The next record of the type can not depend on it.
+		if( mBBinary && (size_t)info.type < mDeltaCodecs.size() ) {
+			mDeltaCodecs[(size_t)info.type].requestKeyframe();
+		}
+		return false;
+	}
+	mWriteOffset += numBytes;
+	if( mBBinary ) {
+		mBinaryInfos.push_back( info );
+		mTypes |= (1u << (std::uint32_t)info.type);
+	}
+	mNumWrittenFrames++;
+	return true;
+}
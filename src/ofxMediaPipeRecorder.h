@@ -7,20 +7,24 @@
 
 #pragma once
 #include "ofxMediaPipeFrame.h"
+#include "ofxMediaPipeRecordingReader.h"
+#include "ofxMediaPipeRecordingWriter.h"
+#include <array>
 #include <map>
+#include <type_traits>
 
 namespace ofx::MediaPipe {
+// Frames are serialized when they are added and written to disk by a RecordingWriter on a background thread,
+// so memory use does not grow with the length of the recording.
 class Recorder {
 public:
 	// Based on ofxFFmpegRecorder
 	using HighResClock = std::chrono::time_point<std::chrono::high_resolution_clock>;
 	
+	~Recorder();
+	
 	template<typename T>
 	size_t addFrame( const std::vector<std::shared_ptr<T>>& aobjs ) {
-		if( !mFrame ) {
-			mFrame = std::make_shared<Frame>();
-		}
-		
 		HighResClock now = std::chrono::high_resolution_clock::now();
 		if( mNumAddedFrames == 0 ) {
 			mRecordStartTime = now;
@@ -29,24 +33,77 @@ public:
 		// https://en.cppreference.com/w/cpp/chrono/duration
 		auto elapsed = now - mRecordStartTime;
 		std::int64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+		return addFrame( nanos, aobjs );
+	}
+	
+	// adds the objects with the capture timestamp of the frame that they were detected in, see Tracker::getTimestampMicros().
+	// The first capture timestamp is lined up with the start of the recording, so the time between frames is the time
+	// between captures instead of the time between results arriving.
+	template<typename T>
+	size_t addCapturedFrame( std::int64_t aCaptureMicros, const std::vector<std::shared_ptr<T>>& aobjs ) {
+		HighResClock now = std::chrono::high_resolution_clock::now();
+		if( mNumAddedFrames == 0 ) {
+			mRecordStartTime = now;
+		}
+		if( !mBHasCaptureOrigin ) {
+			auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - mRecordStartTime).count();
+			mCaptureOriginMicros = aCaptureMicros - (std::int64_t)elapsed;
+			mBHasCaptureOrigin = true;
+		}
+		// a tracker with more latency can deliver a frame that was captured before the origin
+		std::int64_t nanos = std::max( (std::int64_t)0, aCaptureMicros - mCaptureOriginMicros ) * 1000;
+		return addFrame( nanos, aobjs );
+	}
+	
+	// adds the objects with a timestamp relative to the start of the recording
+	template<typename T>
+	size_t addFrame( const std::int64_t& atimestampNanos, const std::vector<std::shared_ptr<T>>& aobjs ) {
+		if( !mFrame ) {
+			mFrame = std::make_shared<Frame>();
+		}
+		
+		if( !mBRecording ) {
+			return mNumAddedFrames;
+		}
 		
-		//	auto frame = make_shared<Frame>();
-//		mJsonFile << mFrame->jsonify(nanos, aobjs );
-		mFramesJson.push_back( mFrame->jsonify(nanos, aobjs ) );
-		mDuration = nanos;
+		std::string buffer = mWriter.getBuffer();
+		if( mBBinary ) {
+			auto& codec = mDeltaCodecs[_getTypeIndex<T>()];
+			codec.setKeyframeInterval( mKeyframeInterval );
+			Frame::sAppendBinary( buffer, atimestampNanos, aobjs, mKeypointEncoding, &codec );
+			_addBlendShapeNames( aobjs );
+		} else {
+			if( mNumWrittenFrames > 0 ) {
+				buffer += ",\n";
+			}
+			buffer += mFrame->jsonify(atimestampNanos, aobjs ).dump();
+		}
+		_pushRecord( std::move(buffer) );
+		mDuration = std::max( mDuration, atimestampNanos );
 		
 		mNumAddedFrames++;
 		return mNumAddedFrames;
 	}
 	
+	// adds the objects of a frame, ie. from a Playback, with its timestamp
+	size_t addFrame( const std::shared_ptr<Frame>& aframe );
+	
 	bool& isRecording() { return mBRecording; }
 	bool startRecording( int awidth, int aheight, const of::filesystem::path& adirectory );
+	// the format is picked from the extension, .json or .mpbin
 	bool startRecording( int awidth, int aheight, const of::filesystem::path& adirectory, std::string aFilename );
 	void stopRecording();
 	
 	const std::int64_t& getDurationNanos();
 	long long getDurationSeconds();
 	std::size_t& getNumFrames();
+	// frames that were dropped because the writer queue was full
+	std::uint64_t getNumDroppedFrames() { return mWriter.getNumDropped(); }
+	
+	// applied on the next startRecording
+	void setWriterSettings( const RecordingWriter::Settings& asettings ) { mWriterSettings = asettings; }
+	const RecordingWriter::Settings& getWriterSettings() { return mWriterSettings; }
+	RecordingWriter& getWriter() { return mWriter; }
 	
 	int getWidth() { return mWidth; }
 	int getHeight() { return mHeight; }
@@ -55,9 +112,36 @@ public:
 		return mLastPath; 
 	}
 	
+	// extension of the file names created by startRecording( w, h, directory ), binary (.mpbin) or json
+	void setBinaryFormatEnabled( bool ab ) { mBBinaryDefault = ab; }
+	bool isBinaryFormatEnabled() { return mBBinaryDefault; }
+	bool isRecordingBinary() { return mBBinary; }
+	// how .mpbin recordings store the keypoints, Frame::KEYPOINTS_QUANTIZED halves the size of the keypoints.
+	// Applied to the frames added after the call, json recordings always store floats.
+	void setKeypointEncoding( Frame::KeypointEncoding aencoding );
+	Frame::KeypointEncoding getKeypointEncoding() { return mKeypointEncoding; }
+	// records between keyframes of Frame::KEYPOINTS_DELTA, seeking decodes from the keyframe before the frame
+	void setKeyframeInterval( int aNumFrames ) { mKeyframeInterval = std::max( 1, aNumFrames ); }
+	int getKeyframeInterval() { return mKeyframeInterval; }
+	
 protected:
+	template<typename T>
+	void _addBlendShapeNames( const std::vector<std::shared_ptr<T>>& aobjs ) {}
+	void _addBlendShapeNames( const std::vector<std::shared_ptr<Face>>& afaces );
+	bool _pushRecord( std::string&& abuffer );
+	template<typename T>
+	size_t _getTypeIndex() {
+		if( std::is_same<T, Hand>::value ) return (size_t)TrackedObject::HAND;
+		if( std::is_same<T, Face>::value ) return (size_t)TrackedObject::FACE;
+		return (size_t)TrackedObject::POSE;
+	}
+	
+
 	std::size_t mNumAddedFrames = 0;
 	HighResClock mRecordStartTime;
+	// capture timestamp at the start of the recording, see addCapturedFrame
+	std::int64_t mCaptureOriginMicros = 0;
+	bool mBHasCaptureOrigin = false;
 	std::shared_ptr<ofx::MediaPipe::Frame> mFrame;
 	bool mBRecording = false;
 	of::filesystem::path mPath;
@@ -66,7 +150,21 @@ protected:
 	int mHeight = 0;
 	of::filesystem::path mLastPath;
 	
-	ofJson mJson, mFramesJson;
+	RecordingWriter mWriter;
+	RecordingWriter::Settings mWriterSettings;
+	std::size_t mNumWrittenFrames = 0;
+	std::uint64_t mWriteOffset = 0;
+	
+	bool mBBinaryDefault = false;
+	bool mBBinary = false;
+	Frame::KeypointEncoding mKeypointEncoding = Frame::KEYPOINTS_FLOAT32;
+	int mKeyframeInterval = 30;
+	// HAND, FACE and POSE
+	std::array<DeltaCodec, 3> mDeltaCodecs;
+	std::uint32_t mTypes = 0;
+	// 24 bytes per frame, written at the end of .mpbin files
+	std::vector<RecordingReader::FrameInfo> mBinaryInfos;
+	std::map<int, std::string> mBlendShapeNames;
 	
 };
 }
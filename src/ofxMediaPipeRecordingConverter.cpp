@@ -0,0 +1,73 @@
+//
+//  ofxMediaPipeRecordingConverter.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeRecordingConverter.h"
+#include "ofxMediaPipeRecorder.h"
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+bool RecordingConverter::sConvert( const of::filesystem::path& aSrc, const of::filesystem::path& aDst, Frame::KeypointEncoding aencoding ) {
+	RecordingReader reader;
+	// a single pass over the frames, no .idx file is needed
+	reader.setIndexFileEnabled( false );
+	reader.setCacheSize( 1 );
+	if( !reader.open(aSrc) ) {
+		ofLogError("RecordingConverter::sConvert") << "unable to open " << aSrc;
+		return false;
+	}
+	
+	Recorder recorder;
+	// every frame is written, the reader waits for the disk instead
+	auto writerSettings = recorder.getWriterSettings();
+	writerSettings.bBlockWhenFull = true;
+	recorder.setWriterSettings( writerSettings );
+	recorder.setKeypointEncoding( aencoding );
+	auto dir = aDst.parent_path();
+	if( dir.empty() ) {
+		dir = ".";
+	}
+	if( !recorder.startRecording(reader.getWidth(), reader.getHeight(), dir, aDst.filename().string()) ) {
+		ofLogError("RecordingConverter::sConvert") << "unable to write to " << aDst;
+		return false;
+	}
+	
+	size_t numFailed = 0;
+	for( size_t i = 0; i < reader.getNumFrames(); i++ ) {
+		auto frame = reader.getFrame( i );
+		if( !frame ) {
+			numFailed++;
+			continue;
+		}
+		// the recorder writes the blend shapes of a face, decoded frames only have the incoming ones
+		for( auto& face : frame->getFaces() ) {
+			face->updateBlendShapes( face->getIncomingBlendShapes() );
+		}
+		recorder.addFrame( frame );
+	}
+	recorder.stopRecording();
+	
+	if( numFailed > 0 ) {
+		ofLogWarning("RecordingConverter::sConvert") << "skipped " << numFailed << " frames that could not be read from " << aSrc;
+	}
+	ofLogNotice("RecordingConverter::sConvert") << "converted " << recorder.getNumFrames() << " frames from " << aSrc << " to " << aDst;
+	return recorder.getNumFrames() > 0;
+}
+
+//--------------------------------------------------------------
+bool RecordingConverter::sJsonToBinary( const of::filesystem::path& aSrc, Frame::KeypointEncoding aencoding ) {
+	auto dst = aSrc;
+	dst.replace_extension( RecordingReader::sBinaryExtension );
+	return sConvert( aSrc, dst, aencoding );
+}
+
+//--------------------------------------------------------------
+bool RecordingConverter::sBinaryToJson( const of::filesystem::path& aSrc ) {
+	auto dst = aSrc;
+	dst.replace_extension( ".json" );
+	return sConvert( aSrc, dst );
+}
@@ -0,0 +1,22 @@
+//
+//  ofxMediaPipeRecordingConverter.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofxMediaPipeRecordingReader.h"
+
+namespace ofx::MediaPipe {
+// Converts recordings between json and the binary .mpbin format.
+// Frames are streamed through the RecordingReader and written with the Recorder, timestamps are kept.
+class RecordingConverter {
+public:
+	// the format of aDst is picked from its extension, .json or .mpbin. aencoding is used for .mpbin, see Recorder::setKeypointEncoding
+	static bool sConvert( const of::filesystem::path& aSrc, const of::filesystem::path& aDst, Frame::KeypointEncoding aencoding=Frame::KEYPOINTS_FLOAT32 );
+	// replaces the extension of aSrc
+	static bool sJsonToBinary( const of::filesystem::path& aSrc, Frame::KeypointEncoding aencoding=Frame::KEYPOINTS_FLOAT32 );
+	static bool sBinaryToJson( const of::filesystem::path& aSrc );
+};
+}
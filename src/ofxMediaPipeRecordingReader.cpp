@@ -0,0 +1,754 @@
+//
+//  ofxMediaPipeRecordingReader.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeRecordingReader.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using namespace ofx::MediaPipe;
+
+namespace {
+const char kIndexMagic[4] = { 'M', 'P', 'I', 'X' };
+const std::uint32_t kIndexVersion = 1;
+
+//--------------------------------------------------------------
+template<typename T>
+void writeValue( std::ostream& aout, const T& avalue ) {
+	aout.write( reinterpret_cast<const char*>(&avalue), sizeof(T) );
+}
+
+//--------------------------------------------------------------
+template<typename T>
+bool readValue( std::istream& ain, T& avalue ) {
+	ain.read( reinterpret_cast<char*>(&avalue), sizeof(T) );
+	return (bool)ain;
+}
+}
+
+const std::string RecordingReader::sBinaryExtension = ".mpbin";
+
+//--------------------------------------------------------------
+bool RecordingReader::sIsBinaryFile( const of::filesystem::path& afile ) {
+	std::ifstream in( afile, std::ios::in | std::ios::binary );
+	char magic[4];
+	in.read( magic, 4 );
+	return in && memcmp( magic, sBinaryMagic, 4 ) == 0;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::sWriteBinaryHeader( std::ostream& aout, int awidth, int aheight, std::uint32_t aTypes, std::uint64_t aNumFrames, std::uint64_t aIndexOffset ) {
+	aout.write( sBinaryMagic, 4 );
+	writeValue( aout, sBinaryVersion );
+	writeValue( aout, (std::int32_t)awidth );
+	writeValue( aout, (std::int32_t)aheight );
+	writeValue( aout, aTypes );
+	writeValue( aout, (std::uint32_t)0 );
+	writeValue( aout, aNumFrames );
+	writeValue( aout, aIndexOffset );
+	return (bool)aout;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::sWriteBinaryIndex( std::ostream& aout, const std::vector<FrameInfo>& aInfos, const std::map<int, std::string>& aBlendShapeNames ) {
+	const std::uint8_t reserved[3] = {0, 0, 0};
+	for( auto& info : aInfos ) {
+		writeValue( aout, info.offset );
+		writeValue( aout, info.numBytes );
+		writeValue( aout, (std::uint8_t)info.type );
+		aout.write( reinterpret_cast<const char*>(reserved), 3 );
+		writeValue( aout, info.timestamp );
+	}
+	writeValue( aout, (std::uint32_t)aBlendShapeNames.size() );
+	for( auto& name : aBlendShapeNames ) {
+		auto length = std::min( name.second.size(), (size_t)UINT16_MAX );
+		writeValue( aout, (std::uint16_t)name.first );
+		writeValue( aout, (std::uint16_t)length );
+		aout.write( name.second.data(), length );
+	}
+	return (bool)aout;
+}
+
+//--------------------------------------------------------------
+of::filesystem::path RecordingReader::sGetIndexPath( const of::filesystem::path& afile ) {
+	auto ipath = afile;
+	ipath += ".idx";
+	return ipath;
+}
+
+//--------------------------------------------------------------
+void RecordingReader::sApplyOutRect( const std::shared_ptr<Frame>& aframe, const ofRectangle& arect ) {
+	if( !aframe ) {
+		return;
+	}
+	auto convert = [&arect]( std::vector<TrackedObject::Keypoint>& apts ) {
+		for( auto& kp : apts ) {
+			kp.pos = kp.posN;
+			kp.pos.x *= arect.width;
+			kp.pos.y *= arect.height;
+			kp.pos.x += arect.x;
+			kp.pos.y += arect.y;
+
+			kp.pos.z *= arect.width;
+		}
+	};
+	for( auto& face : aframe->getFaces() ) {
+		convert(face->keypoints);
+	}
+	for( auto& hand : aframe->getHands() ) {
+		convert(hand->keypoints);
+	}
+	for( auto& pose : aframe->getPoses() ) {
+		convert(pose->keypoints);
+	}
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::open( const of::filesystem::path& afile ) {
+	close();
+	if( afile.empty() ) {
+		return false;
+	}
+
+	std::error_code ec;
+	mFileSize = (std::uint64_t)of::filesystem::file_size( afile, ec );
+	if( ec ) {
+		ofLogError("RecordingReader::open") << "unable to find " << afile;
+		return false;
+	}
+	mFileTime = (std::int64_t)of::filesystem::last_write_time( afile, ec ).time_since_epoch().count();
+
+	mFile.open( afile, std::ios::in | std::ios::binary );
+	if( !mFile.is_open() ) {
+		ofLogError("RecordingReader::open") << "unable to open " << afile;
+		return false;
+	}
+	mFilepath = afile;
+
+	char magic[4] = {0, 0, 0, 0};
+	mFile.read( magic, 4 );
+	mBBinary = mFile && memcmp( magic, sBinaryMagic, 4 ) == 0;
+	mFile.clear();
+
+	auto indexPath = sGetIndexPath( afile );
+	if( mBBinary ) {
+		if( !_openBinary() ) {
+			ofLogError("RecordingReader::open") << "could not read the binary recording " << afile;
+			close();
+			return false;
+		}
+	} else if( !(mBIndexFileEnabled && _loadIndex( indexPath )) ) {
+		auto startMillis = ofGetElapsedTimeMillis();
+		if( !_buildIndex() ) {
+			ofLogError("RecordingReader::open") << "could not find frames in " << afile;
+			close();
+			return false;
+		}
+		ofLogVerbose("RecordingReader::open") << "indexed " << mFrameInfos.size() << " frames in " << (ofGetElapsedTimeMillis() - startMillis) << "ms";
+		if( mBIndexFileEnabled && !_saveIndex(indexPath) ) {
+			ofLogVerbose("RecordingReader::open") << "unable to save the index to " << indexPath;
+		}
+	}
+
+	// seeking is a binary search, the recorder writes in order but the timestamps can be set with Recorder::addFrame
+	auto sortByTime = []( const FrameInfo& aa, const FrameInfo& ab ) { return aa.timestamp < ab.timestamp; };
+	if( !std::is_sorted(mFrameInfos.begin(), mFrameInfos.end(), sortByTime) ) {
+		std::stable_sort( mFrameInfos.begin(), mFrameInfos.end(), sortByTime );
+	}
+
+	mDuration = 0;
+	mTypes = 0;
+	for( auto& indices : mTypeFrameIndices ) {
+		indices.clear();
+	}
+	for( size_t i = 0; i < mFrameInfos.size(); i++ ) {
+		auto& info = mFrameInfos[i];
+		if( info.timestamp > mDuration ) {
+			mDuration = info.timestamp;
+		}
+		mTypes |= (1u << (std::uint32_t)info.type);
+		if( (size_t)info.type < mTypeFrameIndices.size() ) {
+			mTypeFrameIndices[(size_t)info.type].push_back( (std::uint32_t)i );
+		}
+	}
+
+	if( mBMemoryMapEnabled && !mMappedFile.open(afile) ) {
+		ofLogVerbose("RecordingReader::open") << "unable to map " << afile << ", frames are read from the file";
+	}
+	mBOpen = true;
+	return true;
+}
+
+//--------------------------------------------------------------
+void RecordingReader::close() {
+	if( mFile.is_open() ) {
+		mFile.close();
+	}
+	mFile.clear();
+	mMappedFile.close();
+	for( auto& indices : mTypeFrameIndices ) {
+		indices.clear();
+	}
+	mFilepath.clear();
+	mFrameInfos.clear();
+	mCache.clear();
+	mBlendShapeNames.clear();
+	for( auto& codec : mDeltaCodecs ) {
+		codec.reset();
+	}
+	mDeltaPositions.fill( -1 );
+	mDeltaFrame.reset();
+	mBBinary = false;
+	mTypes = 0;
+	mWidth = mHeight = 0;
+	mDuration = 0;
+	mFileSize = 0;
+	mFileTime = 0;
+	mBOpen = false;
+}
+
+//--------------------------------------------------------------
+std::shared_ptr<Frame> RecordingReader::getFrame( size_t aindex ) {
+	if( aindex >= mFrameInfos.size() || !mFile.is_open() ) {
+		return nullptr;
+	}
+	for( auto it = mCache.begin(); it != mCache.end(); it++ ) {
+		if( it->first == aindex ) {
+			if( it != mCache.begin() ) {
+				mCache.splice( mCache.begin(), mCache, it );
+			}
+			return mCache.front().second;
+		}
+	}
+
+	const auto& info = mFrameInfos[aindex];
+	const char* data = _getFrameData( info );
+	DeltaCodec* deltaCodec = nullptr;
+	Frame::KeypointEncoding encoding = Frame::KEYPOINTS_FLOAT32;
+	if( mBBinary && data && Frame::sReadBinaryKeypointEncoding(data, info.numBytes, encoding) && encoding == Frame::KEYPOINTS_DELTA ) {
+		deltaCodec = _prepareDeltaCodec( aindex );
+		// the records before were read into the same buffer
+		data = deltaCodec ? _getFrameData( info ) : nullptr;
+	}
+	if( !data ) {
+		ofLogError("RecordingReader::getFrame") << "unable to read frame " << aindex << " from " << mFilepath;
+		return nullptr;
+	}
+
+	std::shared_ptr<Frame> frame;
+	auto recycleIt = mCache.end();
+	if( mBBinary && mCache.size() >= std::max((size_t)1, mCacheSize) ) {
+		// decode into the least recently used frame of the same type that nobody else holds,
+		// so that the frame and its objects are not allocated again
+		for( auto it = mCache.rbegin(); it != mCache.rend(); it++ ) {
+			if( it->second.use_count() == 1 && mFrameInfos[it->first].type == info.type ) {
+				recycleIt = std::prev( it.base() );
+				frame = it->second;
+				break;
+			}
+		}
+	}
+	if( !frame ) {
+		frame = std::make_shared<Frame>();
+	}
+	if( mBBinary ) {
+		bool bSetup = frame->setup( data, info.numBytes, mBlendShapeNames, deltaCodec );
+		if( deltaCodec ) {
+			auto& indices = mTypeFrameIndices[(size_t)info.type];
+			mDeltaPositions[(size_t)info.type] = (long long)(std::lower_bound( indices.begin(), indices.end(), (std::uint32_t)aindex ) - indices.begin());
+		}
+		if( !bSetup ) {
+			if( recycleIt != mCache.end() ) {
+				mCache.erase( recycleIt );
+			}
+			return nullptr;
+		}
+	} else {
+		try {
+			ofJson jframe = ofJson::parse( data, data + info.numBytes );
+			if( !frame->setup(jframe) ) {
+				return nullptr;
+			}
+		} catch( std::exception& e ) {
+			ofLogError("RecordingReader::getFrame") << "unable to parse frame " << aindex << ": " << e.what();
+			return nullptr;
+		}
+	}
+	if( mOutRect.width > 0 && mOutRect.height > 0 ) {
+		sApplyOutRect( frame, mOutRect );
+	}
+
+	if( recycleIt != mCache.end() ) {
+		recycleIt->first = aindex;
+		mCache.splice( mCache.begin(), mCache, recycleIt );
+		return frame;
+	}
+	mCache.emplace_front( aindex, frame );
+	while( mCache.size() > std::max((size_t)1, mCacheSize) ) {
+		mCache.pop_back();
+	}
+	return frame;
+}
+
+//--------------------------------------------------------------
+const std::vector<std::uint32_t>& RecordingReader::getFrameIndices( TrackedObject::TrackedObjectType atype ) {
+	if( (size_t)atype >= mTypeFrameIndices.size() ) {
+		return mEmptyIndices;
+	}
+	return mTypeFrameIndices[(size_t)atype];
+}
+
+//--------------------------------------------------------------
+size_t RecordingReader::getFrameIndexAfterNanos( std::int64_t anano ) {
+	auto it = std::upper_bound( mFrameInfos.begin(), mFrameInfos.end(), anano, []( std::int64_t at, const FrameInfo& ainfo ) {
+		return at < ainfo.timestamp;
+	});
+	return (size_t)(it - mFrameInfos.begin());
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::getLastFrameIndex( TrackedObject::TrackedObjectType atype, size_t aMaxIndex, size_t& aOutIndex ) {
+	const auto& indices = getFrameIndices( atype );
+	auto it = std::upper_bound( indices.begin(), indices.end(), aMaxIndex, []( size_t ai, std::uint32_t aindex ) {
+		return ai < (size_t)aindex;
+	});
+	if( it == indices.begin() ) {
+		return false;
+	}
+	aOutIndex = *(it - 1);
+	return true;
+}
+
+//--------------------------------------------------------------
+void RecordingReader::setCacheSize( size_t asize ) {
+	mCacheSize = std::max( (size_t)1, asize );
+	while( mCache.size() > mCacheSize ) {
+		mCache.pop_back();
+	}
+}
+
+//--------------------------------------------------------------
+void RecordingReader::setOutRect( const ofRectangle& arect ) {
+	if( mOutRect != arect ) {
+		for( auto& cached : mCache ) {
+			sApplyOutRect( cached.second, arect );
+		}
+	}
+	mOutRect = arect;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::_buildIndex() {
+	// Scans the structure of the json without building it. Only the scalar values of the root object
+	// (width and height) and of the frame objects (timestamp, type and num) are kept,
+	// everything else is skipped while counting the depth.
+	mFrameInfos.clear();
+	mWidth = mHeight = 0;
+
+	mFile.clear();
+	mFile.seekg( 0 );
+
+	std::vector<char> buffer( 1 << 20 );
+	std::uint64_t pos = 0;
+	int depth = 0;
+	bool bInString = false;
+	bool bEscape = false;
+	bool bStringIsKey = false;
+	bool bStringIsValue = false;
+	bool bExpectKey = false;
+	// depth of the frame objects, inside the frames array
+	int framesDepth = -1;
+	bool bCapturingValue = false;
+	std::string key, lastKey, value;
+
+	FrameInfo info;
+	int frameNum = -1;
+
+	auto isTrackedLevel = [&]() {
+		return depth == 1 || (framesDepth > 0 && depth == framesDepth + 1);
+	};
+
+	auto finishValue = [&]() {
+		bCapturingValue = false;
+		if( depth == 1 ) {
+			if( lastKey == "width" ) mWidth = ofToInt( value );
+			else if( lastKey == "height" ) mHeight = ofToInt( value );
+		} else {
+			if( lastKey == "timestamp" ) info.timestamp = std::strtoll( value.c_str(), nullptr, 10 );
+			else if( lastKey == "type" ) info.type = TrackedObject::sGetTypeFromString( value );
+			else if( lastKey == "num" ) frameNum = ofToInt( value );
+		}
+	};
+
+	while( mFile ) {
+		mFile.read( buffer.data(), buffer.size() );
+		auto numRead = (size_t)mFile.gcount();
+		if( numRead == 0 ) {
+			break;
+		}
+		for( size_t i = 0; i < numRead; i++, pos++ ) {
+			char c = buffer[i];
+			if( bInString ) {
+				if( bEscape ) {
+					bEscape = false;
+				} else if( c == '\\' ) {
+					bEscape = true;
+					continue;
+				} else if( c == '"' ) {
+					bInString = false;
+					if( bStringIsKey ) {
+						lastKey = key;
+					}
+					continue;
+				}
+				if( bStringIsKey && key.size() < 64 ) {
+					key += c;
+				} else if( bStringIsValue && value.size() < 64 ) {
+					value += c;
+				}
+				continue;
+			}
+
+			switch( c ) {
+				case '"':
+					bInString = true;
+					bStringIsKey = bExpectKey && isTrackedLevel();
+					bStringIsValue = !bStringIsKey && bCapturingValue;
+					if( bStringIsKey ) {
+						key.clear();
+					}
+					break;
+				case '{':
+				case '[':
+					// objects and arrays are not kept
+					bCapturingValue = false;
+					if( c == '[' && depth == 1 && lastKey == "frames" && framesDepth < 0 ) {
+						framesDepth = depth + 1;
+					}
+					if( c == '{' && framesDepth > 0 && depth == framesDepth ) {
+						info = FrameInfo();
+						info.offset = pos;
+						frameNum = -1;
+					}
+					depth++;
+					bExpectKey = (c == '{');
+					break;
+				case '}':
+				case ']':
+					if( bCapturingValue ) {
+						finishValue();
+					}
+					depth--;
+					bExpectKey = false;
+					if( c == '}' && framesDepth > 0 && depth == framesDepth ) {
+						info.numBytes = (std::uint32_t)(pos + 1 - info.offset);
+						// frames without objects were skipped when the whole file was loaded
+						if( frameNum != 0 ) {
+							mFrameInfos.push_back( info );
+						}
+					} else if( c == ']' && framesDepth > 0 && depth == framesDepth - 1 ) {
+						framesDepth = -1;
+					}
+					break;
+				case ',':
+					if( bCapturingValue && isTrackedLevel() ) {
+						finishValue();
+					}
+					bExpectKey = true;
+					break;
+				case ':':
+					if( isTrackedLevel() ) {
+						bCapturingValue = true;
+						value.clear();
+					}
+					bExpectKey = false;
+					break;
+				case ' ':
+				case '\t':
+				case '\n':
+				case '\r':
+					break;
+				default:
+					// numbers, true, false and null
+					if( bCapturingValue && value.size() < 64 ) {
+						value += c;
+					}
+					break;
+			}
+		}
+	}
+	mFile.clear();
+	return mFrameInfos.size() > 0;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::_loadIndex( const of::filesystem::path& aIndexPath ) {
+	std::error_code ec;
+	if( !of::filesystem::exists(aIndexPath, ec) ) {
+		return false;
+	}
+	std::ifstream in( aIndexPath, std::ios::in | std::ios::binary );
+	if( !in.is_open() ) {
+		return false;
+	}
+	char magic[4];
+	in.read( magic, 4 );
+	std::uint32_t version = 0;
+	std::uint64_t fileSize = 0;
+	std::int64_t fileTime = 0;
+	std::int32_t width = 0, height = 0;
+	std::uint64_t numFrames = 0;
+	if( !in || memcmp(magic, kIndexMagic, 4) != 0 || !readValue(in, version) || version != kIndexVersion ) {
+		return false;
+	}
+	if( !readValue(in, fileSize) || !readValue(in, fileTime) || !readValue(in, width) || !readValue(in, height) || !readValue(in, numFrames) ) {
+		return false;
+	}
+	// the recording changed since the index was saved
+	if( fileSize != mFileSize || fileTime != mFileTime ) {
+		return false;
+	}
+
+	// a corrupt number of frames falls back to building the index instead of allocating it.
+	// entry: u64 offset, u32 numBytes, i64 timestamp, i32 type
+	const std::uint64_t entryBytes = 24;
+	auto indexSize = (std::uint64_t)of::filesystem::file_size( aIndexPath, ec );
+	auto headerEnd = (std::uint64_t)in.tellg();
+	if( ec || indexSize < headerEnd || numFrames > (indexSize - headerEnd) / entryBytes ) {
+		return false;
+	}
+	
+	std::vector<FrameInfo> infos( numFrames );
+	for( auto& info : infos ) {
+		std::int32_t type = 0;
+		if( !readValue(in, info.offset) || !readValue(in, info.numBytes) || !readValue(in, info.timestamp) || !readValue(in, type) ) {
+			return false;
+		}
+		if( info.offset > mFileSize || info.numBytes > mFileSize - info.offset ) {
+			return false;
+		}
+		info.type = (TrackedObject::TrackedObjectType)type;
+	}
+	mWidth = width;
+	mHeight = height;
+	mFrameInfos = std::move(infos);
+	return mFrameInfos.size() > 0;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::_saveIndex( const of::filesystem::path& aIndexPath ) {
+	// native byte order, the index is only a cache of the recording
+	std::ofstream out( aIndexPath, std::ios::out | std::ios::binary | std::ios::trunc );
+	if( !out.is_open() ) {
+		return false;
+	}
+	out.write( kIndexMagic, 4 );
+	writeValue( out, kIndexVersion );
+	writeValue( out, mFileSize );
+	writeValue( out, mFileTime );
+	writeValue( out, (std::int32_t)mWidth );
+	writeValue( out, (std::int32_t)mHeight );
+	writeValue( out, (std::uint64_t)mFrameInfos.size() );
+	for( auto& info : mFrameInfos ) {
+		writeValue( out, info.offset );
+		writeValue( out, info.numBytes );
+		writeValue( out, info.timestamp );
+		writeValue( out, (std::int32_t)info.type );
+	}
+	return (bool)out;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::_openBinary() {
+	mFrameInfos.clear();
+	mBlendShapeNames.clear();
+
+	mFile.clear();
+	mFile.seekg( 4 );
+	std::uint32_t version = 0, types = 0, reserved = 0;
+	std::int32_t width = 0, height = 0;
+	std::uint64_t numFrames = 0, indexOffset = 0;
+	if( !readValue(mFile, version) || !readValue(mFile, width) || !readValue(mFile, height) || !readValue(mFile, types)
+	   || !readValue(mFile, reserved) || !readValue(mFile, numFrames) || !readValue(mFile, indexOffset) ) {
+		return false;
+	}
+	if( version < sBinaryMinVersion || version > sBinaryVersion ) {
+		ofLogError("RecordingReader::_openBinary") << "unsupported version " << version << " in " << mFilepath;
+		return false;
+	}
+	mWidth = width;
+	mHeight = height;
+
+	if( indexOffset >= sBinaryHeaderSize && indexOffset < mFileSize && _loadBinaryIndex(indexOffset, numFrames) ) {
+		return true;
+	}
+	ofLogWarning("RecordingReader::_openBinary") << "no index in " << mFilepath << ", the recording was not finished. Scanning the frames.";
+	mFrameInfos.clear();
+	mBlendShapeNames.clear();
+	return _scanBinaryRecords();
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::_loadBinaryIndex( std::uint64_t aIndexOffset, std::uint64_t aNumFrames ) {
+	const std::uint64_t entryBytes = 24;
+	// divided, so that a corrupt number of frames can not wrap around
+	if( aIndexOffset > mFileSize || aNumFrames > (mFileSize - aIndexOffset) / entryBytes ) {
+		return false;
+	}
+	// one read for the whole index
+	mReadBuffer.resize( (size_t)(mFileSize - aIndexOffset) );
+	mFile.clear();
+	mFile.seekg( (std::streamoff)aIndexOffset );
+	mFile.read( &mReadBuffer[0], mReadBuffer.size() );
+	if( !mFile ) {
+		return false;
+	}
+	const char* data = mReadBuffer.data();
+	const char* end = data + mReadBuffer.size();
+
+	mFrameInfos.reserve( (size_t)aNumFrames );
+	for( std::uint64_t i = 0; i < aNumFrames; i++ ) {
+		FrameInfo info;
+		memcpy( &info.offset, data, 8 );
+		memcpy( &info.numBytes, data + 8, 4 );
+		info.type = (TrackedObject::TrackedObjectType)(std::uint8_t)data[12];
+		memcpy( &info.timestamp, data + 16, 8 );
+		data += entryBytes;
+		if( info.offset < sBinaryHeaderSize || info.offset > aIndexOffset || info.numBytes > aIndexOffset - info.offset ) {
+			return false;
+		}
+		// frames without objects are skipped, the same as in json recordings
+		if( info.numBytes > Frame::sBinaryRecordHeaderSize ) {
+			mFrameInfos.push_back( info );
+		}
+	}
+
+	std::uint32_t numNames = 0;
+	if( data + 4 > end ) {
+		return false;
+	}
+	memcpy( &numNames, data, 4 );
+	data += 4;
+	for( std::uint32_t i = 0; i < numNames; i++ ) {
+		std::uint16_t index = 0, length = 0;
+		if( data + 4 > end ) {
+			return false;
+		}
+		memcpy( &index, data, 2 );
+		memcpy( &length, data + 2, 2 );
+		data += 4;
+		if( data + length > end ) {
+			return false;
+		}
+		mBlendShapeNames[index] = std::string( data, length );
+		data += length;
+	}
+	return mFrameInfos.size() > 0;
+}
+
+//--------------------------------------------------------------
+bool RecordingReader::_scanBinaryRecords() {
+	// walks the records by their size, only the record headers are read
+	char header[Frame::sBinaryRecordHeaderSize];
+	std::uint64_t offset = sBinaryHeaderSize;
+	while( offset + Frame::sBinaryRecordHeaderSize <= mFileSize ) {
+		mFile.clear();
+		mFile.seekg( (std::streamoff)offset );
+		mFile.read( header, Frame::sBinaryRecordHeaderSize );
+		FrameInfo info;
+		info.offset = offset;
+		if( !mFile || !Frame::sReadBinaryHeader(header, Frame::sBinaryRecordHeaderSize, info.numBytes, info.timestamp, info.type) ) {
+			break;
+		}
+		// the last record was not written completely
+		if( offset + info.numBytes > mFileSize ) {
+			break;
+		}
+		if( info.numBytes > Frame::sBinaryRecordHeaderSize ) {
+			mFrameInfos.push_back( info );
+		}
+		offset += info.numBytes;
+	}
+	mFile.clear();
+	return mFrameInfos.size() > 0;
+}
+
+//--------------------------------------------------------------
+DeltaCodec* RecordingReader::_prepareDeltaCodec( size_t aindex ) {
+	size_t type = (size_t)mFrameInfos[aindex].type;
+	if( type >= mDeltaCodecs.size() ) {
+		return nullptr;
+	}
+	const auto& indices = mTypeFrameIndices[type];
+	auto it = std::lower_bound( indices.begin(), indices.end(), (std::uint32_t)aindex );
+	if( it == indices.end() || *it != aindex ) {
+		return nullptr;
+	}
+	long long pos = (long long)(it - indices.begin());
+	auto& codec = mDeltaCodecs[type];
+	long long lastPos = mDeltaPositions[type];
+	if( lastPos == pos - 1 && lastPos >= 0 ) {
+		// played in order
+		return &codec;
+	}
+	
+	// the closest keyframe at or before the record, records that are not delta encoded do not depend on the ones before
+	long long start = pos;
+	for( ; start > 0; start-- ) {
+		const auto& sinfo = mFrameInfos[indices[start]];
+		const char* sdata = _getFrameData( sinfo );
+		Frame::KeypointEncoding sencoding = Frame::KEYPOINTS_FLOAT32;
+		bool bKeyframe = false;
+		if( !sdata || !Frame::sReadBinaryKeypointEncoding(sdata, sinfo.numBytes, sencoding) ) {
+			return nullptr;
+		}
+		if( sencoding != Frame::KEYPOINTS_DELTA ) {
+			break;
+		}
+		if( DeltaCodec::sIsKeyframe(sdata + Frame::sBinaryRecordHeaderSize, sinfo.numBytes - Frame::sBinaryRecordHeaderSize, bKeyframe) && bKeyframe ) {
+			break;
+		}
+	}
+	if( start == pos ) {
+		return &codec;
+	}
+	// a forward seek within the same keyframe interval continues from the last decoded record
+	long long from = (lastPos >= start && lastPos < pos) ? lastPos + 1 : start;
+	if( !mDeltaFrame ) {
+		mDeltaFrame = std::make_shared<Frame>();
+	}
+	for( long long p = from; p < pos; p++ ) {
+		const auto& pinfo = mFrameInfos[indices[p]];
+		const char* pdata = _getFrameData( pinfo );
+		if( !pdata ) {
+			mDeltaPositions[type] = -1;
+			return nullptr;
+		}
+		// records without objects return false, the codec still reads their header
+		mDeltaFrame->setup( pdata, pinfo.numBytes, mBlendShapeNames, &codec );
+		mDeltaPositions[type] = p;
+	}
+	return &codec;
+}
+
+//--------------------------------------------------------------
+const char* RecordingReader::_getFrameData( const FrameInfo& ainfo ) {
+	if( mMappedFile.isOpen() && ainfo.offset + ainfo.numBytes <= mMappedFile.getSize() ) {
+		return mMappedFile.getData() + ainfo.offset;
+	}
+	if( !mFile.is_open() ) {
+		return nullptr;
+	}
+	mReadBuffer.resize( ainfo.numBytes );
+	mFile.clear();
+	mFile.seekg( (std::streamoff)ainfo.offset );
+	mFile.read( &mReadBuffer[0], ainfo.numBytes );
+	if( !mFile ) {
+		return nullptr;
+	}
+	return mReadBuffer.data();
+}
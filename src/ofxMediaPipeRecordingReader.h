@@ -0,0 +1,145 @@
+//
+//  ofxMediaPipeRecordingReader.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofxMediaPipeFrame.h"
+#include "ofxMediaPipeMappedFile.h"
+#include "ofRectangle.h"
+#include <array>
+#include <fstream>
+#include <list>
+#include <map>
+
+namespace ofx::MediaPipe {
+// Reads recordings saved by the Recorder without loading the whole file.
+// open() stores the byte range, timestamp and type of every frame,
+// frames are parsed when they are requested and only the most recent ones are kept in memory.
+// Json recordings are scanned once and the index is saved next to the recording (.idx) so that opening it again skips the scan.
+// Binary recordings (.mpbin) are detected from the first bytes and carry their index at the end of the file.
+// The file is memory mapped when possible, so frames are decoded in place without a read per frame.
+// Frame::KEYPOINTS_DELTA records depend on the record of the type before them, reading out of order
+// decodes the records from the keyframe before the requested one.
+class RecordingReader {
+public:
+	struct FrameInfo {
+		std::uint64_t offset = 0;
+		std::uint32_t numBytes = 0;
+		std::int64_t timestamp = 0; // nanoseconds
+		TrackedObject::TrackedObjectType type = TrackedObject::HAND;
+	};
+
+	// .mpbin layout, in the byte order of the machine that recorded it, ie. little endian on x86 and arm64:
+	// header: "MPBN", u32 version, i32 width, i32 height, u32 types (1 << TrackedObjectType), u32 reserved, u64 numFrames, u64 indexOffset
+	// frame records, see Frame::sAppendBinary
+	// index at indexOffset: (u64 offset, u32 numBytes, u8 type, u8 reserved[3], i64 timestamp)[numFrames],
+	//                       u32 numNames, (u16 index, u16 length, chars)[numNames] blend shape names
+	// indexOffset is 0 until the Recorder finishes, the records are scanned in that case.
+	static constexpr char sBinaryMagic[4] = { 'M', 'P', 'B', 'N' };
+	// version 1 records always hold float32 keypoints, the byte after the type was reserved
+	static constexpr std::uint32_t sBinaryVersion = 2;
+	static constexpr std::uint32_t sBinaryMinVersion = 1;
+	static constexpr size_t sBinaryHeaderSize = 40;
+	static const std::string sBinaryExtension;
+	
+	static bool sIsBinaryFile( const of::filesystem::path& afile );
+	// shared with the Recorder so that the layout is defined in one place
+	static bool sWriteBinaryHeader( std::ostream& aout, int awidth, int aheight, std::uint32_t aTypes, std::uint64_t aNumFrames, std::uint64_t aIndexOffset );
+	static bool sWriteBinaryIndex( std::ostream& aout, const std::vector<FrameInfo>& aInfos, const std::map<int, std::string>& aBlendShapeNames );
+	
+	static of::filesystem::path sGetIndexPath( const of::filesystem::path& afile );
+	// sets the pixel positions of the keypoints from the normalized positions
+	static void sApplyOutRect( const std::shared_ptr<Frame>& aframe, const ofRectangle& arect );
+
+	bool open( const of::filesystem::path& afile );
+	void close();
+	bool isOpen() { return mBOpen; }
+	bool isBinary() { return mBBinary; }
+	// bit mask of the tracked object types in the recording, 1 << TrackedObjectType
+	std::uint32_t getTypes() { return mTypes; }
+
+	int getWidth() { return mWidth; }
+	int getHeight() { return mHeight; }
+	// the largest frame timestamp
+	std::int64_t getDurationNanos() { return mDuration; }
+
+	size_t getNumFrames() { return mFrameInfos.size(); }
+	// sorted by timestamp
+	const std::vector<FrameInfo>& getFrameInfos() { return mFrameInfos; }
+	// indices into the frame infos of the frames of a type
+	const std::vector<std::uint32_t>& getFrameIndices( TrackedObject::TrackedObjectType atype );
+	
+	// binary searches of the timestamps
+	// index of the first frame with a timestamp after anano, getNumFrames() if there is none
+	size_t getFrameIndexAfterNanos( std::int64_t anano );
+	// the last frame of the type at or before aMaxIndex, returns false if there is none
+	bool getLastFrameIndex( TrackedObject::TrackedObjectType atype, size_t aMaxIndex, size_t& aOutIndex );
+
+	// parses the frame or returns it from the cache, nullptr if it can not be read
+	std::shared_ptr<Frame> getFrame( size_t aindex );
+
+	// number of decoded frames kept in memory
+	void setCacheSize( size_t asize );
+	size_t getCacheSize() { return mCacheSize; }
+
+	// applied to frames when they are decoded and to the frames in the cache
+	void setOutRect( const ofRectangle& arect );
+
+	// enabled by default, takes effect on the next open
+	void setMemoryMapEnabled( bool ab ) { mBMemoryMapEnabled = ab; }
+	bool isMemoryMapEnabled() { return mBMemoryMapEnabled; }
+	bool isMemoryMapped() { return mMappedFile.isOpen(); }
+	
+	// reading and writing the .idx file, enabled by default
+	void setIndexFileEnabled( bool ab ) { mBIndexFileEnabled = ab; }
+	bool isIndexFileEnabled() { return mBIndexFileEnabled; }
+
+protected:
+	bool _buildIndex();
+	bool _loadIndex( const of::filesystem::path& aIndexPath );
+	bool _saveIndex( const of::filesystem::path& aIndexPath );
+	bool _openBinary();
+	bool _loadBinaryIndex( std::uint64_t aIndexOffset, std::uint64_t aNumFrames );
+	bool _scanBinaryRecords();
+	// points to the bytes of the frame in the mapped file, or reads them into mReadBuffer
+	const char* _getFrameData( const FrameInfo& ainfo );
+	// decodes the records of the type before aindex that the delta encoded record at aindex depends on
+	DeltaCodec* _prepareDeltaCodec( size_t aindex );
+
+	std::ifstream mFile;
+	MappedFile mMappedFile;
+	bool mBMemoryMapEnabled = true;
+	of::filesystem::path mFilepath;
+	std::uint64_t mFileSize = 0;
+	std::int64_t mFileTime = 0;
+	bool mBOpen = false;
+	bool mBIndexFileEnabled = true;
+	bool mBBinary = false;
+	std::uint32_t mTypes = 0;
+	std::map<int, std::string> mBlendShapeNames;
+
+	int mWidth = 0;
+	int mHeight = 0;
+	std::int64_t mDuration = 0;
+	std::vector<FrameInfo> mFrameInfos;
+	// HAND, FACE and POSE
+	std::array<std::vector<std::uint32_t>, 3> mTypeFrameIndices;
+	std::vector<std::uint32_t> mEmptyIndices;
+
+	ofRectangle mOutRect;
+	// most recently used at the front
+	std::list< std::pair<size_t, std::shared_ptr<Frame>> > mCache;
+	size_t mCacheSize = 8;
+	std::string mReadBuffer;
+
+	// decoding state of the delta encoded records of HAND, FACE and POSE
+	std::array<DeltaCodec, 3> mDeltaCodecs;
+	// position in the frame indices of the type of the record that the codec decoded last, -1 for none
+	std::array<long long, 3> mDeltaPositions = {{ -1, -1, -1 }};
+	// receives the records that are decoded to catch up
+	std::shared_ptr<Frame> mDeltaFrame;
+};
+}
@@ -0,0 +1,217 @@
+//
+//  ofxMediaPipeRecordingWriter.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeRecordingWriter.h"
+#include "ofLog.h"
+#include <chrono>
+
+#if defined(TARGET_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+RecordingWriter::RecordingWriter() {
+
+}
+
+//--------------------------------------------------------------
+RecordingWriter::~RecordingWriter() {
+	if( isOpen() ) {
+		close( "", "" );
+	}
+}
+
+//--------------------------------------------------------------
+bool RecordingWriter::open( const of::filesystem::path& afile, const Settings& asettings ) {
+	if( isOpen() ) {
+		ofLogWarning("RecordingWriter::open") << "already writing to " << mPath;
+		return false;
+	}
+	mFile = fopen( afile.string().c_str(), "wb" );
+	if( !mFile ) {
+		ofLogError("RecordingWriter::open") << "unable to open " << afile;
+		return false;
+	}
+	// the buffers are written in large blocks by the thread
+	setvbuf( mFile, nullptr, _IOFBF, 1 << 16 );
+
+	mPath = afile;
+	mSettings = asettings;
+	mSettings.maxQueuedBuffers = std::max( (size_t)1, mSettings.maxQueuedBuffers );
+	mBytesSinceSync = 0;
+	mNumDropped = 0;
+	mNumBytesWritten = 0;
+	mNumSyncs = 0;
+	mBError = false;
+	{
+		std::lock_guard<std::mutex> lck( mMutex );
+		mQueue.clear();
+	}
+	mBRunning = true;
+	mThread = std::thread( &RecordingWriter::_threadedFunction, this );
+	return true;
+}
+
+//--------------------------------------------------------------
+bool RecordingWriter::close( const std::string& aTail, const std::string& aHeader ) {
+	if( !isOpen() ) {
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> lck( mMutex );
+		mBRunning = false;
+	}
+	mCondition.notify_all();
+	mSpaceCondition.notify_all();
+	// the thread writes the remaining buffers before exiting
+	if( mThread.joinable() ) {
+		mThread.join();
+	}
+
+	if( !aTail.empty() ) {
+		_write( aTail );
+	}
+	if( !aHeader.empty() ) {
+		fflush( mFile );
+		if( fseek(mFile, 0, SEEK_SET) != 0 || fwrite(aHeader.data(), 1, aHeader.size(), mFile) != aHeader.size() ) {
+			mBError = true;
+		}
+	}
+	_sync();
+	if( fclose(mFile) != 0 ) {
+		mBError = true;
+	}
+	mFile = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lck( mMutex );
+		mFreeBuffers.clear();
+	}
+	if( mBError.load() ) {
+		ofLogError("RecordingWriter::close") << "error writing to " << mPath;
+	}
+	if( mNumDropped.load() > 0 ) {
+		ofLogWarning("RecordingWriter::close") << "dropped " << mNumDropped.load() << " frames because the disk could not keep up, " << mPath;
+	}
+	return !mBError.load();
+}
+
+//--------------------------------------------------------------
+std::string RecordingWriter::getBuffer() {
+	std::lock_guard<std::mutex> lck( mMutex );
+	if( mFreeBuffers.empty() ) {
+		return std::string();
+	}
+	std::string buffer = std::move( mFreeBuffers.front() );
+	mFreeBuffers.pop_front();
+	return buffer;
+}
+
+//--------------------------------------------------------------
+bool RecordingWriter::push( std::string&& abuffer ) {
+	{
+		std::unique_lock<std::mutex> lck( mMutex );
+		if( mSettings.bBlockWhenFull ) {
+			mSpaceCondition.wait( lck, [this]{ return mQueue.size() < mSettings.maxQueuedBuffers || !mBRunning.load(); });
+		}
+		if( !mBRunning.load() || mQueue.size() >= mSettings.maxQueuedBuffers ) {
+			mNumDropped++;
+			return false;
+		}
+		mQueue.push_back( std::move(abuffer) );
+	}
+	mCondition.notify_one();
+	return true;
+}
+
+//--------------------------------------------------------------
+size_t RecordingWriter::getNumQueued() {
+	std::lock_guard<std::mutex> lck( mMutex );
+	return mQueue.size();
+}
+
+//--------------------------------------------------------------
+void RecordingWriter::_threadedFunction() {
+	auto lastFlush = std::chrono::steady_clock::now();
+	auto flushInterval = std::chrono::milliseconds( mSettings.flushIntervalMillis );
+	std::deque<std::string> buffers;
+
+	while( true ) {
+		bool bRunning = true;
+		{
+			std::unique_lock<std::mutex> lck( mMutex );
+			mCondition.wait_for( lck, flushInterval, [this]{ return !mQueue.empty() || !mBRunning.load(); });
+			// take everything that is queued, the lock is not held while writing
+			buffers.swap( mQueue );
+			bRunning = mBRunning.load();
+		}
+		mSpaceCondition.notify_all();
+
+		for( auto& buffer : buffers ) {
+			_write( buffer );
+		}
+
+		if( !buffers.empty() ) {
+			std::lock_guard<std::mutex> lck( mMutex );
+			for( auto& buffer : buffers ) {
+				// face frames in json are large, only a few are kept around
+				if( mFreeBuffers.size() >= std::min(mSettings.maxQueuedBuffers, (size_t)16) ) {
+					break;
+				}
+				buffer.clear();
+				mFreeBuffers.push_back( std::move(buffer) );
+			}
+		}
+		buffers.clear();
+
+		auto now = std::chrono::steady_clock::now();
+		if( mBytesSinceSync >= mSettings.chunkBytes ) {
+			_sync();
+			lastFlush = now;
+		} else if( now - lastFlush >= flushInterval ) {
+			fflush( mFile );
+			lastFlush = now;
+		}
+
+		if( !bRunning ) {
+			break;
+		}
+	}
+}
+
+//--------------------------------------------------------------
+bool RecordingWriter::_write( const std::string& abuffer ) {
+	if( abuffer.empty() ) {
+		return true;
+	}
+	if( fwrite(abuffer.data(), 1, abuffer.size(), mFile) != abuffer.size() ) {
+		if( !mBError.load() ) {
+			ofLogError("RecordingWriter::_write") << "unable to write to " << mPath;
+		}
+		mBError = true;
+		return false;
+	}
+	mBytesSinceSync += abuffer.size();
+	mNumBytesWritten += abuffer.size();
+	return true;
+}
+
+//--------------------------------------------------------------
+void RecordingWriter::_sync() {
+	fflush( mFile );
+#if defined(TARGET_WIN32)
+	_commit( _fileno(mFile) );
+#else
+	fsync( fileno(mFile) );
+#endif
+	mBytesSinceSync = 0;
+	mNumSyncs++;
+}
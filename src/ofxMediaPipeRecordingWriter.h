@@ -0,0 +1,80 @@
+//
+//  ofxMediaPipeRecordingWriter.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofFileUtils.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace ofx::MediaPipe {
+// Appends serialized frames of the Recorder to a file on a background thread.
+// push() only moves a buffer into a bounded queue, so the thread adding frames never waits on the disk.
+// The file is flushed periodically and synced to disk every chunk, so a crash loses at most the last chunk.
+// The RecordingReader recovers the frames of a file that was not closed.
+class RecordingWriter {
+public:
+	struct Settings {
+		// buffers waiting to be written, new buffers are dropped when the queue is full
+		size_t maxQueuedBuffers = 512;
+		// wait for room in the queue instead of dropping, for offline writing like the RecordingConverter
+		bool bBlockWhenFull = false;
+		// the file is synced to disk when this many bytes were written since the last sync
+		size_t chunkBytes = 4 * 1024 * 1024;
+		// written data is flushed to the os at least this often
+		std::uint64_t flushIntervalMillis = 250;
+	};
+
+	RecordingWriter();
+	~RecordingWriter();
+
+	bool open( const of::filesystem::path& afile, const Settings& asettings );
+	// Writes the queued buffers and aTail at the end of the file, then aHeader at the start of the file
+	// when it is not empty, ie. to update a header written with the first buffer. Blocks until the file is closed.
+	bool close( const std::string& aTail, const std::string& aHeader );
+	bool isOpen() { return mBRunning.load(); }
+
+	// a cleared buffer that keeps the capacity of a previously written one
+	std::string getBuffer();
+	// returns false if the queue is full and the buffer was dropped, waits for room with bBlockWhenFull
+	bool push( std::string&& abuffer );
+
+	size_t getNumQueued();
+	std::uint64_t getNumDropped() { return mNumDropped.load(); }
+	std::uint64_t getNumBytesWritten() { return mNumBytesWritten.load(); }
+	std::uint64_t getNumSyncs() { return mNumSyncs.load(); }
+	bool hasError() { return mBError.load(); }
+
+protected:
+	void _threadedFunction();
+	bool _write( const std::string& abuffer );
+	void _sync();
+
+	Settings mSettings;
+	of::filesystem::path mPath;
+	FILE* mFile = nullptr;
+
+	std::thread mThread;
+	std::atomic<bool> mBRunning = false;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::condition_variable mSpaceCondition;
+	std::deque<std::string> mQueue;
+	// written buffers, reused by getBuffer
+	std::deque<std::string> mFreeBuffers;
+
+	size_t mBytesSinceSync = 0;
+	std::atomic<std::uint64_t> mNumDropped = 0;
+	std::atomic<std::uint64_t> mNumBytesWritten = 0;
+	std::atomic<std::uint64_t> mNumSyncs = 0;
+	std::atomic<bool> mBError = false;
+};
+}
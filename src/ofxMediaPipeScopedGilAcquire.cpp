@@ -0,0 +1,42 @@
+//
+//  ofxMediaPipeScopedGilAcquire.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeScopedGilAcquire.h"
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+ScopedGilAcquire::ScopedGilAcquire( Histogram* aWaitHist, Histogram* aHoldHist, Interpreter* aInterpreter ) {
+	mHoldHist = aHoldHist;
+	bool bIsolated = aInterpreter && aInterpreter->isIsolated();
+	mBRecord = !bIsolated && !PyGILState_Check();
+	auto startTime = std::chrono::steady_clock::now();
+	if( bIsolated ) {
+		mActivate.emplace( *aInterpreter );
+		// PyGILState_Check only knows about the main interpreter
+		mBRecord = mActivate->isActivated();
+	} else {
+		mAcquire.emplace();
+	}
+	mAcquiredTime = std::chrono::steady_clock::now();
+	if( mBRecord && aWaitHist ) {
+		aWaitHist->add( (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(mAcquiredTime - startTime).count() );
+	}
+}
+
+//--------------------------------------------------------------
+ScopedGilAcquire::~ScopedGilAcquire() {
+	mAcquire.reset();
+	mActivate.reset();
+	if( mBRecord && mHoldHist ) {
+		mHoldHist->add( (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - mAcquiredTime).count() );
+	}
+}
+
+#endif
@@ -0,0 +1,39 @@
+//
+//  ofxMediaPipeScopedGilAcquire.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofxMediaPipeHistogram.h"
+#include "ofxMediaPipeInterpreter.h"
+#include <pybind11/embed.h>
+#include <optional>
+
+namespace py = pybind11;
+
+namespace ofx::MediaPipe {
+// Same as py::gil_scoped_acquire, but records how long the thread waited for the GIL
+// and how long it held it, in microseconds.
+// Nothing is recorded when the calling thread already holds the GIL, the outer scope owns that time.
+// With an isolated interpreter, the GIL of that interpreter is acquired instead of the main one.
+class ScopedGilAcquire {
+public:
+	ScopedGilAcquire( Histogram* aWaitHist, Histogram* aHoldHist, Interpreter* aInterpreter=nullptr );
+	~ScopedGilAcquire();
+
+	ScopedGilAcquire( const ScopedGilAcquire& ) = delete;
+	ScopedGilAcquire& operator=( const ScopedGilAcquire& ) = delete;
+
+protected:
+	Histogram* mHoldHist = nullptr;
+	bool mBRecord = false;
+	std::chrono::steady_clock::time_point mAcquiredTime;
+	std::optional<py::gil_scoped_acquire> mAcquire;
+	std::optional<Interpreter::ScopedActivate> mActivate;
+};
+}
+#endif
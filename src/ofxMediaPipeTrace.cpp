@@ -0,0 +1,184 @@
+//
+//  ofxMediaPipeTrace.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeTrace.h"
+#include "ofUtils.h"
+#include "ofLog.h"
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+using namespace ofx::MediaPipe;
+
+std::atomic<bool> Trace::sBEnabled = false;
+std::unique_ptr<Trace::Event[]> Trace::sEvents;
+size_t Trace::sCapacity = 0;
+size_t Trace::sMask = 0;
+std::atomic<std::uint64_t> Trace::sWritePos = 0;
+
+//--------------------------------------------------------------
+std::string Trace::sGetStringForStage( Stage astage ) {
+	switch( astage ) {
+		case STAGE_CAPTURE:
+			return "capture";
+		case STAGE_ENQUEUE:
+			return "enqueue";
+		case STAGE_GIL_ACQUIRED:
+			return "gil acquired";
+		case STAGE_CONVERTED:
+			return "converted";
+		case STAGE_INFERENCE_DONE:
+			return "inference";
+		case STAGE_DECODE_DONE:
+			return "decode";
+		case STAGE_MATCH_DONE:
+			return "match";
+		case STAGE_SEND:
+			return "send";
+		default:
+			break;
+	}
+	return "unknown";
+}
+
+//--------------------------------------------------------------
+void Trace::sSetEnabled( bool ab ) {
+	if( ab && !sEvents ) {
+		// about 2 seconds of three trackers at 60 fps marking every stage
+		sSetCapacity( 4096 );
+	}
+	sBEnabled = ab;
+}
+
+//--------------------------------------------------------------
+void Trace::sSetCapacity( size_t aNumEvents ) {
+	if( sIsEnabled() ) {
+		ofLogWarning("ofx::MediaPipe::Trace") << "disable the trace before changing the capacity.";
+		return;
+	}
+	size_t capacity = 2;
+	while( capacity < aNumEvents ) {
+		capacity <<= 1;
+	}
+	sEvents = std::make_unique<Event[]>( capacity );
+	sCapacity = capacity;
+	sMask = capacity - 1;
+	sClear();
+}
+
+//--------------------------------------------------------------
+void Trace::sClear() {
+	for( size_t i = 0; i < sCapacity; i++ ) {
+		sEvents[i].sequence.store( 0, std::memory_order_relaxed );
+	}
+	sWritePos = 0;
+}
+
+//--------------------------------------------------------------
+void Trace::_sRecord( Stage astage, TrackedObject::TrackedObjectType atype, std::int64_t aTraceId, std::int64_t aTimeMicros ) {
+	if( !sEvents ) {
+		return;
+	}
+	if( aTimeMicros < 0 ) {
+		aTimeMicros = (std::int64_t)ofGetElapsedTimeMicros();
+	}
+	// every writer gets its own slot, a reader skips slots that are being written
+	std::uint64_t pos = sWritePos.fetch_add( 1, std::memory_order_relaxed );
+	auto& event = sEvents[pos & sMask];
+	event.sequence.store( pos * 2 + 1, std::memory_order_relaxed );
+	std::atomic_thread_fence( std::memory_order_release );
+	event.traceId.store( aTraceId, std::memory_order_relaxed );
+	event.timeMicros.store( aTimeMicros, std::memory_order_relaxed );
+	event.stage.store( (std::uint8_t)astage, std::memory_order_relaxed );
+	event.type.store( (std::uint8_t)atype, std::memory_order_relaxed );
+	event.sequence.store( pos * 2 + 2, std::memory_order_release );
+}
+
+//--------------------------------------------------------------
+bool Trace::sSave( const of::filesystem::path& apath ) {
+	struct Record {
+		std::int64_t traceId = 0;
+		std::int64_t timeMicros = 0;
+		std::uint8_t stage = 0;
+		std::uint8_t type = 0;
+	};
+
+	std::vector<Record> records;
+	records.reserve( sCapacity );
+	for( size_t i = 0; i < sCapacity; i++ ) {
+		auto& event = sEvents[i];
+		std::uint64_t sequence = event.sequence.load( std::memory_order_acquire );
+		if( sequence == 0 || (sequence & 1) ) {
+			continue;
+		}
+		Record record;
+		record.traceId = event.traceId.load( std::memory_order_relaxed );
+		record.timeMicros = event.timeMicros.load( std::memory_order_relaxed );
+		record.stage = event.stage.load( std::memory_order_relaxed );
+		record.type = event.type.load( std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_acquire );
+		// overwritten while it was being copied
+		if( event.sequence.load( std::memory_order_relaxed ) != sequence ) {
+			continue;
+		}
+		records.push_back( record );
+	}
+
+	// the events of a frame are next to each other, in the order of the stages
+	std::sort( records.begin(), records.end(), []( const Record& a, const Record& b ) {
+		if( a.type != b.type ) return a.type < b.type;
+		if( a.traceId != b.traceId ) return a.traceId < b.traceId;
+		if( a.stage != b.stage ) return a.stage < b.stage;
+		return a.timeMicros < b.timeMicros;
+	});
+
+	auto path = ofToDataPath( apath, true );
+	std::ofstream out( path, std::ios::out | std::ios::trunc );
+	if( !out.is_open() ) {
+		ofLogError("ofx::MediaPipe::Trace") << "unable to write " << path;
+		return false;
+	}
+
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ofxMediaPipe\"}}";
+	for( int type = TrackedObject::HAND; type <= TrackedObject::POSE; type++ ) {
+		out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << type << ",\"args\":{\"name\":\"" << TrackedObject::sGetTypeAsString((TrackedObject::TrackedObjectType)type) << "\"}}";
+	}
+
+	auto writeEvent = [&out]( const std::string& aname, const char* aphase, const Record& arecord, std::int64_t atimeMicros ) {
+		out << ",\n{\"name\":\"" << aname << "\",\"cat\":\"" << TrackedObject::sGetTypeAsString((TrackedObject::TrackedObjectType)arecord.type);
+		out << "\",\"ph\":\"" << aphase << "\",\"id\":\"" << arecord.traceId << "\",\"ts\":" << atimeMicros;
+		out << ",\"pid\":1,\"tid\":" << (int)arecord.type << "}";
+	};
+
+	size_t start = 0;
+	while( start < records.size() ) {
+		size_t end = start + 1;
+		while( end < records.size() && records[end].type == records[start].type && records[end].traceId == records[start].traceId ) {
+			end++;
+		}
+		// the stages of a frame can be recorded by different threads, the slices should not go back in time
+		std::int64_t startMicros = records[start].timeMicros;
+		std::int64_t endMicros = startMicros;
+		for( size_t i = start; i < end; i++ ) {
+			endMicros = std::max( endMicros, records[i].timeMicros );
+		}
+		writeEvent( "frame " + ofToString(records[start].traceId), "b", records[start], startMicros );
+		std::int64_t prevMicros = startMicros;
+		for( size_t i = start + 1; i < end; i++ ) {
+			std::int64_t micros = std::max( prevMicros, records[i].timeMicros );
+			std::string name = sGetStringForStage( (Stage)records[i].stage );
+			writeEvent( name, "b", records[i], prevMicros );
+			writeEvent( name, "e", records[i], micros );
+			prevMicros = micros;
+		}
+		writeEvent( "frame " + ofToString(records[start].traceId), "e", records[start], endMicros );
+		start = end;
+	}
+	out << "\n]}\n";
+	return out.good();
+}
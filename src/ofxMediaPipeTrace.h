@@ -0,0 +1,93 @@
+//
+//  ofxMediaPipeTrace.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+#include "ofxMediaPipeTrackedObject.h"
+#include "ofFileUtils.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ofx::MediaPipe {
+// Records when each frame passes the stages between capture and sending the results, per tracker type.
+// The capture timestamp passed to Tracker::process is the trace id of a frame, so the stages of a frame
+// can be followed from the tracker to the OscSender.
+// Events are written to a fixed size ring without locking and the oldest events are overwritten.
+// Off by default, a disabled trace costs an atomic load per stage.
+// sSave writes Chrome trace event json, open it with chrome://tracing or ui.perfetto.dev.
+class Trace {
+public:
+	enum Stage {
+		// the frame reached Tracker::process. The capture timestamp is only the trace id,
+		// it can be on another clock, ie. the camera or the frame index of the BatchProcessor
+		STAGE_CAPTURE=0,
+		// the frame was handed to media pipe, a queue or a worker process
+		STAGE_ENQUEUE,
+		STAGE_GIL_ACQUIRED,
+		// the mp.Image was created
+		STAGE_CONVERTED,
+		STAGE_INFERENCE_DONE,
+		// the results were copied out of the python objects
+		STAGE_DECODE_DONE,
+		// the results were matched to the tracked objects, ie. they are returned by getHands()
+		STAGE_MATCH_DONE,
+		STAGE_SEND,
+		NUM_STAGES
+	};
+
+	static std::string sGetStringForStage( Stage astage );
+
+	// allocates the ring on first use, see sSetCapacity
+	static void sSetEnabled( bool ab );
+	static bool sIsEnabled() { return sBEnabled.load(std::memory_order_relaxed); }
+
+	// number of events that are kept, rounded up to a power of two. Clears the ring,
+	// call it while the trace is disabled and no stage is being marked.
+	static void sSetCapacity( size_t aNumEvents );
+	static size_t sGetCapacity() { return sCapacity; }
+
+	// records the stage of the frame with aTraceId at ofGetElapsedTimeMicros()
+	static void sMark( Stage astage, TrackedObject::TrackedObjectType atype, std::int64_t aTraceId ) {
+		if( sIsEnabled() ) {
+			_sRecord( astage, atype, aTraceId, -1 );
+		}
+	}
+	// records the stage at aTimeMicros instead of now, aTimeMicros has to be on the ofGetElapsedTimeMicros() clock
+	static void sMark( Stage astage, TrackedObject::TrackedObjectType atype, std::int64_t aTraceId, std::int64_t aTimeMicros ) {
+		if( sIsEnabled() ) {
+			_sRecord( astage, atype, aTraceId, aTimeMicros );
+		}
+	}
+
+	// events recorded since the last clear, including the ones that were overwritten
+	static std::uint64_t sGetNumRecorded() { return sWritePos.load(); }
+	static void sClear();
+
+	// writes the events in the ring as Chrome trace event json. Every frame becomes an async slice per tracker type,
+	// with a nested slice for the time spent reaching each stage. Can be called while events are being recorded.
+	static bool sSave( const of::filesystem::path& apath );
+
+protected:
+	struct Event {
+		// even when the event is complete, odd while it is being written
+		std::atomic<std::uint64_t> sequence;
+		std::atomic<std::int64_t> traceId;
+		std::atomic<std::int64_t> timeMicros;
+		std::atomic<std::uint8_t> stage;
+		std::atomic<std::uint8_t> type;
+	};
+
+	static void _sRecord( Stage astage, TrackedObject::TrackedObjectType atype, std::int64_t aTraceId, std::int64_t aTimeMicros );
+
+	static std::atomic<bool> sBEnabled;
+	static std::unique_ptr<Event[]> sEvents;
+	static size_t sCapacity;
+	static size_t sMask;
+	static std::atomic<std::uint64_t> sWritePos;
+};
+}
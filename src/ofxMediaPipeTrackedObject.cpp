@@ -8,6 +8,14 @@
 #include "ofxMediaPipeTrackedObject.h"
 #include "ofGraphics.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define OFX_MEDIAPIPE_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OFX_MEDIAPIPE_NEON
+#include <arm_neon.h>
+#endif
+
 using namespace ofx::MediaPipe;
 
 using std::string;
@@ -17,6 +25,52 @@ using std::make_shared;
 using std::cout;
 using std::endl;
 
+//-------------------------------------------
+static void sLerpFloats( const float* aA, const float* aB, float apct, float* aOut, size_t aNum ) {
+	size_t i = 0;
+#if defined(OFX_MEDIAPIPE_SSE)
+	__m128 pct = _mm_set1_ps( apct );
+	for( ; i + 4 <= aNum; i += 4 ) {
+		__m128 a = _mm_loadu_ps( aA + i );
+		__m128 b = _mm_loadu_ps( aB + i );
+		_mm_storeu_ps( aOut + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), pct)) );
+	}
+#elif defined(OFX_MEDIAPIPE_NEON)
+	float32x4_t pct = vdupq_n_f32( apct );
+	for( ; i + 4 <= aNum; i += 4 ) {
+		float32x4_t a = vld1q_f32( aA + i );
+		float32x4_t b = vld1q_f32( aB + i );
+		// multiply and add separately, so the results match the scalar path
+		vst1q_f32( aOut + i, vaddq_f32(a, vmulq_f32(vsubq_f32(b, a), pct)) );
+	}
+#endif
+	for( ; i < aNum; i++ ) {
+		aOut[i] = aA[i] + (aB[i] - aA[i]) * apct;
+	}
+}
+
+//-------------------------------------------
+void TrackedObject::sLerpKeypoints( const std::vector<Keypoint>& aA, const std::vector<Keypoint>& aB, float apct, std::vector<Keypoint>& aOut ) {
+	if( aA.size() != aB.size() ) {
+		aOut = aA;
+		return;
+	}
+	aOut.resize( aA.size() );
+	if( aA.empty() ) {
+		return;
+	}
+	if constexpr( sizeof(Keypoint) == sizeof(float) * 9 ) {
+		// the keypoints are packed floats, pos, posN and posWorld
+		sLerpFloats( &aA[0].pos.x, &aB[0].pos.x, apct, &aOut[0].pos.x, aA.size() * 9 );
+	} else {
+		for( size_t i = 0; i < aA.size(); i++ ) {
+			aOut[i].pos = aA[i].pos + (aB[i].pos - aA[i].pos) * apct;
+			aOut[i].posN = aA[i].posN + (aB[i].posN - aA[i].posN) * apct;
+			aOut[i].posWorld = aA[i].posWorld + (aB[i].posWorld - aA[i].posWorld) * apct;
+		}
+	}
+}
+
 //-------------------------------------------
 void TrackedObject::updateKeypointsFromOtherWithSmoothing( std::shared_ptr<TrackedObject> aother, float pct ) {
 	if( keypoints.size() == 0 ){
@@ -34,6 +88,12 @@ void TrackedObject::updateKeypointsFromOtherWithSmoothing( std::shared_ptr<Track
 	updateFromKeypoints();
 }
 
+//-------------------------------------------
+void TrackedObject::updateKeypointsFromInterpolation( std::shared_ptr<TrackedObject> aA, std::shared_ptr<TrackedObject> aB, float apct ) {
+	sLerpKeypoints( aA->keypoints, aB->keypoints, ofClamp(apct, 0.f, 1.f), keypoints );
+	updateFromKeypoints();
+}
+
 //--------------------------------------------------------------
 void TrackedObject::updateDrawMeshes() {
 	if( keypoints.size() > 0 ) {
@@ -32,6 +32,8 @@ public:
 	
 	struct TrackingData {
 		std::int64_t mostRecentFrame = 0;
+		// capture timestamp of the frame the keypoints were detected in, set by the OscReceiver
+		std::int64_t timestampMicros = 0;
 		int numFramesNotFound = 0;
 		bool bFoundThisFrame = true;
 		float matchDistance = -1.f; // used for match algo
@@ -67,7 +69,13 @@ public:
 	virtual TrackedObjectType getType() = 0;
 	std::string getTypeAsString() { return sGetTypeAsString(getType()); }
 	
+	// aOut = aA + (aB - aA) * apct for every position of the keypoints, vectorized with SSE or NEON.
+	// aOut is set to aA when the number of keypoints differs.
+	static void sLerpKeypoints( const std::vector<Keypoint>& aA, const std::vector<Keypoint>& aB, float apct, std::vector<Keypoint>& aOut );
+	
 	virtual void updateKeypointsFromOtherWithSmoothing( std::shared_ptr<TrackedObject> aother, float pct );
+	// sets the keypoints between two recorded frames of the same object, apct in 0 - 1
+	virtual void updateKeypointsFromInterpolation( std::shared_ptr<TrackedObject> aA, std::shared_ptr<TrackedObject> aB, float apct );
 	virtual void updateFromKeypoints() { updateDrawMeshes(); }
 	
 	void updateDrawMeshes();
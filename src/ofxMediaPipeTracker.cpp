@@ -19,6 +19,36 @@ int Tracker::sNumPyInstances = 0;
 
 //static bool sBPyInterpreterInited = false;
 
+//--------------------------------------------------------------
+void Tracker::Stats::reset() {
+	gilWait.reset();
+	gilHold.reset();
+	preprocess.reset();
+	conversion.reset();
+	inference.reset();
+	decode.reset();
+	matching.reset();
+	latency.reset();
+	numFramesProcessed = 0;
+	numFramesDropped = 0;
+}
+
+//--------------------------------------------------------------
+ofJson Tracker::Stats::jsonify() {
+	ofJson jstats;
+	jstats["gilWait"] = gilWait.jsonify();
+	jstats["gilHold"] = gilHold.jsonify();
+	jstats["preprocess"] = preprocess.jsonify();
+	jstats["conversion"] = conversion.jsonify();
+	jstats["inference"] = inference.jsonify();
+	jstats["decode"] = decode.jsonify();
+	jstats["matching"] = matching.jsonify();
+	jstats["latency"] = latency.jsonify();
+	jstats["numFramesProcessed"] = numFramesProcessed.load();
+	jstats["numFramesDropped"] = numFramesDropped.load();
+	return jstats;
+}
+
 //--------------------------------------------------------------
 bool Tracker::PyShutdown() {
 	if (Py_IsInitialized()) {
@@ -48,6 +78,13 @@ void Tracker::release() {
 		_stopVideoPixThread();
 	}
 	
+	bool bWasWorker = (bool)mWorker;
+	if( mWorker ) {
+		// joins the reader thread, so no more results arrive
+		mWorker->stop();
+		mWorker.reset();
+	}
+	
 	{
 		ofLogNotice(getTrackerTypeAsString()) << " release method - pre lock";
 		std::lock_guard<std::mutex> lck(mMutexMediaPipe);
@@ -97,8 +134,8 @@ void Tracker::release() {
 //	}
 	
 	
-	if (mBSetup) {
-		py::gil_scoped_acquire acquire;
+	if (mBSetup && Py_IsInitialized()) {
+		ScopedGilAcquire acquire( nullptr, nullptr, &mInterpreter );
 		if(!py_landmarker.is_none() ) {
 			ofLogNotice(getTrackerTypeAsString()) << ("py_landmarker release");
 			try {
@@ -118,13 +155,23 @@ void Tracker::release() {
 				ofLogNotice(getTrackerTypeAsString()) << ("py_landmarker close ERROR");
 			}
 		}
+		py_Image = py::object();
+		py_ImageFormat = py::object();
+		mLandmarkPacker.release();
+		if( mInterpreter.isIsolated() ) {
+			// objects can not outlive the interpreter that created them
+			py_landmarker = py::object();
+			py_mediapipe = py::module_();
+		}
 		py::gil_scoped_release release;
 		
 	}
+	// ends the sub interpreter of an isolated tracker
+	mInterpreter.release();
 	
 	
 	
-	if( mBSetup ) {
+	if( mBSetup && !bWasWorker ) {
 		mBSetup = false;
 		sNumPyInstances--;
 		
@@ -164,6 +211,34 @@ void Tracker::update(ofEventArgs& args) {
 	_update();
 }
 
+//----------------------------------------------------------------------
+ofJson Tracker::jsonifyStats() {
+	ofJson jstats = mStats.jsonify();
+	jstats["type"] = getTrackerTypeAsString();
+	jstats["runningMode"] = sGetStringForRunningMode(getRunningMode());
+	jstats["fps"] = getFps();
+	jstats["backend"] = isUsingWorker() ? "WORKER_PROCESS" : "EMBEDDED";
+	jstats["interpreter"] = Interpreter::sGetStringForMode(mInterpreter.getMode());
+	if( mWorker ) {
+		jstats["workerNumSlots"] = mWorker->getNumSlots();
+		jstats["workerNumInFlight"] = mWorker->getNumInFlight();
+	} else if( getRunningMode() == MODE_OF_VIDEO_THREAD ) {
+		ofJson jqueue;
+		jqueue["capacity"] = mFrameQueue.getCapacity();
+		jqueue["policy"] = FrameQueue::sGetStringForPolicy(mFrameQueue.getPolicy());
+		jqueue["numEnqueued"] = mFrameQueue.getNumEnqueued();
+		jqueue["numDropped"] = mFrameQueue.getNumDropped();
+		jqueue["averageLatencyMicros"] = mFrameQueue.getAverageLatencyMicros();
+		jqueue["maxLatencyMicros"] = mFrameQueue.getMaxLatencyMicros();
+		jstats["queue"] = jqueue;
+	} else if( getRunningMode() == MODE_LIVE_STREAM ) {
+		jstats["numInFlight"] = getNumInFlight();
+		jstats["numLiveFramesSkipped"] = getNumLiveFramesSkipped();
+		jstats["numLiveResultsDropped"] = getNumLiveResultsDropped();
+	}
+	return jstats;
+}
+
 //----------------------------------------------------------------------
 void Tracker::_calculateDeltatime(){
 	float tnow = ofGetElapsedTimef();
@@ -177,35 +252,120 @@ void Tracker::_calculateDeltatime(){
 	mLastTimeUpdateF = tnow; 
 }
 
+//----------------------------------------------------------------------
+int Tracker::_getNumFramesToDie( std::int64_t aTimestampMicros ) {
+	if( mLastMatchTimestampMicros >= 0 && aTimestampMicros > mLastMatchTimestampMicros ) {
+		float frameRate = 1000000.f / (float)(aTimestampMicros - mLastMatchTimestampMicros);
+		mMatchFrameRate = ofLerp( mMatchFrameRate, ofClamp(frameRate, 1, 200), 0.1f );
+	} else if( aTimestampMicros < mLastMatchTimestampMicros ) {
+		// a new source, start over so that runs over the same frames match the same way
+		mMatchFrameRate = 30.f;
+	}
+	mLastMatchTimestampMicros = aTimestampMicros;
+	return mMaxTimeToMatch * mMatchFrameRate;
+}
+
 //----------------------------------------------------------------------
 void Tracker::process(const ofPixels& apix) {
-//	if( getRunningMode() == Tracker::MODE_OF_VIDEO_THREAD ) {
-		py::gil_scoped_release release; // add this to release the GIL
-//	}
+	process( apix, (std::int64_t)ofGetElapsedTimeMicros() );
+}
+
+//----------------------------------------------------------------------
+void Tracker::process(const ofPixels& apix, std::int64_t aTimestampMicros) {
+	_trace( Trace::STAGE_CAPTURE, aTimestampMicros );
+	if( mWorker ) {
+		// the worker has its own interpreter, the GIL of this process is not needed
+		if( !_prepareToProcess(apix) ) {
+			return;
+		}
+		const ofPixels& ipix = _getInferencePixels( apix );
+		if( !ipix.isAllocated() ) {
+			return;
+		}
+		// fails when all of the worker slots are waiting on results
+		if( mWorker->push(ipix, aTimestampMicros) ) {
+			_trace( Trace::STAGE_ENQUEUE, aTimestampMicros );
+			mNumBytesCopied += ipix.getTotalBytes();
+		} else {
+			mStats.numFramesDropped++;
+		}
+		return;
+	}
+	
+	// only the thread holding the GIL can release it, ie. the main thread after setup,
+	// calling process from another thread or from the FrameHub is fine
+	std::optional<py::gil_scoped_release> release;
+	if( Py_IsInitialized() && PyGILState_Check() ) {
+		release.emplace();
+	}
+	
+	if( !_prepareToProcess(apix) ) {
+		return;
+	}
+	
+	const ofPixels& ipix = _getInferencePixels( apix );
+	if( !ipix.isAllocated() ) {
+		return;
+	}
+	_process_image( ipix, py::object(), aTimestampMicros );
+}
+
+//----------------------------------------------------------------------
+void Tracker::processShared(const ofPixels& apix, const py::object& aMpImage, std::int64_t aTimestampMicros) {
+	// called from the FrameHub with the GIL already held
+	_trace( Trace::STAGE_CAPTURE, aTimestampMicros );
+	if( !_prepareToProcess(apix) ) {
+		return;
+	}
 	
+	_process_image( apix, aMpImage, aTimestampMicros );
+}
+
+//----------------------------------------------------------------------
+bool Tracker::_prepareToProcess(const ofPixels& apix) {
 	if(!mBSetup) {
 		ofLogWarning(getTrackerTypeAsString()) << " process: has not been setup properly.";
-		return;
+		return false;
 	}
 	int pw = apix.getWidth();
 	int ph = apix.getHeight();
 	
 	if( !apix.isAllocated() || pw < 10 || ph < 10 ) {
 		ofLogWarning(getTrackerTypeAsString()) << " pixels are not allocated.";
-		return;
+		return false;
 	}
 	
 	mSrcRect.width = pw;
 	mSrcRect.height = ph;
 	
+	mNumBytesCopiedLastFrame = mNumBytesCopied.exchange(0);
+	
 	if( mOutRect.width < 1 ) {
 		mOutRect.width = pw;
 	}
 	if( mOutRect.height < 1 ) {
 		mOutRect.height = ph;
 	}
-	
-	_process_image( apix );
+	return true;
+}
+
+//----------------------------------------------------------------------
+const ofPixels& Tracker::_getInferencePixels(const ofPixels& apix) {
+	bool bConvert = !PixelConverter::sIsPassThrough( apix.getPixelFormat() );
+	if( !bConvert && !mImagePrep.isEnabled() ) {
+		return apix;
+	}
+	Histogram::ScopedTimer preprocessTimer( mStats.preprocess );
+	if( bConvert ) {
+		const ofPixels& cpix = mPixelConverter.process( apix );
+		if( !cpix.isAllocated() ) {
+			ofLogWarning(getTrackerTypeAsString()) << " unable to convert pixels from " << PixelConverter::sGetStringForFormat(apix.getPixelFormat()) << " " << apix.getWidth() << "x" << apix.getHeight();
+			return cpix;
+		}
+		// mSrcRect keeps the size of the source, the keypoints are mapped back to it
+		return mImagePrep.process( cpix );
+	}
+	return mImagePrep.process( apix );
 }
 
 //-------------------------------------------------------------
@@ -220,18 +380,34 @@ void Tracker::_onExit( ofEventArgs& args ) {
 
 //-------------------------------------------------------------
 void Tracker::_process_image(const ofPixels& apix) {
-	int pw = apix.getWidth();
-	int ph = apix.getHeight();
-	
-	auto timestamp = (int)ofGetElapsedTimeMillis();
+	_process_image( apix, py::object(), (std::int64_t)ofGetElapsedTimeMicros() );
+}
+
+//-------------------------------------------------------------
+std::int64_t Tracker::_getMediaPipeTimestamp( std::int64_t aTimestampMicros ) {
+	// media pipe works in milliseconds and requires timestamps that increase with every call
+	std::int64_t timestamp = aTimestampMicros / 1000;
+	if( timestamp <= mLastSubmittedTimestamp ) {
+		timestamp = mLastSubmittedTimestamp + 1;
+	}
+	mLastSubmittedTimestamp = timestamp;
+	return timestamp;
+}
+
+//-------------------------------------------------------------
+void Tracker::_process_image(const ofPixels& apix, const py::object& aMpImage, std::int64_t aTimestampMicros) {
+	// aMpImage is optional, when it is not valid the image is created from apix
+	std::int64_t timestamp = 0;
+	auto startMicros = ofGetElapsedTimeMicros();
 
 	if (mBExiting.load()) {
 		return;
 	}
 
 	
-	if( apix.getNumChannels() != 3 ) {
-		ofLogWarning("Tracker::_process_image") << "pixels must have 3 channels, not " << apix.getNumChannels();
+	// other formats are converted by _getInferencePixels
+	if( apix.getNumChannels() != 3 && apix.getNumChannels() != 4 ) {
+		ofLogWarning("Tracker::_process_image") << "pixels must have 3 or 4 channels, not " << apix.getNumChannels();
 		return;
 	}
 	
@@ -247,27 +423,43 @@ void Tracker::_process_image(const ofPixels& apix) {
 		
 		//		ofLogNotice("Tracker::_process_image") << "timestamp: " << timestamp << " | " << ofGetFrameNum();
 		// if (mBMediaPipeThreadFinished.load()) {
-		if (mThreadCallCount.load() < 1) {
+		// up to mMaxInFlight frames are passed to media pipe before their results come back,
+		// so that the stages of the graph can run at the same time.
+		bool bSubmit = false;
+		{
+			std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+			if( (int)mInFlightTimestamps.size() < std::max(1, mMaxInFlight) ) {
+				timestamp = _getMediaPipeTimestamp( aTimestampMicros );
+				auto& inFlight = mInFlightTimestamps[timestamp];
+				inFlight.submitMicros = startMicros;
+				inFlight.timestampMicros = aTimestampMicros;
+				mBMediaPipeThreadFinished = false;
+				mThreadCallCount = (unsigned int)mInFlightTimestamps.size();
+				bSubmit = true;
+			}
+		}
+		if( bSubmit ) {
+			_trace( Trace::STAGE_ENQUEUE, aTimestampMicros );
+			bool bSubmitted = false;
 			try {
 				
-				{
-					std::lock_guard<std::mutex> lck(mMutexMediaPipe);
-					mBMediaPipeThreadFinished = false;
-					mThreadCallCount = mThreadCallCount + 1;
-				}
 				//			ofLogNotice("ofxMediaPipeTracker :: _process_image") << getTrackerTypeAsString() << " num threads: " << mThreadCallCount;
 				// Acquire GIL before interacting with Python objects 
 				//py::gil_scoped_acquire acquire;
 				try {
 					// Acquire GIL before interacting with Python objects 
-					py::gil_scoped_acquire acquire;
-					py::object mp_image = _getMpImageFromPixels(apix);
+					ScopedGilAcquire acquire( &mStats.gilWait, &mStats.gilHold, &mInterpreter );
+					_trace( Trace::STAGE_GIL_ACQUIRED, aTimestampMicros );
+					py::object mp_image = aMpImage ? aMpImage : _getMpImageFromPixels(apix);
+					_trace( Trace::STAGE_CONVERTED, aTimestampMicros );
 					//py_landmarker.attr("detect_async")(mp_image, timestamp);
 					try {
 						//py_landmarker.attr("detect_async")(mp_image, timestamp);
 						py::function detect_async_fn = py_landmarker.attr("detect_async");
 						if (!detect_async_fn.is_none()) {
+							Histogram::ScopedTimer inferenceTimer( mStats.inference );
 							detect_async_fn(mp_image, timestamp);
+							bSubmitted = true;
 						}
 					} catch (py::error_already_set& e) {
 						std::cerr << "Python error: " << e.what() << std::endl;
@@ -283,19 +475,36 @@ void Tracker::_process_image(const ofPixels& apix) {
 			} catch (...) {
 				// Handle Python exception
 				std::cerr << "Python exception in process_image:\n" << std::endl;// << e.what() << std::endl;
-				return;// {}; // Return empty vector on error
 			}
+			if( !bSubmitted ) {
+				// no callback will arrive for this timestamp
+				std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+				mInFlightTimestamps.erase(timestamp);
+				mThreadCallCount = (unsigned int)mInFlightTimestamps.size();
+				mBMediaPipeThreadFinished = mInFlightTimestamps.empty();
+			}
+		} else {
+			mNumLiveFramesSkipped++;
+			mStats.numFramesDropped++;
 		}
 		//		py_landmarker.attr("detect_async")(mp_image, timestamp);
 		// landmarks gets set in the _update function per class, since it's thread specific 
 	} else if( getRunningMode() == Tracker::MODE_VIDEO ) {
-		py::gil_scoped_acquire acquire;
+		{
+			std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+			timestamp = _getMediaPipeTimestamp( aTimestampMicros );
+		}
+		_trace( Trace::STAGE_ENQUEUE, aTimestampMicros );
+		ScopedGilAcquire acquire( &mStats.gilWait, &mStats.gilHold, &mInterpreter );
+		_trace( Trace::STAGE_GIL_ACQUIRED, aTimestampMicros );
 		py::object results;// = py_landmarker.attr("detect")(mp_image);
-		py::object mp_image = _getMpImageFromPixels(apix);
+		py::object mp_image = aMpImage ? aMpImage : _getMpImageFromPixels(apix);
+		_trace( Trace::STAGE_CONVERTED, aTimestampMicros );
 		try {
 			if (!mp_image.is_none()) {
 				py::function detect_fn = py_landmarker.attr("detect_for_video");
 				if( !detect_fn.is_none() ) {
+					Histogram::ScopedTimer inferenceTimer( mStats.inference );
 					results = detect_fn(mp_image, timestamp);
 				}
 				//				results = py_landmarker.attr("detect_for_video")(mp_image, timestamp);
@@ -307,32 +516,33 @@ void Tracker::_process_image(const ofPixels& apix) {
 		} catch(...) {
 			
 		}
+		_trace( Trace::STAGE_INFERENCE_DONE, aTimestampMicros );
 		// setup the landmarks
-		_process_landmark_results(results, timestamp);
+		_process_results(results, aTimestampMicros);
 		mBHasNewData = true;
 		mFpsCounter.newFrame();
+		mStats.latency.add( ofGetElapsedTimeMicros() - startMicros );
 	} else if( getRunningMode() == Tracker::MODE_OF_VIDEO_THREAD ) {
 		
 //		ofLogNotice( "Sending pixels" ) << " | " << ofGetFrameNum();
-		if( !mBNewVideoPixels.load() ) {
-//			py::gil_scoped_release release; // add this to release the GIL
-//			std::lock_guard<std::mutex> lock(mVideoPixMutex);
-			
-			if( mThreadVideoPixels[mVideoPixIndex].getWidth() != apix.getWidth() ) {
-				ofLogNotice("Tracker") << getTrackerTypeAsString() << " allocating pixels | " << ofGetFrameNum();
-			}
-			
-//			auto cmillis =
-			mThreadVideoPixels[mVideoPixIndex] = apix;
-			std::lock_guard<std::mutex> lock(mVideoPixMutex);
-			mBNewVideoPixels = true;
+		// the caller owns apix, so it is copied into a preallocated queue slot.
+		// Full queues are handled by the queue policy, see Settings::queuePolicy.
+		auto numDropped = mFrameQueue.getNumDropped();
+		if( mFrameQueue.push(apix, aTimestampMicros) ) {
+			_trace( Trace::STAGE_ENQUEUE, aTimestampMicros );
+			mNumBytesCopied += apix.getTotalBytes();
 		}
+		mStats.numFramesDropped += mFrameQueue.getNumDropped() - numDropped;
 	} else {
-		py::gil_scoped_acquire acquire;
+		_trace( Trace::STAGE_ENQUEUE, aTimestampMicros );
+		ScopedGilAcquire acquire( &mStats.gilWait, &mStats.gilHold, &mInterpreter );
+		_trace( Trace::STAGE_GIL_ACQUIRED, aTimestampMicros );
 		py::object results;// = py_landmarker.attr("detect")(mp_image);
-		py::object mp_image = _getMpImageFromPixels(apix);
+		py::object mp_image = aMpImage ? aMpImage : _getMpImageFromPixels(apix);
+		_trace( Trace::STAGE_CONVERTED, aTimestampMicros );
 		try {
 			if (!mp_image.is_none()) {
+				Histogram::ScopedTimer inferenceTimer( mStats.inference );
 				results = py_landmarker.attr("detect")(mp_image);
 			}
 		} catch (const py::error_already_set& e) {
@@ -340,48 +550,80 @@ void Tracker::_process_image(const ofPixels& apix) {
 			std::cerr << "Python exception in process_image:\n" << e.what() << std::endl;
 			return;// {}; // Return empty vector on error
 		}
+		_trace( Trace::STAGE_INFERENCE_DONE, aTimestampMicros );
 		
 		// setup the landmarks
-		_process_landmark_results(results, timestamp);
+		_process_results(results, aTimestampMicros);
 		mBHasNewData = true;
 		mFpsCounter.newFrame();
+		mStats.latency.add( ofGetElapsedTimeMicros() - startMicros );
 	}
 }
 
 //-------------------------------------------
-void Tracker::_process_results_callback(py::object& aresults, py::object& aMpImage, int aTimestamp ) {
+void Tracker::_process_results_callback(py::object& aresults, py::object& aMpImage, std::int64_t aTimestamp ) {
 	
 	if(mBExiting.load()) {
 		std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+		mInFlightTimestamps.clear();
 		mBMediaPipeThreadFinished = true;
-		mThreadCallCount--;
+		mThreadCallCount = 0;
 		ofLogNotice("Tracker::_process_results_callback ! EXITING, returning") << " | " << ofGetFrameNum();
 		return;
 	}
 	
 	if( !mBSetup ) {
 		std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+		mInFlightTimestamps.clear();
 		mBMediaPipeThreadFinished = true;
 		mThreadCallCount = 0;
 		ofLogNotice("Tracker::_process_results_callback ! setup, returning") << " | " << ofGetFrameNum();
 		return;
 	}
-//	ofLogNotice("Tracker::_process_landmark_results") << "timestamp: " << aTimestamp << " | " << ofGetFrameNum();
+	
+	std::uint64_t submitMicros = 0;
+	std::int64_t timestampMicros = aTimestamp * 1000;
 	{
-		py::gil_scoped_acquire acquire;
-		_process_landmark_results(aresults, aTimestamp);
+		std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+		auto it = mInFlightTimestamps.find(aTimestamp);
+		if( it != mInFlightTimestamps.end() ) {
+			submitMicros = it->second.submitMicros;
+			timestampMicros = it->second.timestampMicros;
+		}
+		// media pipe does not call back for frames that it skips, so older timestamps are no longer in flight
+		mInFlightTimestamps.erase( mInFlightTimestamps.begin(), mInFlightTimestamps.upper_bound(aTimestamp) );
+		mThreadCallCount = (unsigned int)mInFlightTimestamps.size();
+		mBMediaPipeThreadFinished = mInFlightTimestamps.empty();
+		
+		if( aTimestamp <= mLastResultTimestamp ) {
+			// a newer result has already been applied
+			mNumLiveResultsDropped++;
+			mStats.numFramesDropped++;
+			return;
+		}
+		mLastResultTimestamp = aTimestamp;
 	}
 	
-	
-	std::lock_guard<std::mutex> lck(mMutexMediaPipe);
-	mBMediaPipeThreadFinished = true;
-	mThreadCallCount--;
-	if( mThreadCallCount < 0 ) {
-		mThreadCallCount = 0;
+//	ofLogNotice("Tracker::_process_landmark_results") << "timestamp: " << aTimestamp << " | " << ofGetFrameNum();
+	_trace( Trace::STAGE_INFERENCE_DONE, timestampMicros );
+	{
+		ScopedGilAcquire acquire( &mStats.gilWait, &mStats.gilHold, &mInterpreter );
+		_process_results(aresults, timestampMicros);
+	}
+	if( submitMicros > 0 ) {
+		mStats.latency.add( ofGetElapsedTimeMicros() - submitMicros );
 	}
 //	ofLogNotice("Tracker::_process_results_callback") << "timestamp: " << aTimestamp << " finished: " << mBMediaPipeThreadFinished << " | " << ofGetFrameNum();
 }
 
+//--------------------------------------------------------------
+void Tracker::_process_results( py::object& aresults, std::int64_t aTimestampMicros ) {
+	// the GIL is held while the results are decoded
+	Histogram::ScopedTimer decodeTimer( mStats.decode );
+	_process_landmark_results( aresults, aTimestampMicros );
+	mStats.numFramesProcessed++;
+}
+
 //--------------------------------------------------------------
 void Tracker::_initParams() {
 	mBDrawUsePosZ.set("DrawUsePosZ", false);
@@ -420,72 +662,168 @@ void Tracker::_removeAppListeners() {
 
 //------------------------------------------------------------------------
 py::object Tracker::_getMpImageFromPixels(const ofPixels &apix) {
+	// the numpy array is a view on the pixel data, it does not own the memory.
+	// mp.Image copies the data into its own ImageFrame while it is being constructed,
+	// so apix only has to stay valid for the duration of this call.
+	py::capsule noOwner( apix.getData(), [](void*) {} );
+	return _createMpImage( apix, noOwner );
+}
+
+//------------------------------------------------------------------------
+py::object Tracker::_createMpImage( const ofPixels& apix, py::handle aBase ) {
+	Histogram::ScopedTimer conversionTimer( mStats.conversion );
 	std::string imgFmtStr = "SRGB";
 	if( apix.getNumChannels() == 1 ) {
 		imgFmtStr = "GRAY8";
+	} else if( apix.getNumChannels() == 4 ) {
+		imgFmtStr = "SRGBA";
 	}
 	
-	int pw = apix.getWidth();
-	int ph = apix.getHeight();
-	
-	int numChannels = apix.getNumChannels();
+	py::ssize_t pw = apix.getWidth();
+	py::ssize_t ph = apix.getHeight();
+	py::ssize_t numChannels = apix.getNumChannels();
 	
 	py::object mp_image;
-	bool bImageSet = false;
 	
 	try {
-		// Acquire GIL before interacting with Python objects
-//		py::gil_scoped_acquire acquire;
-//		PyGILState_STATE gstate;
-//		gstate = PyGILState_Ensure();  // Acquire GIL
-		
-		// Call Python API or functions here
-		
-		
-//		if(try_acquire_gil_with_timeout(1000)) {
-			// Create a NumPy array from the buffer
-			py::array_t<uint8_t> image_array({ ph, pw, numChannels }, apix.getData());
-			//	mp_image = mp.Image(image_format=mp.ImageFormat.SRGB, data=cvimage)
-			
-//			py::module py_mediapipe = py::module::import("mediapipe");
 		if( !py_mediapipe ) {
 			ofLogNotice("Trying to grab media pipe");
 			py_mediapipe = py::module::import("mediapipe");
 		}
-			py::object ImageFormat = py_mediapipe.attr("ImageFormat");
-			py::object Image = py_mediapipe.attr("Image");
-			
-			
-			// this should make a copy of the data
-			mp_image = Image.attr("__call__")(
-											  py::arg("image_format") = ImageFormat.attr(imgFmtStr.c_str()),
-											  py::arg("data") = image_array
-											  );
-//			PyGILState_Release(gstate);  // Release GIL
-			
-			
-			// Release GIL while performing intensive C++ operations
-			//py::gil_scoped_release release;
-			bImageSet = true;
-//		}
-	} catch (const std::exception& e) {
+		if( !py_Image || !py_ImageFormat ) {
+			py_ImageFormat = py_mediapipe.attr("ImageFormat");
+			py_Image = py_mediapipe.attr("Image");
+		}
 		
+		// passing a base object tells pybind not to copy the data into the array
+		py::array_t<uint8_t> image_array(
+										 { ph, pw, numChannels },
+										 { pw * numChannels, numChannels, (py::ssize_t)1 },
+										 apix.getData(),
+										 aBase
+										 );
+		
+		// mp.Image makes the only copy of the pixel data
+		mp_image = py_Image(
+							py::arg("image_format") = py_ImageFormat.attr(imgFmtStr.c_str()),
+							py::arg("data") = image_array
+							);
+		mNumBytesCopied += apix.getTotalBytes();
+	} catch (const std::exception& e) {
+		ofLogError(getTrackerTypeAsString()) << "unable to create mp image: " << e.what();
 	} catch (...) {
 		
 	}
 	return mp_image;
 }
 
+//------------------------------------------------------------------------
+void Tracker::_applyBaseSettings( const Settings& asettings ) {
+	if( mVideoThreadRunning.load() ) {
+		_stopVideoPixThread();
+	}
+	mFrameQueue.setup( std::max(1, asettings.queueDepth), asettings.queuePolicy );
+	mImagePrep.setup( asettings.inferenceWidth, asettings.inferenceHeight, asettings.inferenceRoi );
+	
+	std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+	mMaxInFlight = std::max(1, asettings.maxInFlight);
+	mInFlightTimestamps.clear();
+	mThreadCallCount = 0;
+	mLastSubmittedTimestamp = -1;
+	mLastResultTimestamp = -1;
+}
+
+//------------------------------------------------------------------------
+void Tracker::_setupInterpreter( const Settings& asettings ) {
+	auto mode = asettings.interpreterMode;
+	if( mode == Interpreter::MODE_ISOLATED && asettings.runningMode == MODE_LIVE_STREAM ) {
+		// media pipe calls the result callback from its own thread through the main interpreter
+		ofLogWarning(getTrackerTypeAsString()) << "isolated interpreters do not support MODE_LIVE_STREAM, using the shared interpreter.";
+		mode = Interpreter::MODE_SHARED;
+	}
+	mInterpreter.setup( mode );
+	if( mInterpreter.getMode() != asettings.interpreterMode ) {
+		ofLogNotice(getTrackerTypeAsString()) << "requested the " << Interpreter::sGetStringForMode(asettings.interpreterMode) << " interpreter, using " << Interpreter::sGetStringForMode(mInterpreter.getMode());
+	}
+}
+
+//------------------------------------------------------------------------
+bool Tracker::_setupWorker( const Settings& asettings, ofJson aConfig ) {
+	auto scriptPath = asettings.workerScriptPath;
+	if( scriptPath.empty() ) {
+		scriptPath = ofToDataPath("ofxMediaPipeWorker.py", true);
+		if( !ofFile::doesFileExist(scriptPath) ) {
+			// trying to load from addon folder
+			scriptPath = ofToDataPath("../../../../../addons/ofxMediaPipePython/scripts/ofxMediaPipeWorker.py", true);
+		}
+	}
+	
+	aConfig["type"] = ofToLower(getTrackerTypeAsString());
+	aConfig["modelPath"] = asettings.filePath.string();
+	aConfig["maxNum"] = asettings.maxNum;
+	aConfig["minDetectionConfidence"] = asettings.minDetectionConfidence;
+	aConfig["minPresenceConfidence"] = asettings.minPresenceConfidence;
+	aConfig["minTrackingConfidence"] = asettings.minTrackingConfidence;
+	
+	WorkerProcess::Settings wsettings;
+	wsettings.pythonExecutable = asettings.pythonExecutable;
+	wsettings.scriptPath = scriptPath;
+	wsettings.config = aConfig;
+	wsettings.numSlots = std::max(2, asettings.queueDepth);
+	
+	mWorker = std::make_unique<WorkerProcess>();
+	if( !mWorker->start(wsettings, [this](WorkerProcess::Results& aresults) { _process_worker_results(aresults); }) ) {
+		ofLogError(getTrackerTypeAsString()) << "unable to start the worker process.";
+		mWorker.reset();
+		return false;
+	}
+	
+	mBExiting = false;
+	_addAppListeners();
+	mBSetup = true;
+	return true;
+}
+
+//------------------------------------------------------------------------
+void Tracker::_process_worker_results( WorkerProcess::Results& aresults ) {
+	// called from the reader thread of the worker
+	if( mBExiting.load() ) {
+		return;
+	}
+	_trace( Trace::STAGE_INFERENCE_DONE, aresults.timestampMicros );
+	// swapped so that the worker and the tracker both keep their allocations
+	std::swap( mPackedLandmarks, aresults.landmarks );
+	std::swap( mPackedWorldLandmarks, aresults.worldLandmarks );
+	std::swap( mPackedCategories, aresults.categories );
+	{
+		Histogram::ScopedTimer decodeTimer( mStats.decode );
+		_apply_packed_results( aresults.timestampMicros );
+	}
+	mStats.numFramesProcessed++;
+	if( aresults.pushMicros > 0 ) {
+		mStats.latency.add( ofGetElapsedTimeMicros() - aresults.pushMicros );
+	}
+}
+
+//------------------------------------------------------------------------
+void Tracker::_apply_packed_results( std::int64_t aTimestampMicros ) {
+	// media pipe returns coordinates normalized to the pixels it was given
+	mImagePrep.mapToSource( mPackedLandmarks.xyz.data(), mPackedLandmarks.getTotalNum() );
+	_trace( Trace::STAGE_DECODE_DONE, aTimestampMicros );
+	_process_packed_results( aTimestampMicros );
+}
+
 //------------------------------------------------------------------------
 void Tracker::_startVideoPixThread() {
 	if( !mVideoThreadRunning.load() ) {
 		std::lock_guard<std::mutex> lock(mVideoPixMutex);
-		mVideoPixIndex = 0;
+		if( mVideoThread.joinable() ) {
+			// a thread that was not joined has to be joined before it is replaced
+			mVideoThread.join();
+		}
+		mFrameQueue.open();
 		mVideoThreadRunning = true;
-		mBNewVideoPixels = false;
-		mBVideoThreadDone = false;
 		mVideoThread = std::thread(&Tracker::_videoPixThreadedFunction, this );  // 'this' is passed to bind the object
-		mVideoThread.detach();
 	}
 }
 
@@ -493,17 +831,16 @@ void Tracker::_startVideoPixThread() {
 void Tracker::_stopVideoPixThread() {
 	ofLogNotice("Stopping video pix thread.");
 	mVideoThreadRunning = false;
+	// wake up the thread if it is waiting for a frame
+	mFrameQueue.close();
 	if( mVideoThread.joinable() ) {
 		ofLogNotice("joining thread.");
-		mVideoThread.join();
-	} else {
-		ofLogNotice("going to wait for thread.");
-		// Wait for "joinWaitMillis" milliseconds for thread to finish
-		std::unique_lock<std::mutex> lck(mVideoPixMutex);
-		auto millis = 5000;
-		if(!mBVideoThreadDone && mVideoThreadCondition.wait_for(lck,std::chrono::milliseconds(millis))==std::cv_status::timeout){
-			// unable to completely wait for thread
-			ofLogNotice("unable to completely wait for thread.");
+		if( Py_IsInitialized() && PyGILState_Check() ) {
+			// the thread needs the GIL to finish processing its current frame
+			py::gil_scoped_release release;
+			mVideoThread.join();
+		} else {
+			mVideoThread.join();
 		}
 	}
 }
@@ -512,56 +849,51 @@ void Tracker::_stopVideoPixThread() {
 void Tracker::_videoPixThreadedFunction() {
 	while( mVideoThreadRunning.load() ) {
 //		ofLogNotice("Video threaded function");
-		if( mBNewVideoPixels.load() ) {
-			py::gil_scoped_acquire acquire;
-			py::object mp_image = _getMpImageFromPixels(mThreadVideoPixels[mVideoPixIndex.load()]);
+		// sleeps until a frame is pushed or the queue is closed
+		std::uint64_t pushMicros = 0;
+		std::int64_t timestampMicros = 0;
+		if( mFrameQueue.pop(mThreadVideoPixels, &pushMicros, &timestampMicros) ) {
+			ScopedGilAcquire acquire( &mStats.gilWait, &mStats.gilHold, &mInterpreter );
+			_trace( Trace::STAGE_GIL_ACQUIRED, timestampMicros );
+			// mp.Image copies the pixels while it is constructed, so mThreadVideoPixels can be swapped back into the queue
+			py::object mp_image = _getMpImageFromPixels(mThreadVideoPixels);
+			_trace( Trace::STAGE_CONVERTED, timestampMicros );
 			
 			py::object results;
-			auto timestamp = (int)ofGetElapsedTimeMillis();
+			std::int64_t timestamp = 0;
+			{
+				std::lock_guard<std::mutex> lck(mMutexMediaPipe);
+				timestamp = _getMediaPipeTimestamp( timestampMicros );
+			}
 			try {
 				if (mp_image && py_landmarker ) {
 					py::function detect_fn = py_landmarker.attr("detect_for_video");
 					if( !detect_fn.is_none() ) {
+						Histogram::ScopedTimer inferenceTimer( mStats.inference );
 						results = detect_fn(mp_image, timestamp);
 					}
 					
 					if( results ) {
+						_trace( Trace::STAGE_INFERENCE_DONE, timestampMicros );
 						//				ofLogNotice("Video thread function");
-						_process_landmark_results(results, timestamp);
+						_process_results(results, timestampMicros);
+						mStats.latency.add( ofGetElapsedTimeMicros() - pushMicros );
 						
 					} else {
 						ofLogNotice("Video thread function") << "no results";
 					}
 				}
 			} catch (const py::error_already_set& e) {
-				// Handle Python exception
-				std::cerr << "Python exception in process_image:\n" << e.what() << std::endl;
-				return;// {}; // Return empty vector on error
+				// skip the frame, returning would leave the queue open without anyone to drain it
+				ofLogError(getTrackerTypeAsString()) << " python exception in detect_for_video: " << e.what();
+				continue;
 			} catch(...) {
 				
 			}
-			
-			ofLogNotice("Thread") << getTrackerTypeAsString() << " time to process results: " << (ofGetElapsedTimeMillis()-timestamp);
-			
-			{
-				std::lock_guard<std::mutex> lock(mVideoPixMutex);
-				mVideoPixIndex = mVideoPixIndex ^ 1;
-				mBNewVideoPixels = false;
-//				mBHasNewData = true;
-//				mFpsCounter.newFrame();
-			}
-			mVideoThreadCondition.notify_one();
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(2));
 	}
 	
 	ofLogNotice("_videoPixThreadedFunction : no longer running");
-	
-	{
-		std::lock_guard<std::mutex> lock(mVideoPixMutex);
-		mBVideoThreadDone = true;
-		mVideoThreadCondition.notify_all();
-	}
 }
 
 #endif
@@ -13,10 +13,20 @@
 #include "ofPixels.h"
 #include "ofParameter.h"
 #include <condition_variable>
+#include <map>
+#include <optional>
 
 #if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
 
 #include "ofxMediaPipeTrackedObject.h"
+#include "ofxMediaPipeFrameQueue.h"
+#include "ofxMediaPipeHistogram.h"
+#include "ofxMediaPipeTrace.h"
+#include "ofxMediaPipeLandmarkPacker.h"
+#include "ofxMediaPipeScopedGilAcquire.h"
+#include "ofxMediaPipeWorkerProcess.h"
+#include "ofxMediaPipeImagePrep.h"
+#include "ofxMediaPipePixelConverter.h"
 #include "ofFpsCounter.h"
 
 #include <pybind11/embed.h>
@@ -37,6 +47,14 @@ public:
 		MODE_OF_VIDEO_THREAD
 	};
 	
+	enum Backend {
+		// media pipe runs in the embedded interpreter of the app
+		BACKEND_EMBEDDED=0,
+		// media pipe runs in a separate python process with its own GIL, see WorkerProcess.
+		// Results are applied like MODE_OF_VIDEO_THREAD. Not available on windows.
+		BACKEND_WORKER_PROCESS
+	};
+	
 	class Settings {
 	public:
 		Settings() {}
@@ -67,6 +85,16 @@ public:
 			minPresenceConfidence = aother.minPresenceConfidence;
 			minTrackingConfidence = aother.minTrackingConfidence;
 			filePath = aother.filePath;
+			queueDepth = aother.queueDepth;
+			queuePolicy = aother.queuePolicy;
+			maxInFlight = aother.maxInFlight;
+			backend = aother.backend;
+			pythonExecutable = aother.pythonExecutable;
+			workerScriptPath = aother.workerScriptPath;
+			interpreterMode = aother.interpreterMode;
+			inferenceWidth = aother.inferenceWidth;
+			inferenceHeight = aother.inferenceHeight;
+			inferenceRoi = aother.inferenceRoi;
 		}
 		
 		Tracker::RunningMode runningMode = Tracker::MODE_VIDEO;
@@ -75,7 +103,59 @@ public:
 		float minPresenceConfidence = 0.5f;
 		float minTrackingConfidence = 0.5f;
 		of::filesystem::path filePath { "" };
+		// number of frames that can wait for the video thread in MODE_OF_VIDEO_THREAD,
+		// rounded up to a power of two.
+		int queueDepth = 2;
+		FrameQueue::Policy queuePolicy = FrameQueue::POLICY_DROP_OLDEST;
+		// number of frames passed to detect_async in MODE_LIVE_STREAM that can wait for results at the same time.
+		// Values above 1 let media pipe overlap the stages of its graph.
+		int maxInFlight = 1;
+		
+		Backend backend = BACKEND_EMBEDDED;
+		// the python used to run the worker, needs mediapipe and numpy installed
+		std::string pythonExecutable = "python3";
+		// when empty, ofxMediaPipeWorker.py is loaded from the data folder or the scripts folder of the addon
+		of::filesystem::path workerScriptPath { "" };
+		
+		// BACKEND_EMBEDDED only, falls back to Interpreter::MODE_SHARED when the mode is not available.
+		// MODE_ISOLATED lets trackers in MODE_VIDEO or MODE_OF_VIDEO_THREAD run in parallel, see Interpreter.
+		Interpreter::Mode interpreterMode = Interpreter::MODE_SHARED;
+		
+		// size of the pixels passed to media pipe, 0 uses the size of the source.
+		// When only one is set, the other keeps the aspect ratio of the region. Pixels are never scaled up.
+		int inferenceWidth = 0;
+		int inferenceHeight = 0;
+		// normalized region of the source that is passed to media pipe, see ImagePrep.
+		// Keypoints are mapped back to the full source, pose segmentation masks cover only the region.
+		ofRectangle inferenceRoi = ofRectangle(0, 0, 1, 1);
+	};
+	
+	// timings in microseconds, recorded by the tracker from the threads that do the work.
+	// Compare the GIL histograms of several trackers to see how much they contend for the interpreter.
+	class Stats {
+	public:
+		// waiting for and holding the GIL in process, the video thread and the result callbacks
+		Histogram gilWait;
+		Histogram gilHold;
+		// converting the pixel format, cropping and scaling the source to the inference size
+		Histogram preprocess;
+		// pixels to mp.Image
+		Histogram conversion;
+		// detect, detect_for_video and submitting detect_async
+		Histogram inference;
+		// python results to landmarks
+		Histogram decode;
+		// matching incoming objects with the tracked objects
+		Histogram matching;
+		// process to results being available
+		Histogram latency;
 		
+		std::atomic<std::uint64_t> numFramesProcessed = 0;
+		// frames dropped by the queue, skipped in live stream mode or results that arrived out of order
+		std::atomic<std::uint64_t> numFramesDropped = 0;
+		
+		void reset();
+		ofJson jsonify();
 	};
 	
 	static std::string sGetStringForRunningMode( RunningMode amode ) {
@@ -103,7 +183,17 @@ public:
 	
 	std::string getTrackerTypeAsString() { return TrackedObject::sGetTypeAsString(getTrackerType()); }
 	
+	// uses ofGetElapsedTimeMicros() as the capture timestamp
 	virtual void process( const ofPixels& apix );
+	// aTimestampMicros is the time the frame was captured, ie. from the camera, and is kept with the results, see getTimestampMicros().
+	// It should increase with every call, except in MODE_IMAGE. Media pipe is passed milliseconds,
+	// frames that fall into the same millisecond are moved to the next one.
+	void process( const ofPixels& apix, std::int64_t aTimestampMicros );
+	// process an mp.Image that was already created from apix, see FrameHub.
+	// The GIL must be held by the calling thread.
+	void processShared( const ofPixels& apix, const py::object& aMpImage, std::int64_t aTimestampMicros );
+	// capture timestamp of the frame that the current objects were detected in
+	std::int64_t getTimestampMicros() { return mTimestampMicros.load(); }
 	
 	bool hasNewData() { return mBHasNewData;}
 	void setOutRect(const ofRectangle& arect) { mOutRect = arect; }
@@ -118,18 +208,62 @@ public:
 	
 	void setDrawPointSize(float af) {mDrawPointSize=af;}
 	
+	// number of pixel bytes copied while handing the previous frame to media pipe,
+	// including the copy that mp.Image makes into its own buffer.
+	std::uint64_t getNumBytesCopiedLastFrame() { return mNumBytesCopiedLastFrame.load(); }
+	// frames waiting for the video thread in MODE_OF_VIDEO_THREAD, has the enqueued, dropped and latency counters.
+	FrameQueue& getFrameQueue() { return mFrameQueue; }
+	Stats& getStats() { return mStats; }
+	// the stats along with the tracker type, running mode and queue counters
+	ofJson jsonifyStats();
+	
+	// MODE_LIVE_STREAM frames waiting for results
+	unsigned int getNumInFlight() { return mThreadCallCount.load(); }
+	// MODE_LIVE_STREAM frames that were not passed to media pipe because mMaxInFlight was reached
+	std::uint64_t getNumLiveFramesSkipped() { return mNumLiveFramesSkipped.load(); }
+	// MODE_LIVE_STREAM results that arrived after a newer result
+	std::uint64_t getNumLiveResultsDropped() { return mNumLiveResultsDropped.load(); }
+	
+	bool isUsingWorker() { return (bool)mWorker; }
+	// the mode actually in use, which can differ from Settings::interpreterMode
+	Interpreter& getInterpreter() { return mInterpreter; }
+	// crops and scales the pixels passed to process, set up from Settings::inferenceWidth, inferenceHeight and inferenceRoi
+	ImagePrep& getImagePrep() { return mImagePrep; }
+	
 protected:
 	void _onExit( ofEventArgs& args );
 	
 	virtual void _update() = 0;
+	bool _prepareToProcess(const ofPixels& apix);
+	// the pixels that are passed to media pipe, converted to RGB when the format is not RGB or RGBA,
+	// then cropped and scaled by mImagePrep. Returns apix when nothing has to be done.
+	const ofPixels& _getInferencePixels(const ofPixels& apix);
 	void _process_image(const ofPixels& apix);
-	virtual void _process_landmark_results( py::object& aresults, int aTimestamp) = 0;
-	
-	void _process_results_callback(py::object& aresults, py::object& aMpImage, int aTimestamp);
-	std::function<void(py::object& aresults, py::object& aMpImage, int aTimestamp)> process_results_lambda = nullptr;
+	void _process_image(const ofPixels& apix, const py::object& aMpImage, std::int64_t aTimestampMicros);
+	// the millisecond timestamp passed to media pipe for aTimestampMicros, larger than the previous one
+	std::int64_t _getMediaPipeTimestamp( std::int64_t aTimestampMicros );
+	void _process_results( py::object& aresults, std::int64_t aTimestampMicros );
+	virtual void _process_landmark_results( py::object& aresults, std::int64_t aTimestampMicros) = 0;
+	// builds the tracked objects from mPackedLandmarks, mPackedWorldLandmarks and mPackedCategories,
+	// called after the python results are packed or when the results of a worker arrive
+	virtual void _process_packed_results( std::int64_t aTimestampMicros ) = 0;
+	// maps the packed landmarks from the inference pixels back to the source and calls _process_packed_results
+	void _apply_packed_results( std::int64_t aTimestampMicros );
+	
+	// aTimestamp is the millisecond timestamp that was passed to detect_async
+	void _process_results_callback(py::object& aresults, py::object& aMpImage, std::int64_t aTimestamp);
+	std::function<void(py::object& aresults, py::object& aMpImage, std::int64_t aTimestamp)> process_results_lambda = nullptr;
 	
 	py::object _getMpImageFromPixels( const ofPixels& apix );
-	
+	py::object _createMpImage( const ofPixels& apix, py::handle aBase );
+	
+	void _applyBaseSettings( const Settings& asettings );
+	// picks the interpreter for the requested mode, called before the landmarker is created
+	void _setupInterpreter( const Settings& asettings );
+	// starts a worker process instead of creating the landmarker in the embedded interpreter,
+	// the type, model path, number and confidences are added to aConfig
+	bool _setupWorker( const Settings& asettings, ofJson aConfig );
+	void _process_worker_results( WorkerProcess::Results& aresults );
 	void _startVideoPixThread();
 	void _stopVideoPixThread();
 	void _videoPixThreadedFunction();
@@ -140,7 +274,19 @@ protected:
 	void _addAppListeners();
 	void _removeAppListeners();
 	
+	friend class FrameHub;
+	
 	void _calculateDeltatime(); 
+	// frames that an object can go missing before it is removed, from mMaxTimeToMatch and the rate of the capture timestamps,
+	// so that the matching does not depend on how fast the frames are processed, ie. by the BatchProcessor
+	int _getNumFramesToDie( std::int64_t aTimestampMicros );
+	
+	// marks a stage of the frame with the capture timestamp aTimestampMicros, see Trace
+	void _trace( Trace::Stage astage, std::int64_t aTimestampMicros ) {
+		if( Trace::sIsEnabled() ) {
+			Trace::sMark( astage, getTrackerType(), aTimestampMicros );
+		}
+	}
 	
 	ofParameterGroup params;
 	ofParameter<bool> mBDrawPoints, mBDrawOutlines, mBDrawUsePosZ;
@@ -148,6 +294,8 @@ protected:
 	ofParameter<float> mMaxTimeToMatch;
 	
 	ofRectangle mSrcRect, mOutRect;
+	PixelConverter mPixelConverter;
+	ImagePrep mImagePrep;
 	
 	std::string mGuiPrefix = "";
 	
@@ -155,19 +303,24 @@ protected:
 	
 	uint64_t mCounterId = 0;
 	
+	// declared before the python objects, so that they are destroyed before a sub interpreter is ended
+	Interpreter mInterpreter;
 	py::module py_mediapipe;
 	py::object py_landmarker;
 	
 	float mDrawPointSize = 2.f;
 
-	//py::object py_ImageFormat;// = py_mediapipe.attr("ImageFormat");
-	//py::object py_Image;// = py_mediapipe.attr("Image");
+	py::object py_ImageFormat;
+	py::object py_Image;
 
 	bool mBSetup = false;
 	bool mBHasNewData = false;
 	
 	float mLastTimeUpdateF = -1;
 	float mDeltaTimeSmoothed = 0;
+	// of the capture timestamps that were matched
+	std::int64_t mLastMatchTimestampMicros = -1;
+	float mMatchFrameRate = 30.f;
 	
 	std::mutex mMutex;
 	std::atomic<bool> mHasNewThreadValues = false;
@@ -179,6 +332,23 @@ protected:
 	
 	std::atomic<unsigned int> mThreadCallCount = 0;
 	
+	int mMaxInFlight = 1;
+	struct InFlight {
+		// ofGetElapsedTimeMicros() when detect_async was called
+		std::uint64_t submitMicros = 0;
+		std::int64_t timestampMicros = 0;
+	};
+	// MODE_LIVE_STREAM millisecond timestamps passed to detect_async, guarded by mMutexMediaPipe
+	std::map<std::int64_t, InFlight> mInFlightTimestamps;
+	// last millisecond timestamp passed to media pipe, guarded by mMutexMediaPipe
+	std::int64_t mLastSubmittedTimestamp = -1;
+	std::int64_t mLastResultTimestamp = -1;
+	std::atomic<std::int64_t> mTimestampMicros = 0;
+	// capture timestamp of the objects waiting for _update in MODE_LIVE_STREAM and MODE_OF_VIDEO_THREAD, guarded by mMutex
+	std::int64_t mThreadedTimestampMicros = 0;
+	std::atomic<std::uint64_t> mNumLiveFramesSkipped = 0;
+	std::atomic<std::uint64_t> mNumLiveResultsDropped = 0;
+	
 	ofFpsCounter mFpsCounter;
 
 //	static bool sBPyInterpreterInited;// = false;
@@ -186,11 +356,23 @@ protected:
 	std::atomic<bool> mVideoThreadRunning;
 	std::mutex mVideoPixMutex;
 	std::thread mVideoThread;
-	std::array<ofPixels, 2> mThreadVideoPixels;
-	std::atomic<int> mVideoPixIndex;
-	std::atomic<bool> mBNewVideoPixels;
-	std::atomic<bool> mBVideoThreadDone;
-	std::condition_variable mVideoThreadCondition;
+	FrameQueue mFrameQueue;
+	// only accessed by the video thread, swapped with the queue slots
+	ofPixels mThreadVideoPixels;
+	
+	std::atomic<std::uint64_t> mNumBytesCopied = 0;
+	std::atomic<std::uint64_t> mNumBytesCopiedLastFrame = 0;
+	
+	Stats mStats;
+	
+	// only used while the GIL is held, the buffers are kept to avoid allocating every frame
+	LandmarkPacker mLandmarkPacker;
+	LandmarkPacker::Landmarks mPackedLandmarks;
+	LandmarkPacker::Landmarks mPackedWorldLandmarks;
+	LandmarkPacker::Categories mPackedCategories;
+	
+	// only valid with BACKEND_WORKER_PROCESS
+	std::unique_ptr<WorkerProcess> mWorker;
 	
 	static int sNumPyInstances;
 	
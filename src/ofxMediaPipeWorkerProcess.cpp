@@ -0,0 +1,487 @@
+//
+//  ofxMediaPipeWorkerProcess.cpp
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#include "ofxMediaPipeWorkerProcess.h"
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofLog.h"
+#include "ofUtils.h"
+#include <cstring>
+
+#if !defined(TARGET_WIN32)
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char **environ;
+#if !defined(MSG_NOSIGNAL)
+// macOS, the socket is set up with SO_NOSIGPIPE instead
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+using namespace ofx::MediaPipe;
+
+//--------------------------------------------------------------
+WorkerProcess::WorkerProcess() {
+
+}
+
+//--------------------------------------------------------------
+WorkerProcess::~WorkerProcess() {
+	stop();
+}
+
+#if defined(TARGET_WIN32)
+//--------------------------------------------------------------
+bool WorkerProcess::start( const Settings& asettings, std::function<void(Results&)> aResultsCallback ) {
+	ofLogError("ofxMediaPipe::WorkerProcess") << "worker processes are not supported on windows.";
+	return false;
+}
+
+//--------------------------------------------------------------
+void WorkerProcess::stop() {}
+bool WorkerProcess::push( const ofPixels& apix, std::int64_t aTimestampMicros ) { return false; }
+bool WorkerProcess::_createSharedMemory( size_t aSlotBytes ) { return false; }
+void WorkerProcess::_releaseSharedMemory() {}
+bool WorkerProcess::_send( const std::string& amessage ) { return false; }
+bool WorkerProcess::_readLine( std::string& aOutLine ) { return false; }
+bool WorkerProcess::_readBytes( std::uint8_t* aOut, size_t aNumBytes ) { return false; }
+void WorkerProcess::_readerThreadedFunction() {}
+#else
+//--------------------------------------------------------------
+bool WorkerProcess::start( const Settings& asettings, std::function<void(Results&)> aResultsCallback ) {
+	stop();
+
+	mSettings = asettings;
+	mResultsCallback = aResultsCallback;
+
+	if( !ofFile::doesFileExist(mSettings.scriptPath) ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "worker script not found at " << mSettings.scriptPath;
+		return false;
+	}
+
+	int fds[2];
+	if( socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0 ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "unable to create socket pair: " << strerror(errno);
+		return false;
+	}
+	// our end should not be inherited by the worker
+	fcntl( fds[0], F_SETFD, FD_CLOEXEC );
+#if defined(SO_NOSIGPIPE)
+	int noSigPipe = 1;
+	setsockopt( fds[0], SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe) );
+#endif
+
+	std::string fdStr = ofToString(fds[1]);
+	std::string configStr = mSettings.config.dump();
+	std::string scriptStr = mSettings.scriptPath.string();
+	std::vector<char*> args;
+	args.push_back( const_cast<char*>(mSettings.pythonExecutable.c_str()) );
+	args.push_back( const_cast<char*>(scriptStr.c_str()) );
+	args.push_back( const_cast<char*>(fdStr.c_str()) );
+	args.push_back( const_cast<char*>(configStr.c_str()) );
+	args.push_back( nullptr );
+
+	pid_t pid = -1;
+	int rc = posix_spawnp( &pid, mSettings.pythonExecutable.c_str(), nullptr, nullptr, args.data(), environ );
+	close( fds[1] );
+	if( rc != 0 ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "unable to start " << mSettings.pythonExecutable << ": " << strerror(rc);
+		close( fds[0] );
+		return false;
+	}
+
+	mPid = (int)pid;
+	mSocket = fds[0];
+
+	{
+		std::lock_guard<std::mutex> lck(mMutex);
+		mSlots.assign( std::max(1, mSettings.numSlots), Slot() );
+	}
+
+	mReadBuffer.clear();
+	mBRunning = true;
+	mReaderThread = std::thread(&WorkerProcess::_readerThreadedFunction, this );
+	ofLogNotice("ofxMediaPipe::WorkerProcess") << "started worker " << mPid << " with " << mSlots.size() << " slots.";
+	return true;
+}
+
+//--------------------------------------------------------------
+void WorkerProcess::stop() {
+	mBRunning = false;
+	if( mSocket > -1 ) {
+		_send("Q\n");
+		// wakes up the reader thread
+		shutdown( mSocket, SHUT_RDWR );
+	}
+	if( mReaderThread.joinable() ) {
+		mReaderThread.join();
+	}
+	if( mSocket > -1 ) {
+		close( mSocket );
+		mSocket = -1;
+	}
+	if( mPid > 0 ) {
+		int status = 0;
+		// give the worker a moment to close the landmarker before it is killed
+		bool bExited = false;
+		for( int i = 0; i < 100; i++ ) {
+			if( waitpid( mPid, &status, WNOHANG ) != 0 ) {
+				bExited = true;
+				break;
+			}
+			ofSleepMillis(10);
+		}
+		if( !bExited ) {
+			ofLogWarning("ofxMediaPipe::WorkerProcess") << "killing worker " << mPid;
+			kill( mPid, SIGKILL );
+			waitpid( mPid, &status, 0 );
+		}
+		mPid = -1;
+	}
+
+	std::lock_guard<std::mutex> lck(mMutex);
+	_releaseSharedMemory();
+	mSlots.clear();
+}
+
+//--------------------------------------------------------------
+bool WorkerProcess::push( const ofPixels& apix, std::int64_t aTimestampMicros ) {
+	if( !isRunning() ) {
+		return false;
+	}
+
+	size_t numBytes = apix.getTotalBytes();
+	int slotIndex = -1;
+	std::string message;
+	{
+		std::lock_guard<std::mutex> lck(mMutex);
+		bool bAnyBusy = false;
+		for( size_t i = 0; i < mSlots.size(); i++ ) {
+			if( mSlots[i].bBusy ) {
+				bAnyBusy = true;
+			} else if( slotIndex < 0 ) {
+				slotIndex = (int)i;
+			}
+		}
+		if( slotIndex < 0 ) {
+			return false;
+		}
+
+		if( numBytes > mSlotBytes ) {
+			// the worker still has a view on the current segment
+			if( bAnyBusy ) {
+				return false;
+			}
+			if( !_createSharedMemory(numBytes) ) {
+				return false;
+			}
+			if( !_send("M " + mShmName.substr(1) + " " + ofToString(mSlotBytes) + " " + ofToString(mSlots.size()) + "\n") ) {
+				return false;
+			}
+		}
+
+		std::memcpy( mShmData + (size_t)slotIndex * mSlotBytes, apix.getData(), numBytes );
+		auto& slot = mSlots[slotIndex];
+		slot.bBusy = true;
+		slot.timestampMicros = aTimestampMicros;
+		slot.pushMicros = ofGetElapsedTimeMicros();
+
+		message = "F " + ofToString(slotIndex) + " " + ofToString(aTimestampMicros / 1000) + " " + ofToString(apix.getWidth()) + " " + ofToString(apix.getHeight()) + " " + ofToString(apix.getNumChannels()) + "\n";
+	}
+
+	if( !_send(message) ) {
+		std::lock_guard<std::mutex> lck(mMutex);
+		if( slotIndex < (int)mSlots.size() ) {
+			mSlots[slotIndex].bBusy = false;
+		}
+		return false;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool WorkerProcess::_createSharedMemory( size_t aSlotBytes ) {
+	_releaseSharedMemory();
+
+	// kept short, macOS limits shared memory names to 31 characters
+	static std::atomic<int> sShmCounter = 0;
+	mShmName = "/ofxmp_" + ofToString(getpid()) + "_" + ofToString(sShmCounter++);
+	mShmBytes = aSlotBytes * mSlots.size();
+	mShmFd = shm_open( mShmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+	if( mShmFd < 0 ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "unable to create shared memory " << mShmName << ": " << strerror(errno);
+		return false;
+	}
+	if( ftruncate( mShmFd, (off_t)mShmBytes ) != 0 ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "unable to size shared memory: " << strerror(errno);
+		_releaseSharedMemory();
+		return false;
+	}
+	void* data = mmap( nullptr, mShmBytes, PROT_READ | PROT_WRITE, MAP_SHARED, mShmFd, 0 );
+	if( data == MAP_FAILED ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "unable to map shared memory: " << strerror(errno);
+		_releaseSharedMemory();
+		return false;
+	}
+	mShmData = (std::uint8_t*)data;
+	mSlotBytes = aSlotBytes;
+	return true;
+}
+
+//--------------------------------------------------------------
+void WorkerProcess::_releaseSharedMemory() {
+	if( mShmData ) {
+		munmap( mShmData, mShmBytes );
+		mShmData = nullptr;
+	}
+	if( mShmFd > -1 ) {
+		close( mShmFd );
+		// the worker keeps its mapping until it attaches to the next segment
+		shm_unlink( mShmName.c_str() );
+		mShmFd = -1;
+	}
+	mShmBytes = 0;
+	mSlotBytes = 0;
+}
+
+//--------------------------------------------------------------
+bool WorkerProcess::_send( const std::string& amessage ) {
+	size_t numSent = 0;
+	while( numSent < amessage.size() ) {
+		// MSG_NOSIGNAL, a worker that exited should not raise SIGPIPE in the app
+		auto rc = ::send( mSocket, amessage.data() + numSent, amessage.size() - numSent, MSG_NOSIGNAL );
+		if( rc < 0 ) {
+			if( errno == EINTR ) {
+				continue;
+			}
+			return false;
+		}
+		numSent += (size_t)rc;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+bool WorkerProcess::_readLine( std::string& aOutLine ) {
+	while( true ) {
+		auto pos = mReadBuffer.find('\n');
+		if( pos != std::string::npos ) {
+			aOutLine = mReadBuffer.substr(0, pos);
+			mReadBuffer.erase(0, pos+1);
+			return true;
+		}
+		char buf[4096];
+		auto rc = recv( mSocket, buf, sizeof(buf), 0 );
+		if( rc < 0 && errno == EINTR ) {
+			continue;
+		}
+		if( rc <= 0 ) {
+			return false;
+		}
+		mReadBuffer.append( buf, (size_t)rc );
+	}
+}
+
+//--------------------------------------------------------------
+bool WorkerProcess::_readBytes( std::uint8_t* aOut, size_t aNumBytes ) {
+	size_t numRead = std::min( aNumBytes, mReadBuffer.size() );
+	if( numRead > 0 ) {
+		std::memcpy( aOut, mReadBuffer.data(), numRead );
+		mReadBuffer.erase( 0, numRead );
+	}
+	while( numRead < aNumBytes ) {
+		auto rc = recv( mSocket, aOut + numRead, aNumBytes - numRead, 0 );
+		if( rc < 0 && errno == EINTR ) {
+			continue;
+		}
+		if( rc <= 0 ) {
+			return false;
+		}
+		numRead += (size_t)rc;
+	}
+	return true;
+}
+
+//--------------------------------------------------------------
+void WorkerProcess::_readerThreadedFunction() {
+	std::string line;
+	while( mBRunning.load() ) {
+		if( !_readLine(line) ) {
+			break;
+		}
+		// R slot timestamp numBytes, followed by numBytes of packed results
+		auto parts = ofSplitString( line, " ", true, true );
+		if( parts.size() < 1 ) {
+			continue;
+		}
+		if( parts[0] == "E" ) {
+			ofLogError("ofxMediaPipe::WorkerProcess") << "worker " << mPid << ": " << line.substr(1);
+			continue;
+		}
+		if( parts[0] != "R" || parts.size() < 4 ) {
+			ofLogWarning("ofxMediaPipe::WorkerProcess") << "unknown message from worker: " << line;
+			continue;
+		}
+		int slotIndex = ofToInt(parts[1]);
+		// the millisecond timestamp that the worker passed to media pipe
+		const std::string& timestamp = parts[2];
+		size_t numBytes = (size_t)std::max( 0, ofToInt(parts[3]) );
+		mPayload.resize( numBytes );
+		if( numBytes > 0 && !_readBytes(mPayload.data(), numBytes) ) {
+			break;
+		}
+
+		std::uint64_t pushMicros = 0;
+		std::int64_t timestampMicros = 0;
+		{
+			std::lock_guard<std::mutex> lck(mMutex);
+			if( slotIndex >= 0 && slotIndex < (int)mSlots.size() ) {
+				pushMicros = mSlots[slotIndex].pushMicros;
+				timestampMicros = mSlots[slotIndex].timestampMicros;
+				mSlots[slotIndex].bBusy = false;
+			}
+		}
+
+		// an empty payload means the worker was not able to process the frame
+		if( numBytes < 1 ) {
+			continue;
+		}
+
+		if( !sUnpackResults(mPayload, mResults) ) {
+			ofLogWarning("ofxMediaPipe::WorkerProcess") << "unable to unpack the results for " << timestamp;
+			continue;
+		}
+		mResults.timestampMicros = timestampMicros;
+		mResults.pushMicros = pushMicros;
+		if( mResultsCallback ) {
+			mResultsCallback( mResults );
+		}
+	}
+
+	if( mBRunning.load() ) {
+		ofLogError("ofxMediaPipe::WorkerProcess") << "lost the connection to worker " << mPid;
+	}
+	mBRunning = false;
+}
+#endif
+
+//--------------------------------------------------------------
+int WorkerProcess::getNumInFlight() {
+	std::lock_guard<std::mutex> lck(mMutex);
+	int num = 0;
+	for( auto& slot : mSlots ) {
+		if( slot.bBusy ) {
+			num++;
+		}
+	}
+	return num;
+}
+
+//--------------------------------------------------------------
+namespace {
+class PayloadReader {
+public:
+	PayloadReader( const std::vector<std::uint8_t>& aPayload ) : mPayload(aPayload) {}
+
+	template<typename T>
+	bool read( T* aOut, size_t aNum ) {
+		size_t numBytes = aNum * sizeof(T);
+		if( mPos + numBytes > mPayload.size() ) {
+			return false;
+		}
+		if( numBytes > 0 ) {
+			std::memcpy( aOut, mPayload.data() + mPos, numBytes );
+		}
+		mPos += numBytes;
+		return true;
+	}
+
+	// checked before resizing, so that a cut off or corrupt payload can not ask for more memory than it holds
+	bool hasBytes( size_t aNum, size_t aBytesPerValue ) {
+		return aNum <= (mPayload.size() - mPos) / aBytesPerValue;
+	}
+
+	bool readCounts( std::vector<int>& aOut, size_t& aOutTotal ) {
+		std::uint32_t num = 0;
+		if( !read(&num, 1) || !hasBytes(num, sizeof(int)) ) {
+			return false;
+		}
+		aOut.resize(num);
+		if( !read(aOut.data(), num) ) {
+			return false;
+		}
+		aOutTotal = 0;
+		for( auto& count : aOut ) {
+			if( count < 0 ) {
+				return false;
+			}
+			aOutTotal += (size_t)count;
+		}
+		return true;
+	}
+
+	bool readLandmarks( LandmarkPacker::Landmarks& aOut ) {
+		size_t total = 0;
+		if( !readCounts(aOut.counts, total) || !hasBytes(total, 3 * sizeof(float)) ) {
+			return false;
+		}
+		aOut.xyz.resize( total * 3 );
+		return read( aOut.xyz.data(), aOut.xyz.size() );
+	}
+
+	const std::vector<std::uint8_t>& mPayload;
+	size_t mPos = 0;
+};
+}
+
+//--------------------------------------------------------------
+bool WorkerProcess::sUnpackResults( const std::vector<std::uint8_t>& aPayload, Results& aOut ) {
+	// u32 numLists, i32 counts[numLists], f32 xyz[sum(counts)*3] for the landmarks and the world landmarks,
+	// u32 numLists, i32 counts[numLists], i32 indices[sum(counts)], f32 scores[sum(counts)],
+	// u32 numNameBytes, names separated by '\n' for the categories. All values are little endian.
+	PayloadReader reader( aPayload );
+	if( !reader.readLandmarks(aOut.landmarks) || !reader.readLandmarks(aOut.worldLandmarks) ) {
+		return false;
+	}
+
+	auto& cats = aOut.categories;
+	size_t numCategories = 0;
+	if( !reader.readCounts(cats.counts, numCategories) || !reader.hasBytes(numCategories, sizeof(int) + sizeof(float)) ) {
+		return false;
+	}
+	cats.indices.resize( numCategories );
+	cats.scores.resize( numCategories );
+	if( !reader.read(cats.indices.data(), numCategories) || !reader.read(cats.scores.data(), numCategories) ) {
+		return false;
+	}
+
+	std::uint32_t numNameBytes = 0;
+	if( !reader.read(&numNameBytes, 1) || !reader.hasBytes(numNameBytes, 1) ) {
+		return false;
+	}
+	cats.names.clear();
+	if( numNameBytes > 0 ) {
+		std::string names( numNameBytes, '\0' );
+		if( !reader.read(names.data(), numNameBytes) ) {
+			return false;
+		}
+		cats.names = ofSplitString( names, "\n" );
+		// a name for every category, or none when they were sent before
+		if( cats.names.size() != numCategories ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+#endif
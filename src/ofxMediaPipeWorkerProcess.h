@@ -0,0 +1,109 @@
+//
+//  ofxMediaPipeWorkerProcess.h
+//  ofxMediaPipePython
+//
+//  Created by design-io on 10/17/26.
+//
+
+#pragma once
+
+#if !defined(OFX_MEDIAPIPE_EXCLUDE_TRACKERS)
+#include "ofPixels.h"
+#include "ofJson.h"
+#include "ofxMediaPipeLandmarkPacker.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ofx::MediaPipe {
+// Runs a media pipe landmarker in a separate python process, see scripts/ofxMediaPipeWorker.py.
+// Every worker has its own interpreter and GIL, so trackers running in workers do not wait on each other
+// or on the app's embedded interpreter.
+// Frames are copied into slots of a shared memory segment and the slot is announced over a socket,
+// the packed landmarks are sent back over the same socket.
+// Only supported on posix platforms, start returns false on windows.
+class WorkerProcess {
+public:
+	class Settings {
+	public:
+		std::string pythonExecutable = "python3";
+		of::filesystem::path scriptPath;
+		// passed to the worker as its only argument, see the script for the keys
+		ofJson config;
+		// frames that can be waiting on the worker at the same time, each slot holds one frame
+		int numSlots = 2;
+	};
+
+	// results are parsed into these buffers on the reader thread before the callback is called
+	class Results {
+	public:
+		// the capture timestamp that was pushed with the frame
+		std::int64_t timestampMicros = 0;
+		// ofGetElapsedTimeMicros() when the frame was pushed
+		std::uint64_t pushMicros = 0;
+		LandmarkPacker::Landmarks landmarks;
+		LandmarkPacker::Landmarks worldLandmarks;
+		LandmarkPacker::Categories categories;
+	};
+
+	WorkerProcess();
+	~WorkerProcess();
+
+	WorkerProcess( const WorkerProcess& ) = delete;
+	WorkerProcess& operator=( const WorkerProcess& ) = delete;
+
+	// spawns the worker, the callback is called from the reader thread for every frame that was processed
+	bool start( const Settings& asettings, std::function<void(Results&)> aResultsCallback );
+	void stop();
+	bool isRunning() { return mBRunning.load(); }
+
+	// copies apix into a free slot and notifies the worker, returns false if all of the slots are busy.
+	// The worker is passed the timestamp in milliseconds, the results keep aTimestampMicros.
+	bool push( const ofPixels& apix, std::int64_t aTimestampMicros );
+
+	int getNumSlots() { return (int)mSlots.size(); }
+	int getNumInFlight();
+
+	// parses a payload written by the worker script
+	static bool sUnpackResults( const std::vector<std::uint8_t>& aPayload, Results& aOut );
+
+protected:
+	struct Slot {
+		bool bBusy = false;
+		std::int64_t timestampMicros = 0;
+		std::uint64_t pushMicros = 0;
+	};
+
+	bool _createSharedMemory( size_t aSlotBytes );
+	void _releaseSharedMemory();
+	bool _send( const std::string& amessage );
+	bool _readLine( std::string& aOutLine );
+	bool _readBytes( std::uint8_t* aOut, size_t aNumBytes );
+	void _readerThreadedFunction();
+
+	Settings mSettings;
+	std::function<void(Results&)> mResultsCallback;
+
+	std::atomic<bool> mBRunning = false;
+	int mPid = -1;
+	// our end of the socket pair, the worker has the other end
+	int mSocket = -1;
+	std::thread mReaderThread;
+
+	// guards the slots and the shared memory
+	std::mutex mMutex;
+	std::vector<Slot> mSlots;
+	std::string mShmName;
+	int mShmFd = -1;
+	std::uint8_t* mShmData = nullptr;
+	size_t mShmBytes = 0;
+	size_t mSlotBytes = 0;
+
+	// only used by the reader thread
+	std::string mReadBuffer;
+	std::vector<std::uint8_t> mPayload;
+	Results mResults;
+};
+}
+#endif